@@ -61,6 +61,8 @@ static void qQmlProfilerDataToByteArrays(const QQmlProfilerData &d,
             ds << d.time << decodedMessageType << static_cast<quint32>(d.detailType);
             if (d.locationId != 0)
                 ds << static_cast<qint64>(d.locationId);
+            else if (d.numDependencies >= 0)
+                ds << d.numDependencies << d.redundant;
         } else {
             auto i = locations.constFind(d.locationId);
             if (i != locations.cend()) {
@@ -51,7 +51,7 @@ QT_BEGIN_NAMESPACE
 // Also change the comment behind the number to describe the latest change. This has the added
 // benefit that if another patch changes the version too, it will result in a merge conflict, and
 // not get removed silently.
-#define QV4_DATA_STRUCTURE_VERSION 0x42 // Change metatype computation of AOT-compiled functions
+#define QV4_DATA_STRUCTURE_VERSION 0x43 // Add HasStaticDependencies function flag
 
 class QIODevice;
 class QQmlTypeNameCache;
@@ -366,6 +366,7 @@ struct Function
         IsArrowFunction     = 0x2,
         IsGenerator         = 0x4,
         IsClosureWrapper    = 0x8,
+        HasStaticDependencies = 0x10,
     };
 
     // Absolute offset into file where the code for this function is located.
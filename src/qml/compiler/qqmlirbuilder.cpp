@@ -2080,6 +2080,244 @@ QVector<int> JSCodeGen::generateJSCodeForFunctionsAndBindings(
     return runtimeFunctionIndices;
 }
 
+// Whether the object bound by \a binding on \a object may be the root of an implicitly created
+// component, e.g. a delegate. Without type information we only know this for sure if the
+// property is declared in the same object with a type other than Component.
+static bool mayBeImplicitComponent(const Document *document, const Object *object,
+                                   const Binding *binding)
+{
+    if (binding->type() != QV4::CompiledData::Binding::Type_Object)
+        return false;
+
+    for (auto it = object->propertiesBegin(), end = object->propertiesEnd(); it != end; ++it) {
+        if (it->nameIndex != binding->propertyNameIndex)
+            continue;
+        if (it->commonType() != QV4::CompiledData::CommonType::Invalid)
+            return false;
+        const QString typeName = document->stringAt(it->typeNameIndex());
+        return typeName == QLatin1String("Component")
+                || typeName.endsWith(QLatin1String(".Component"));
+    }
+
+    return true;
+}
+
+void JSCodeGen::setImplicitComponentsResolved(bool resolved)
+{
+    Q_ASSERT(m_componentRoots.isEmpty());
+    m_implicitComponentsResolved = resolved;
+}
+
+const QHash<QString, const Object *> &JSCodeGen::visibleIds(const Object *object)
+{
+    if (m_componentRoots.isEmpty() && !document->objects.isEmpty()) {
+        // Explicit and implicit components see the ids of their enclosing components. Inline
+        // components don't. The ids declared inside a component are not visible outside of it.
+        // If the implicit components have not been wrapped into Component objects, yet, we
+        // conservatively assume every object bound to a property of unknown type to start one.
+        QSet<QString> declaredProperties;
+        for (const Object *o : std::as_const(document->objects)) {
+            for (auto it = o->propertiesBegin(), end = o->propertiesEnd(); it != end; ++it)
+                declaredProperties.insert(document->stringAt(it->nameIndex));
+            for (auto it = o->aliasesBegin(), end = o->aliasesEnd(); it != end; ++it)
+                declaredProperties.insert(document->stringAt(it->nameIndex()));
+        }
+
+        const auto isComponentRoot = [&](const Object *parent, const Binding *b,
+                                         const Object *o) {
+            return o->hasFlag(QV4::CompiledData::Object::IsInlineComponentRoot)
+                    || o->hasFlag(QV4::CompiledData::Object::IsComponent)
+                    || document->stringAt(o->inheritedTypeNameIndex) == QLatin1String("Component")
+                    || (!m_implicitComponentsResolved
+                        && mayBeImplicitComponent(document, parent, b));
+        };
+
+        QHash<const Object *, const Object *> parentComponents;
+        QList<std::pair<const Object *, const Object *>> pending;
+        for (const Object *o : std::as_const(document->objects)) {
+            if (o == document->objects.first()
+                    || o->hasFlag(QV4::CompiledData::Object::IsInlineComponentRoot)) {
+                pending.append({ o, o });
+            }
+        }
+
+        while (!pending.isEmpty()) {
+            const auto [o, root] = pending.takeLast();
+            m_componentRoots.insert(o, root);
+            if (o->idNameIndex != 0) {
+                const QString id = document->stringAt(o->idNameIndex);
+                if (!declaredProperties.contains(id))
+                    m_visibleIdsByComponent[root].insert(id, o);
+            }
+
+            for (const Binding *b = o->firstBinding(); b; b = b->next) {
+                switch (b->type()) {
+                case QV4::CompiledData::Binding::Type_Object:
+                case QV4::CompiledData::Binding::Type_AttachedProperty:
+                case QV4::CompiledData::Binding::Type_GroupProperty:
+                    break;
+                default:
+                    continue;
+                }
+
+                const Object *child = document->objects.at(b->value.objectIndex);
+                if (isComponentRoot(o, b, child)) {
+                    parentComponents.insert(child, root);
+                    pending.append({ child, child });
+                } else {
+                    pending.append({ child, root });
+                }
+            }
+        }
+
+        for (auto it = parentComponents.constBegin(), end = parentComponents.constEnd();
+             it != end; ++it) {
+            if (it.key()->hasFlag(QV4::CompiledData::Object::IsInlineComponentRoot))
+                continue;
+            QHash<QString, const Object *> &ids = m_visibleIdsByComponent[it.key()];
+            for (const Object *outer = it.value(); outer; outer = parentComponents.value(outer)) {
+                // Inner ids shadow outer ones.
+                const auto outerIds = m_visibleIdsByComponent.value(outer);
+                for (auto id = outerIds.constBegin(); id != outerIds.constEnd(); ++id) {
+                    if (!ids.contains(id.key()))
+                        ids.insert(id.key(), id.value());
+                }
+            }
+        }
+    }
+
+    return m_visibleIdsByComponent[m_componentRoots.value(object)];
+}
+
+namespace {
+struct StaticDependencyScope
+{
+    const Document *document;
+    const Object *scopeObject;
+    const QHash<QString, const Object *> &ids;
+};
+}
+
+// Whether \a object declares a property \a name with a type that holds primitive JavaScript
+// values. Converting those to primitives cannot run any code.
+static bool hasPrimitiveProperty(const Document *document, const Object *object, QStringView name)
+{
+    for (auto it = object->propertiesBegin(), end = object->propertiesEnd(); it != end; ++it) {
+        if (document->stringAt(it->nameIndex) != name)
+            continue;
+        if (it->isList())
+            return false;
+        switch (it->commonType()) {
+        case QV4::CompiledData::CommonType::Int:
+        case QV4::CompiledData::CommonType::Bool:
+        case QV4::CompiledData::CommonType::Real:
+        case QV4::CompiledData::CommonType::String:
+            return true;
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+// Whether the given binding expression reads the same set of properties on every evaluation.
+// This is the case if it only reads names from the QML scope and properties of ids, and does
+// not contain any control flow, calls, or assignments that could change the set.
+// Operators that convert their operands to primitives may call valueOf() or toString() on objects,
+// which can read arbitrary other properties. Such operands have to be known to be primitive:
+// literals, results of other operators, or properties declared with a primitive type.
+static bool hasStaticDependencies(
+        QQmlJS::AST::Node *node, const StaticDependencyScope &scope, bool converted = false)
+{
+    using namespace QQmlJS::AST;
+
+    if (!node)
+        return false;
+
+    switch (node->kind) {
+    case Node::Kind_ExpressionStatement:
+        return hasStaticDependencies(
+                static_cast<ExpressionStatement *>(node)->expression, scope, converted);
+    case Node::Kind_NestedExpression:
+        return hasStaticDependencies(
+                static_cast<NestedExpression *>(node)->expression, scope, converted);
+    case Node::Kind_IdentifierExpression: {
+        if (!converted)
+            return true;
+        const QStringView name = static_cast<IdentifierExpression *>(node)->name;
+        return !scope.ids.contains(name.toString())
+                && hasPrimitiveProperty(scope.document, scope.scopeObject, name);
+    }
+    case Node::Kind_NumericLiteral:
+    case Node::Kind_StringLiteral:
+    case Node::Kind_TrueLiteral:
+    case Node::Kind_FalseLiteral:
+    case Node::Kind_NullExpression:
+        return true;
+    case Node::Kind_FieldMemberExpression: {
+        auto *member = static_cast<FieldMemberExpression *>(node);
+        const auto *base = cast<IdentifierExpression *>(member->base);
+        if (!base)
+            return false;
+        const Object *object = scope.ids.value(base->name.toString());
+        return object
+                && (!converted || hasPrimitiveProperty(scope.document, object, member->name));
+    }
+    case Node::Kind_NotExpression:
+        // Conversion to boolean doesn't call any methods.
+        return hasStaticDependencies(static_cast<NotExpression *>(node)->expression, scope);
+    case Node::Kind_TildeExpression:
+        return hasStaticDependencies(
+                static_cast<TildeExpression *>(node)->expression, scope, true);
+    case Node::Kind_UnaryMinusExpression:
+        return hasStaticDependencies(
+                static_cast<UnaryMinusExpression *>(node)->expression, scope, true);
+    case Node::Kind_UnaryPlusExpression:
+        return hasStaticDependencies(
+                static_cast<UnaryPlusExpression *>(node)->expression, scope, true);
+    case Node::Kind_TemplateLiteral:
+        for (auto *t = static_cast<TemplateLiteral *>(node); t; t = t->next) {
+            if (t->expression && !hasStaticDependencies(t->expression, scope, true))
+                return false;
+        }
+        return true;
+    case Node::Kind_BinaryExpression: {
+        auto *binary = static_cast<BinaryExpression *>(node);
+        switch (binary->op) {
+        case QSOperator::StrictEqual:
+        case QSOperator::StrictNotEqual:
+            return hasStaticDependencies(binary->left, scope)
+                    && hasStaticDependencies(binary->right, scope);
+        case QSOperator::Add:
+        case QSOperator::Sub:
+        case QSOperator::Mul:
+        case QSOperator::Div:
+        case QSOperator::Mod:
+        case QSOperator::Exp:
+        case QSOperator::BitAnd:
+        case QSOperator::BitOr:
+        case QSOperator::BitXor:
+        case QSOperator::LShift:
+        case QSOperator::RShift:
+        case QSOperator::URShift:
+        case QSOperator::Equal:
+        case QSOperator::NotEqual:
+        case QSOperator::Lt:
+        case QSOperator::Le:
+        case QSOperator::Gt:
+        case QSOperator::Ge:
+            return hasStaticDependencies(binary->left, scope, true)
+                    && hasStaticDependencies(binary->right, scope, true);
+        default:
+            // Short-circuiting operators, assignments, "in", "instanceof", "as"
+            return false;
+        }
+    }
+    default:
+        return false;
+    }
+}
+
 bool JSCodeGen::generateRuntimeFunctions(QmlIR::Object *object)
 {
     if (object->functionsAndExpressions->count == 0)
@@ -2096,6 +2334,14 @@ bool JSCodeGen::generateRuntimeFunctions(QmlIR::Object *object)
     if (hasError())
         return false;
 
+    for (int i = 0; i < functionsToCompile.size(); ++i) {
+        QQmlJS::AST::Node *node = functionsToCompile.at(i).node;
+        if (!node->asFunctionDefinition()
+                && hasStaticDependencies(node, { document, object, visibleIds(object) })) {
+            _module->functions.at(runtimeFunctionIndices.at(i))->hasStaticDependencies = true;
+        }
+    }
+
     object->runtimeFunctionIndices.allocate(document->jsParserEngine.pool(),
                                             runtimeFunctionIndices);
     return true;
@@ -643,8 +643,18 @@ struct Q_QML_COMPILER_EXPORT JSCodeGen : public QV4::Compiler::Codegen
 
     bool generateRuntimeFunctions(QmlIR::Object *object);
 
+    // Set this if implicit components have already been wrapped into Component objects.
+    void setImplicitComponentsResolved(bool resolved);
+
 private:
+    const QHash<QString, const Object *> &visibleIds(const Object *object);
+
     Document *document;
+    bool m_implicitComponentsResolved = false;
+
+    // Ids visible from each component root, and the component root of each object
+    QHash<const Object *, QHash<QString, const Object *>> m_visibleIdsByComponent;
+    QHash<const Object *, const Object *> m_componentRoots;
 };
 
 // RegisterStringN ~= std::function<int(QStringView)>
@@ -203,6 +203,7 @@ struct Context {
     bool innerFunctionAccessesThis = false;
     bool innerFunctionAccessesNewTarget = false;
     bool returnsClosure = false;
+    bool hasStaticDependencies = false;
     mutable bool argumentsCanEscape = false;
     bool requiresExecutionContext = false;
     bool isWithBlock = false;
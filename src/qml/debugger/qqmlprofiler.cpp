@@ -4,6 +4,8 @@
 #include "qqmlprofiler_p.h"
 #include "qqmldebugservice_p.h"
 
+#include <private/qv4string_p.h>
+
 QT_BEGIN_NAMESPACE
 
 QQmlProfiler::QQmlProfiler() : featuresEnabled(0)
@@ -25,6 +27,7 @@ void QQmlProfiler::stopProfiling()
     featuresEnabled = false;
     reportData();
     m_locations.clear();
+    m_bindingResults.clear();
 }
 
 void QQmlProfiler::reportData()
@@ -43,6 +46,55 @@ void QQmlProfiler::reportData()
     emit dataReady(data, resolved);
 }
 
+QQmlProfiler::BindingResult QQmlProfiler::BindingResult::fromValue(const QV4::Value &value)
+{
+    BindingResult result;
+    if (value.isUndefined()) {
+        result.kind = Undefined;
+    } else if (!value.isManaged()) {
+        // Numbers, booleans and null are fully encoded in the value itself.
+        result.kind = Bits;
+        result.bits = value.asReturnedValue();
+    } else if (const QV4::String *string = value.stringValue()) {
+        result.kind = String;
+        result.string = string->toQString();
+    } else {
+        result.kind = Other;
+    }
+    return result;
+}
+
+QQmlProfiler::BindingResult QQmlProfiler::BindingResult::fromData(QMetaType type, const void *data)
+{
+    BindingResult result;
+    result.type = type;
+    if (!data) {
+        result.kind = Undefined;
+    } else if (type == QMetaType::fromType<QString>()) {
+        result.kind = String;
+        result.string = *static_cast<const QString *>(data);
+    } else if (type.sizeOf() <= qsizetype(sizeof(result.bits))
+               && !(type.flags() & (QMetaType::NeedsConstruction | QMetaType::NeedsDestruction))) {
+        // Trivial types, including enums and pointers, can be compared bitwise.
+        result.kind = Bits;
+        memcpy(&result.bits, data, type.sizeOf());
+    } else {
+        result.kind = Other;
+    }
+    return result;
+}
+
+void QQmlProfiler::updateBindingResult(
+        QQmlBinding *binding, QV4::Function *function, BindingResult &&result)
+{
+    BindingResult &last = m_bindingResults[id(binding)];
+
+    // A binding allocated at the address of a deleted one must not inherit its result.
+    result.function = function;
+    *m_bindingRedundant = last.function == function && last.isComparable() && last == result;
+    last = std::move(result);
+}
+
 QT_END_NAMESPACE
 
 #include "moc_qqmlprofiler_p.cpp"
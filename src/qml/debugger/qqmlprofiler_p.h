@@ -27,6 +27,7 @@
 
 #include <QtCore/qurl.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qvariant.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -40,7 +41,8 @@ class QQmlProfiler {};
 
 struct QQmlBindingProfiler
 {
-    QQmlBindingProfiler(quintptr, QV4::Function *) {}
+    QQmlBindingProfiler(quintptr, QQmlBinding *) {}
+    void evaluated(QQmlBinding *) {}
 };
 
 struct QQmlHandlingSignalProfiler
@@ -108,6 +110,11 @@ struct Q_AUTOTEST_EXPORT QQmlProfilerData : public QQmlProfilerDefinitions
 
     int messageType;        //bit field of QQmlProfilerService::Message
     RangeType detailType;
+
+    // Only used for the RangeEnd of bindings: The number of dependencies captured by the
+    // evaluation, and whether it produced the same value as the previous evaluation.
+    qint32 numDependencies = -1;
+    bool redundant = false;
 };
 
 Q_DECLARE_TYPEINFO(QQmlProfilerData, Q_RELOCATABLE_TYPE);
@@ -337,6 +344,31 @@ public:
         m_data.append(QQmlProfilerData(m_timer.nsecsElapsed(), 1 << RangeEnd, Range));
     }
 
+    void endBinding(qint32 numDependencies, bool redundant)
+    {
+        QQmlProfilerData data(m_timer.nsecsElapsed(), 1 << RangeEnd, Binding);
+        data.numDependencies = numDependencies;
+        data.redundant = redundant;
+        m_data.append(data);
+    }
+
+    // Called by the binding with the value it is about to write. We compare it to the value the
+    // same binding wrote the last time. We must not read the target property for this, as that
+    // could run getters or evaluate lazy bindings outside of the binding's update guard.
+    void bindingResult(QQmlBinding *binding, QV4::Function *function, const QV4::Value &result)
+    {
+        if (m_bindingRedundant)
+            updateBindingResult(binding, function, BindingResult::fromValue(result));
+    }
+
+    void bindingResult(QQmlBinding *binding, QV4::Function *function,
+                       QMetaType type, const void *result)
+    {
+        if (m_bindingRedundant)
+            updateBindingResult(binding, function, BindingResult::fromData(type, result));
+    }
+
+    QQmlProfiler();
     QQmlProfiler();
 
     quint64 featuresEnabled;
@@ -356,9 +388,39 @@ Q_SIGNALS:
     void dataReady(const QVector<QQmlProfilerData> &, const QQmlProfiler::LocationHash &);
 
 protected:
+    friend struct QQmlBindingProfiler;
+
+    // Only a cheap summary of the result is kept: Primitive values and strings, which can be
+    // compared, and the type of anything else. Converting or comparing complex values would take
+    // longer than many bindings and distort the timings we are measuring.
+    struct BindingResult {
+        enum Kind : quint8 { Invalid, Undefined, Bits, String, Other };
+
+        static BindingResult fromValue(const QV4::Value &value);
+        static BindingResult fromData(QMetaType type, const void *data);
+
+        bool isComparable() const { return kind != Invalid && kind != Other; }
+        bool operator==(const BindingResult &other) const
+        {
+            return kind == other.kind && type == other.type && bits == other.bits
+                    && string == other.string;
+        }
+
+        QV4::Function *function = nullptr;
+        QMetaType type;
+        quint64 bits = 0;
+        QString string;
+        Kind kind = Invalid;
+    };
+
+    void updateBindingResult(QQmlBinding *binding, QV4::Function *function,
+                             BindingResult &&result);
+
     QElapsedTimer m_timer;
     QHash<quintptr, RefLocation> m_locations;
     QVector<QQmlProfilerData> m_data;
+    QHash<quintptr, BindingResult> m_bindingResults;
+    bool *m_bindingRedundant = nullptr;
 };
 
 //
@@ -371,18 +433,40 @@ struct QQmlProfilerHelper : public QQmlProfilerDefinitions {
 };
 
 struct QQmlBindingProfiler : public QQmlProfilerHelper {
-    QQmlBindingProfiler(QQmlProfiler *profiler, QV4::Function *function) :
+    QQmlBindingProfiler(QQmlProfiler *profiler, QQmlBinding *binding) :
         QQmlProfilerHelper(profiler)
     {
-        Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileBinding, profiler,
-                      startBinding(function));
+        Q_QML_PROFILE_IF_ENABLED(QQmlProfilerDefinitions::ProfileBinding, profiler, {
+            profiler->startBinding(binding->function());
+
+            // Bindings can be nested, as writing one property may update other bindings.
+            outerRedundant = profiler->m_bindingRedundant;
+            profiler->m_bindingRedundant = &redundant;
+            registered = true;
+        });
+    }
+
+    // Call this after the binding has been evaluated and written, unless it was deleted on the way.
+    void evaluated(QQmlBinding *binding)
+    {
+        Q_QML_PROFILE_IF_ENABLED(QQmlProfilerDefinitions::ProfileBinding, profiler, {
+            numDependencies = binding->dependencyCount();
+        });
     }
 
     ~QQmlBindingProfiler()
     {
+        if (registered)
+            profiler->m_bindingRedundant = outerRedundant;
         Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileBinding, profiler,
-                      endRange<Binding>());
+                      endBinding(numDependencies, redundant));
     }
+
+private:
+    bool *outerRedundant = nullptr;
+    qint32 numDependencies = -1;
+    bool redundant = false;
+    bool registered = false;
 };
 
 struct QQmlHandlingSignalProfiler : public QQmlProfilerHelper {
@@ -7,6 +7,11 @@
 #include <private/qqmljsdiagnosticmessage_p.h>
 
 #include <QtCore/QTextStream>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsavefile.h>
 #include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
@@ -110,6 +115,7 @@ Q_CONSTINIT static QBasicAtomicInt engineSerial = Q_BASIC_ATOMIC_INITIALIZER(1);
 Q_CONSTINIT static QBasicAtomicInt hasPreview = Q_BASIC_ATOMIC_INITIALIZER(0);
 int ExecutionEngine::s_maxCallDepth = -1;
 int ExecutionEngine::s_jitCallCountThreshold = 3;
+bool ExecutionEngine::s_recordAotFallbackCalls = false;
 int ExecutionEngine::s_maxJSStackSize = 4 * 1024 * 1024;
 int ExecutionEngine::s_maxGCStackSize = 2 * 1024 * 1024;
 
@@ -318,6 +324,8 @@ void ExecutionEngine::initializeStaticMembers()
     if (qEnvironmentVariableIsSet("QV4_FORCE_INTERPRETER"))
         s_jitCallCountThreshold = std::numeric_limits<int>::max();
 
+    s_recordAotFallbackCalls = !qEnvironmentVariableIsEmpty("QML_AOT_FALLBACK_STATS");
+
     qMetaTypeId<QJSValue>();
     qMetaTypeId<QList<int> >();
 
@@ -870,6 +878,9 @@ ExecutionEngine::~ExecutionEngine()
     }
     m_compilationUnits.clear();
 
+    if (s_recordAotFallbackCalls)
+        writeAotFallbackStats();
+
     delete bumperPointerAllocator;
     delete regExpCache;
     delete regExpAllocator;
@@ -885,6 +896,87 @@ ExecutionEngine::~ExecutionEngine()
 #endif
 }
 
+void ExecutionEngine::collectAotFallbackCalls(const ExecutableCompilationUnit *unit)
+{
+    // Only units that were compiled ahead of time are interesting. Everything else
+    // is interpreted by design.
+    if (!unit->baseCompilationUnit()->aotCompiledFunctions)
+        return;
+
+    const QString fileName = unit->fileName();
+    for (const Function *function : unit->runtimeFunctions) {
+        if (!function || function->kind == Function::AotCompiled)
+            continue;
+        if (function->aotFallbackCallCount == 0)
+            continue;
+        // Don't use function->name() here. The memory manager may already be gone.
+        const auto location = function->compiledFunction->location;
+        m_aotFallbackCalls.append({
+                fileName, unit->stringAt(function->compiledFunction->nameIndex),
+                int(location.line()), int(location.column()),
+                function->aotFallbackCallCount });
+    }
+}
+
+void ExecutionEngine::writeAotFallbackStats() const
+{
+    if (m_aotFallbackCalls.isEmpty())
+        return;
+
+    // Several engines, possibly in different threads, may report into the same file.
+    // Merge the counts by location instead of overwriting each other.
+    Q_CONSTINIT static QBasicMutex mutex;
+    QMutexLocker locker(&mutex);
+
+    const QString path = qEnvironmentVariable("QML_AOT_FALLBACK_STATS");
+    QJsonArray entries;
+    {
+        QFile file(path);
+        if (file.open(QIODevice::ReadOnly))
+            entries = QJsonDocument::fromJson(file.readAll()).array();
+    }
+
+    const auto key = [](const QString &fileName, int line, int column) {
+        return fileName + u':' + QString::number(line) + u':' + QString::number(column);
+    };
+
+    QHash<QString, qsizetype> indices;
+    for (qsizetype i = 0, end = entries.size(); i < end; ++i) {
+        const QJsonObject entry = entries[i].toObject();
+        indices.insert(key(entry[u"filepath"].toString(), entry[u"line"].toInt(),
+                           entry[u"column"].toInt()), i);
+    }
+
+    for (const AotFallbackCalls &calls : m_aotFallbackCalls) {
+        const QString entryKey = key(calls.fileName, calls.line, calls.column);
+        const auto it = indices.constFind(entryKey);
+        if (it != indices.constEnd()) {
+            QJsonObject entry = entries[*it].toObject();
+            entry[u"calls"] = entry[u"calls"].toInteger() + calls.calls;
+            entries[*it] = entry;
+            continue;
+        }
+
+        QJsonObject entry;
+        entry[u"filepath"] = calls.fileName;
+        entry[u"functionName"] = calls.functionName;
+        entry[u"line"] = calls.line;
+        entry[u"column"] = calls.column;
+        entry[u"calls"] = calls.calls;
+        indices.insert(entryKey, entries.size());
+        entries.append(entry);
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qWarning().nospace() << "Cannot write AOT fallback statistics to " << path;
+        return;
+    }
+    file.write(QJsonDocument(entries).toJson());
+    if (!file.commit())
+        qWarning().nospace() << "Cannot write AOT fallback statistics to " << path;
+}
+
 #if QT_CONFIG(qml_debug)
 void ExecutionEngine::setDebugger(Debugging::Debugger *debugger)
 {
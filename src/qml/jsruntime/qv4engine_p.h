@@ -800,6 +800,11 @@ public:
     static void setMaxCallDepth(int maxCallDepth) { s_maxCallDepth = maxCallDepth; }
     static int maxCallDepth() { return s_maxCallDepth; }
 
+    // If QML_AOT_FALLBACK_STATS is set, count the calls of functions that were interpreted
+    // although their compilation unit contains AOT-compiled code.
+    static bool recordsAotFallbackCalls() { return s_recordAotFallbackCalls; }
+    void collectAotFallbackCalls(const ExecutableCompilationUnit *unit);
+
     template<typename Value>
     static QJSPrimitiveValue createPrimitive(const Value &v)
     {
@@ -867,8 +872,11 @@ private:
         return hasJsStackOverflow() || hasCppStackOverflow();
     }
 
+    void writeAotFallbackStats() const;
+
     static int s_maxCallDepth;
     static int s_jitCallCountThreshold;
+    static bool s_recordAotFallbackCalls;
     static int s_maxJSStackSize;
     static int s_maxGCStackSize;
 
@@ -898,6 +906,16 @@ private:
 
     QMultiHash<QUrl, QQmlRefPointer<ExecutableCompilationUnit>> m_compilationUnits;
 
+    struct AotFallbackCalls
+    {
+        QString fileName;
+        QString functionName;
+        int line = 0;
+        int column = 0;
+        qint64 calls = 0;
+    };
+    QList<AotFallbackCalls> m_aotFallbackCalls;
+
     // QV4::PersistentValue would be preferred, but using QHash will create copies,
     // and QV4::PersistentValue doesn't like creating copies.
     // Instead, we allocate a raw pointer using the same manual memory management
@@ -253,6 +253,9 @@ void ExecutableCompilationUnit::clear()
     delete [] runtimeLookups;
     runtimeLookups = nullptr;
 
+    if (engine && ExecutionEngine::recordsAotFallbackCalls())
+        engine->collectAotFallbackCalls(this);
+
     for (QV4::Function *f : std::as_const(runtimeFunctions))
         f->destroy();
     runtimeFunctions.clear();
@@ -95,6 +95,7 @@ public:
     // first nArguments names in internalClass are the actual arguments
     QV4::WriteBarrier::Pointer<Heap::InternalClass> internalClass;
     int interpreterCallCount = 0;
+    qint64 aotFallbackCallCount = 0;
     quint16 nFormals = 0;
     enum Kind : quint8 { JsUntyped, JsTyped, AotCompiled, Eval };
     Kind kind = JsUntyped;
@@ -123,6 +124,7 @@ public:
     inline bool isArrowFunction() const { return compiledFunction->flags & CompiledData::Function::IsArrowFunction; }
     inline bool isGenerator() const { return compiledFunction->flags & CompiledData::Function::IsGenerator; }
     inline bool isClosureWrapper() const { return compiledFunction->flags & CompiledData::Function::IsClosureWrapper; }
+    inline bool hasStaticDependencies() const { return compiledFunction->flags & CompiledData::Function::HasStaticDependencies; }
 
     QQmlSourceLocation sourceLocation() const;
 
@@ -460,6 +460,9 @@ ReturnedValue VME::exec(JSTypesStackFrame *frame, ExecutionEngine *engine)
     Profiling::FunctionCallProfiler profiler(engine, function); // start execution profiling
     QV4::Debugging::Debugger *debugger = engine->debugger();
 
+    if (ExecutionEngine::recordsAotFallbackCalls())
+        ++function->aotFallbackCallCount;
+
 #if QT_CONFIG(qml_jit)
     if (debugger == nullptr) {
         // Check for codeRef here. In rare cases the JIT compilation may fail, which leaves us
@@ -1530,6 +1530,8 @@ static GCState executeWithLoggingIfEnabled(GCStateMachine* that, GCStateInfo& st
 }
 
 void GCStateMachine::transition() {
+    QElapsedTimer timer;
+    timer.start();
     if (timeLimit.count() > 0) {
         deadline = QDeadlineTimer(timeLimit);
         bool deadlineExpired = false;
@@ -1572,6 +1574,7 @@ void GCStateMachine::transition() {
                                           << QMetaEnum::fromType<GCState>().key(state) << "state";
         }
     }
+    totalTime += timer.nsecsElapsed();
 }
 
 } // namespace QV4
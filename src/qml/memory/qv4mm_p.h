@@ -79,6 +79,8 @@ public:
     MemoryManager *mm = nullptr;
     ExtraData stateData; // extra date for specific states
     bool collectTimings = false;
+    qint64 totalTime = 0; // nanoseconds spent in transition(), e.g. for frame timings
+    qint64 attributedTime = 0; // the part of totalTime already charged to a frame
 
     GCStateMachine();
 
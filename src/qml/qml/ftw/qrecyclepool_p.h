@@ -74,6 +74,12 @@ public:
 
     static inline void Delete(T *);
 
+    // Uninitialized storage for one T, to be used in class specific operator new and delete.
+    // Storage from AllocateUnpooled() is not recycled, but can be passed to Deallocate(), too.
+    [[nodiscard]] inline void *Allocate();
+    [[nodiscard]] static inline void *AllocateUnpooled();
+    static inline void Deallocate(void *);
+
 private:
     QRecyclePoolPrivate<T, Step> *d;
 };
@@ -105,6 +111,33 @@ void QRecyclePool<T, Step>::Delete(T *t)
     QRecyclePoolPrivate<T, Step>::dispose(t);
 }
 
+template<typename T, int Step>
+void *QRecyclePool<T, Step>::Allocate()
+{
+    return d->allocate();
+}
+
+template<typename T, int Step>
+void *QRecyclePool<T, Step>::AllocateUnpooled()
+{
+    using PoolType = typename QRecyclePoolPrivate<T, Step>::PoolType;
+    PoolType *rv = static_cast<PoolType *>(malloc(sizeof(PoolType)));
+    Q_CHECK_PTR(rv);
+    rv->pool = nullptr;
+    return static_cast<T *>(rv);
+}
+
+template<typename T, int Step>
+void QRecyclePool<T, Step>::Deallocate(void *t)
+{
+    using PoolType = typename QRecyclePoolPrivate<T, Step>::PoolType;
+    PoolType *pt = static_cast<PoolType *>(static_cast<T *>(t));
+    if (pt->pool)
+        QRecyclePoolPrivate<T, Step>::dispose(pt);
+    else
+        free(pt);
+}
+
 template<typename T, int Step>
 void QRecyclePoolPrivate<T, Step>::releaseIfPossible()
 {
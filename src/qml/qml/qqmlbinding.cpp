@@ -21,6 +21,7 @@
 #include <private/qv4variantobject_p.h>
 #include <private/qv4jscall_p.h>
 #include <private/qjsvalue_p.h>
+#include <private/qrecyclepool_p.h>
 
 #include <qtqml_tracepoints_p.h>
 
@@ -35,12 +36,15 @@ Q_TRACE_POINT(qtqml, QQmlBinding_exit)
 
 QQmlBinding *QQmlBinding::create(const QQmlPropertyData *property, const QQmlScriptString &script, QObject *obj, QQmlContext *ctxt)
 {
-    QQmlBinding *b = newBinding(property);
+    const QQmlScriptStringPrivate *scriptPrivate = script.d.data();
+    QQmlContext *bindingContext = ctxt ? ctxt : scriptPrivate->context;
+    QQmlBinding *b = newBinding(
+            (bindingContext && bindingContext->isValid()) ? bindingContext->engine() : nullptr,
+            property);
 
     if (ctxt && !ctxt->isValid())
         return b;
 
-    const QQmlScriptStringPrivate *scriptPrivate = script.d.data();
     if (!ctxt && (!scriptPrivate->context || !scriptPrivate->context->isValid()))
         return b;
 
@@ -91,7 +95,7 @@ QQmlBinding *QQmlBinding::create(
         const QQmlPropertyData *property, const QString &str, QObject *obj,
         const QQmlRefPointer<QQmlContextData> &ctxt, const QString &url, quint16 lineNumber)
 {
-    QQmlBinding *b = newBinding(property);
+    QQmlBinding *b = newBinding(ctxt ? ctxt->engine() : nullptr, property);
 
     b->setNotifyOnValueChanged(true);
     b->QQmlJavaScriptExpression::setContext(ctxt);
@@ -113,7 +117,7 @@ QQmlBinding *QQmlBinding::create(QMetaType propertyType, QV4::Function *function
                                  const QQmlRefPointer<QQmlContextData> &ctxt,
                                  QV4::ExecutionContext *scope)
 {
-    QQmlBinding *b = newBinding(propertyType);
+    QQmlBinding *b = newBinding(ctxt ? ctxt->engine() : nullptr, propertyType);
 
     b->setNotifyOnValueChanged(true);
     b->QQmlJavaScriptExpression::setContext(ctxt);
@@ -130,6 +134,34 @@ QQmlBinding::~QQmlBinding()
     delete m_sourceLocation;
 }
 
+using QQmlBindingPool = QRecyclePool<QQmlBinding, 256>;
+
+// Most bindings are GenericBindings, which have the same size as QQmlBinding. When creating
+// objects, we create many of them. Take them from the engine's pool to avoid calling malloc()
+// for each one. Without an engine we allocate the same layout outside of any pool, so that
+// operator delete can tell the two apart.
+void *QQmlBinding::operator new(size_t size)
+{
+    if (size == sizeof(QQmlBinding))
+        return QQmlBindingPool::AllocateUnpooled();
+    return ::operator new(size);
+}
+
+void *QQmlBinding::operator new(size_t size, QQmlEngine *engine)
+{
+    if (engine && size == sizeof(QQmlBinding))
+        return QQmlEnginePrivate::get(engine)->bindingPool.Allocate();
+    return operator new(size);
+}
+
+void QQmlBinding::operator delete(void *ptr, size_t size)
+{
+    if (size == sizeof(QQmlBinding))
+        QQmlBindingPool::Deallocate(ptr);
+    else
+        ::operator delete(ptr);
+}
+
 void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 {
     if (!enabledFlag() || !hasValidContext())
@@ -161,11 +193,13 @@ void QQmlBinding::update(QQmlPropertyData::WriteFlags flags)
 
     Q_TRACE_SCOPE(QQmlBinding, qmlEngine, function() ? function()->name()->toQString() : QString(),
                   sourceLocation().sourceFile, sourceLocation().line, sourceLocation().column);
-    QQmlBindingProfiler prof(QQmlEnginePrivate::get(qmlEngine)->profiler, function());
+    QQmlBindingProfiler prof(QQmlEnginePrivate::get(qmlEngine)->profiler, this);
     doUpdate(watcher, flags, scope);
 
-    if (!watcher.wasDeleted())
+    if (!watcher.wasDeleted()) {
+        prof.evaluated(this);
         setUpdatingFlag(false);
+    }
 }
 
 void QQmlBinding::printBindingLoopError(const QQmlProperty &prop)
@@ -309,6 +343,10 @@ public:
         const QString result = this->bindingValue();
 
         Q_ASSERT(targetObject());
+        Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileBinding,
+                      QQmlEnginePrivate::get(scope.engine)->profiler,
+                      bindingResult(this, function(), QMetaType::fromType<QString>(),
+                                    &result));
 
         const QQmlPropertyData *pd;
         QQmlPropertyData vpd;
@@ -674,6 +712,18 @@ bool QQmlBinding::hasDependencies() const
     return !activeGuards.isEmpty() || qpropertyChangeTriggers;
 }
 
+int QQmlBinding::dependencyCount() const
+{
+    int count = 0;
+    for (QQmlJavaScriptExpressionGuard *guard = activeGuards.first(); guard;
+         guard = activeGuards.next(guard)) {
+        ++count;
+    }
+    for (auto trigger = qpropertyChangeTriggers; trigger; trigger = trigger->next)
+        ++count;
+    return count;
+}
+
 void QQmlBinding::doUpdate(const DeleteWatcher &watcher, QQmlPropertyData::WriteFlags flags, QV4::Scope &scope)
 {
     auto ep = QQmlEnginePrivate::get(scope.engine);
@@ -687,8 +737,12 @@ void QQmlBinding::doUpdate(const DeleteWatcher &watcher, QQmlPropertyData::Write
         if (returnType == QMetaType::fromType<QVariant>()) {
             QVariant result;
             const bool isUndefined = !evaluate(&result, returnType);
-            if (canWrite())
+            if (canWrite()) {
+                Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileBinding, ep->profiler,
+                              bindingResult(this, function(), result.metaType(),
+                                            isUndefined ? nullptr : result.constData()));
                 error = !write(result.data(), result.metaType(), isUndefined, flags);
+            }
         } else {
             const auto size = returnType.sizeOf();
             if (Q_LIKELY(size > 0)) {
@@ -696,19 +750,29 @@ void QQmlBinding::doUpdate(const DeleteWatcher &watcher, QQmlPropertyData::Write
                 if (returnType.flags() & QMetaType::NeedsConstruction)
                     returnType.construct(result);
                 const bool isUndefined = !evaluate(result, returnType);
-                if (canWrite())
+                if (canWrite()) {
+                    Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileBinding, ep->profiler,
+                                  bindingResult(this, function(), returnType,
+                                                isUndefined ? nullptr : result));
                     error = !write(result, returnType, isUndefined, flags);
+                }
                 if (returnType.flags() & QMetaType::NeedsDestruction)
                     returnType.destruct(result);
             } else if (canWrite()) {
+                Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileBinding, ep->profiler,
+                              bindingResult(this, function(), returnType, nullptr));
                 error = !write(QV4::Encode::undefined(), true, flags);
             }
         }
     } else {
         bool isUndefined = false;
         QV4::ScopedValue result(scope, evaluate(&isUndefined));
-        if (canWrite())
+        if (canWrite()) {
+            Q_QML_PROFILE(QQmlProfilerDefinitions::ProfileBinding, ep->profiler,
+                          bindingResult(this, function(), isUndefined
+                                        ? QV4::Value::undefinedValue() : *result));
             error = !write(result, isUndefined, flags);
+        }
     }
 
     if (!watcher.wasDeleted()) {
@@ -836,29 +900,29 @@ private:
     }
 };
 
-QQmlBinding *QQmlBinding::newBinding(const QQmlPropertyData *property)
+QQmlBinding *QQmlBinding::newBinding(QQmlEngine *engine, const QQmlPropertyData *property)
 {
-    return newBinding(property ? property->propType() : QMetaType());
+    return newBinding(engine, property ? property->propType() : QMetaType());
 }
 
-QQmlBinding *QQmlBinding::newBinding(QMetaType propertyType)
+QQmlBinding *QQmlBinding::newBinding(QQmlEngine *engine, QMetaType propertyType)
 {
     if (propertyType.flags() & QMetaType::PointerToQObject)
         return new QObjectPointerBinding(propertyType);
 
     switch (propertyType.id()) {
     case QMetaType::Bool:
-        return new GenericBinding<QMetaType::Bool>;
+        return new (engine) GenericBinding<QMetaType::Bool>;
     case QMetaType::Int:
-        return new GenericBinding<QMetaType::Int>;
+        return new (engine) GenericBinding<QMetaType::Int>;
     case QMetaType::Double:
-        return new GenericBinding<QMetaType::Double>;
+        return new (engine) GenericBinding<QMetaType::Double>;
     case QMetaType::Float:
-        return new GenericBinding<QMetaType::Float>;
+        return new (engine) GenericBinding<QMetaType::Float>;
     case QMetaType::QString:
-        return new GenericBinding<QMetaType::QString>;
+        return new (engine) GenericBinding<QMetaType::QString>;
     default:
-        return new GenericBinding<QMetaType::UnknownType>;
+        return new (engine) GenericBinding<QMetaType::UnknownType>;
     }
 }
 
@@ -66,6 +66,10 @@ public:
 
     ~QQmlBinding() override;
 
+    static void *operator new(size_t size);
+    static void *operator new(size_t size, QQmlEngine *engine);
+    static void operator delete(void *ptr, size_t size);
+
     bool mustCaptureBindableProperty() const final {return true;}
     void refresh() override;
 
@@ -106,6 +110,9 @@ public:
     // This method is used internally to check whether a binding is constant and can be removed
     virtual bool hasDependencies() const;
 
+    // This method is used by the profiler to report the number of captured dependencies.
+    int dependencyCount() const;
+
 protected:
     virtual void doUpdate(const DeleteWatcher &watcher,
                   QQmlPropertyData::WriteFlags flags, QV4::Scope &scope);
@@ -124,8 +131,8 @@ protected:
     QV4::ReturnedValue evaluate(bool *isUndefined);
 
 private:
-    static QQmlBinding *newBinding(const QQmlPropertyData *property);
-    static QQmlBinding *newBinding(QMetaType propertyType);
+    static QQmlBinding *newBinding(QQmlEngine *engine, const QQmlPropertyData *property);
+    static QQmlBinding *newBinding(QQmlEngine *engine, QMetaType propertyType);
 
     QQmlSourceLocation *m_sourceLocation = nullptr; // used for Qt.binding() created functions
     QV4::PersistentValue m_boundFunction; // used for Qt.binding() that are created from a bound function object
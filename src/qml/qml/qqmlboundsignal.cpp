@@ -13,6 +13,7 @@
 #include "qqmlinfo.h"
 
 #include <private/qjsvalue_p.h>
+#include <private/qrecyclepool_p.h>
 #include <private/qv4value_p.h>
 #include <private/qv4jscall_p.h>
 #include <private/qv4qobjectwrapper_p.h>
@@ -233,6 +234,29 @@ QQmlBoundSignal::~QQmlBoundSignal()
     removeFromObject();
 }
 
+using QQmlBoundSignalPool = QRecyclePool<QQmlBoundSignal, 256>;
+
+// Signal handlers are created in large numbers along with the objects they belong to.
+// Take them from the engine's pool to avoid calling malloc() for each one.
+void *QQmlBoundSignal::operator new(size_t size)
+{
+    Q_ASSERT(size == sizeof(QQmlBoundSignal));
+    return QQmlBoundSignalPool::AllocateUnpooled();
+}
+
+void *QQmlBoundSignal::operator new(size_t size, QQmlEngine *engine)
+{
+    Q_ASSERT(size == sizeof(QQmlBoundSignal));
+    if (!engine)
+        return QQmlBoundSignalPool::AllocateUnpooled();
+    return QQmlEnginePrivate::get(engine)->boundSignalPool.Allocate();
+}
+
+void QQmlBoundSignal::operator delete(void *ptr)
+{
+    QQmlBoundSignalPool::Deallocate(ptr);
+}
+
 void QQmlBoundSignal::addToObject(QObject *obj)
 {
     Q_ASSERT(!m_prevSignal);
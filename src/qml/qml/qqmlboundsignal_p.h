@@ -68,6 +68,10 @@ public:
     QQmlBoundSignal(QObject *target, int signal, QObject *owner, QQmlEngine *engine);
     ~QQmlBoundSignal();
 
+    static void *operator new(size_t size);
+    static void *operator new(size_t size, QQmlEngine *engine);
+    static void operator delete(void *ptr);
+
     void removeFromObject();
 
     QQmlBoundSignalExpression *expression() const;
@@ -5,6 +5,7 @@
 #include "qqmlengine.h"
 
 #include <private/qqmlabstractbinding_p.h>
+#include <private/qqmlbinding_p.h>
 #include <private/qqmlboundsignal_p.h>
 #include <private/qqmlcontext_p.h>
 #include <private/qqmlnotifier_p.h>
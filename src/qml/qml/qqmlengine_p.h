@@ -50,6 +50,8 @@
 QT_BEGIN_NAMESPACE
 
 class QNetworkAccessManager;
+class QQmlBinding;
+class QQmlBoundSignal;
 class QQmlDelayedError;
 class QQmlIncubator;
 class QQmlMetaObject;
@@ -114,6 +116,10 @@ public:
     QRecyclePool<QQmlJavaScriptExpressionGuard> jsExpressionGuardPool;
     QRecyclePool<TriggerList> qPropertyTriggerPool;
 
+    // Bindings and signal handlers are created in large numbers when instantiating components.
+    QRecyclePool<QQmlBinding, 256> bindingPool;
+    QRecyclePool<QQmlBoundSignal, 256> boundSignalPool;
+
     QQmlContext *rootContext = nullptr;
     Q_OBJECT_BINDABLE_PROPERTY(QQmlEnginePrivate, QString, translationLanguage);
 
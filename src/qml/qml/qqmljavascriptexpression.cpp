@@ -167,10 +167,25 @@ public:
         Q_ASSERT(expression->notifyOnValueChanged() || expression->activeGuards.isEmpty());
 
         lastPropertyCapture = ep->propertyCapture;
-        ep->propertyCapture = expression->notifyOnValueChanged() ? &capture : nullptr;
 
-        if (expression->notifyOnValueChanged())
+        switch (expression->activeGuards.tag()) {
+        case QQmlJavaScriptExpression::NoGuardTag:
+            ep->propertyCapture = nullptr;
+            break;
+        case QQmlJavaScriptExpression::NotifyOnValueChanged:
+            ep->propertyCapture = &capture;
             capture.guards.copyAndClearPrepend(expression->activeGuards);
+            break;
+        case QQmlJavaScriptExpression::StaticGuardsCaptured:
+            // The dependencies are static and we've captured them before. There is no need to
+            // capture them again. Just cancel any pending notifications, like capturing would.
+            ep->propertyCapture = nullptr;
+            for (QQmlJavaScriptExpressionGuard *g = expression->activeGuards.first(); g;
+                 g = expression->activeGuards.next(g)) {
+                g->cancelNotify();
+            }
+            break;
+        }
     }
 
     ~QQmlJavaScriptExpressionCapture()
@@ -198,8 +213,18 @@ public:
             return true;
         }
 
-        if (!watcher.wasDeleted() && capture.expression->hasDelayedError())
-            capture.expression->delayedError()->clearError();
+        if (!watcher.wasDeleted()) {
+            QQmlJavaScriptExpression *expression = capture.expression;
+            if (expression->hasDelayedError())
+                expression->delayedError()->clearError();
+
+            // Only a complete evaluation has captured all the dependencies. Keep capturing if
+            // some of them are not bindable, so that we keep warning about each of them.
+            if (expression->activeGuards.tag() == QQmlJavaScriptExpression::NotifyOnValueChanged
+                    && expression->function()->hasStaticDependencies() && !capture.errorString) {
+                expression->activeGuards.setTag(QQmlJavaScriptExpression::StaticGuardsCaptured);
+            }
+        }
         return false;
     }
 
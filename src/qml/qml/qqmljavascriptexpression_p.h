@@ -150,7 +150,10 @@ protected:
 
     enum GuardTag {
         NoGuardTag,
-        NotifyOnValueChanged
+        NotifyOnValueChanged,
+
+        // The function has static dependencies and activeGuards holds all of them already.
+        StaticGuardsCaptured
     };
 
     QForwardFieldList<QQmlJavaScriptExpressionGuard, &QQmlJavaScriptExpressionGuard::next, GuardTag> activeGuards;
@@ -239,7 +242,7 @@ bool QQmlJavaScriptExpression::DeleteWatcher::wasDeleted() const
 
 bool QQmlJavaScriptExpression::notifyOnValueChanged() const
 {
-    return activeGuards.tag() == NotifyOnValueChanged;
+    return activeGuards.tag() != NoGuardTag;
 }
 
 QObject *QQmlJavaScriptExpression::scopeObject() const
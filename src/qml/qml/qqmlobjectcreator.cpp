@@ -999,7 +999,8 @@ bool QQmlObjectCreator::setPropertyBinding(const QQmlPropertyData *bindingProper
                 Q_ASSERT(bindable.isValid());
                 bindable.observe(&observer);
             } else {
-                QQmlBoundSignal *bs = new QQmlBoundSignal(_bindingTarget, signalIndex, _scopeObject, engine);
+                QQmlBoundSignal *bs = new (engine) QQmlBoundSignal(
+                        _bindingTarget, signalIndex, _scopeObject, engine);
                 bs->takeExpression(expr);
             }
         } else if (bindingProperty->isBindable()) {
@@ -1055,8 +1055,8 @@ void QQmlPropertyPrivate::takeSignalExpression(const QQmlProperty &that,
 
     if (expr) {
         int signalIndex = QQmlPropertyPrivate::get(that)->signalIndex();
-        QQmlBoundSignal *signal = new QQmlBoundSignal(that.d->object, signalIndex, that.d->object,
-                                                      expr->engine());
+        QQmlBoundSignal *signal = new (expr->engine()) QQmlBoundSignal(
+                that.d->object, signalIndex, that.d->object, expr->engine());
         signal->takeExpression(expr);
     }
 }
@@ -448,13 +448,8 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
         // Extract method name
         // It's safe to keep the raw name pointer
         Q_ASSERT(QMetaObjectPrivate::get(metaObject)->revision >= 7);
-        const char *rawName = m.nameView().constData();
-        const char *cptr = rawName;
-        char utf8 = 0;
-        while (*cptr) {
-            utf8 |= *cptr & 0x80;
-            ++cptr;
-        }
+        const QByteArrayView rawName = m.nameView();
+        const bool utf8 = !QtPrivate::isAscii(QLatin1StringView(rawName));
 
         QQmlPropertyData *data = &methodIndexCache[ii - methodIndexCacheStart];
         QQmlPropertyData *sigdata = nullptr;
@@ -506,14 +501,22 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
         };
 
         if (utf8)
-            doSetNamedProperty(QHashedString(QString::fromUtf8(rawName, cptr - rawName)));
+            doSetNamedProperty(QHashedString(QString::fromUtf8(rawName)));
         else
-            doSetNamedProperty(QHashedCStringRef(rawName, cptr - rawName));
+            doSetNamedProperty(QHashedCStringRef(rawName.constData(), rawName.size()));
     }
 
     int propCount = metaObject->propertyCount();
     int propOffset = metaObject->propertyOffset();
 
+    bool isGadget = true;
+    for (const QMetaObject *it = metaObject; it != nullptr; it = it->superClass()) {
+        if (it == &QObject::staticMetaObject) {
+            isGadget = false;
+            break;
+        }
+    }
+
     // update() should have reserved enough space in the vector that this doesn't cause a realloc
     // and invalidate the stringCache.
     propertyIndexCache.resize(propCount - propertyIndexCacheStart);
@@ -522,13 +525,9 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
         if (!p.isScriptable())
             continue;
 
-        const char *str = p.name();
-        char utf8 = 0;
-        const char *cptr = str;
-        while (*cptr != 0) {
-            utf8 |= *cptr & 0x80;
-            ++cptr;
-        }
+        // QMetaProperty has no accessor for the known length of its name.
+        const QByteArrayView str(p.name());
+        const bool utf8 = !QtPrivate::isAscii(QLatin1StringView(str));
 
         QQmlPropertyData *data = &propertyIndexCache[ii - propertyIndexCacheStart];
 
@@ -542,7 +541,7 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
         QQmlPropertyData *old = nullptr;
 
         if (utf8) {
-            QHashedString propName(QString::fromUtf8(str, cptr - str));
+            QHashedString propName(QString::fromUtf8(str));
             if (StringCache::mapped_type *it = stringCache.value(propName)) {
                 if (handleOverride(propName, data, (old = it->second)) == InvalidOverride) {
                     *data = *old;
@@ -551,7 +550,7 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
             }
             setNamedProperty(propName, ii, data);
         } else {
-            QHashedCStringRef propName(str, cptr - str);
+            QHashedCStringRef propName(str.constData(), str.size());
             if (StringCache::mapped_type *it = stringCache.value(propName)) {
                 if (handleOverride(propName, data, (old = it->second)) == InvalidOverride) {
                     *data = *old;
@@ -561,12 +560,6 @@ void QQmlPropertyCache::append(const QMetaObject *metaObject,
             setNamedProperty(propName, ii, data);
         }
 
-        bool isGadget = true;
-        for (const QMetaObject *it = metaObject; it != nullptr; it = it->superClass()) {
-            if (it == &QObject::staticMetaObject)
-                isGadget = false;
-        }
-
         // otherwise always dispatch over a 'normal' meta-call so the QQmlValueType can intercept
         if (!isGadget)
             data->trySetStaticMetaCallFunction(metaObject->d.static_metacall, ii - propOffset);
@@ -8,9 +8,13 @@
 #include <private/qobject_p.h>
 #include <private/qqmltype_p_p.h>
 
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+
 QT_BEGIN_NAMESPACE
 
-void qmltcCreateDynamicMetaObject(QObject *object, const QmltcTypeData &data)
+static QQmlType createQmltcType(const QmltcTypeData &data)
 {
     // TODO: when/if qmltc-compiled types would be registered via
     // qmltyperegistrar, instead of creating a dummy QQmlTypePrivate, fetch the
@@ -19,12 +23,6 @@ void qmltcCreateDynamicMetaObject(QObject *object, const QmltcTypeData &data)
     // available ahead-of-time to qmltc.
     auto qmlTypePrivate = new QQmlTypePrivate(data.regType);
 
-    // tie qmlTypePrivate destruction to objects's destruction. the type's
-    // content is not needed once the associated object is deleted
-    QObject::connect(object, &QObject::destroyed, object,
-                     [qmlTypePrivate](QObject *) { qmlTypePrivate->release(); },
-                     Qt::DirectConnection);
-
     // initialize QQmlType::QQmlCppTypeData
     Q_ASSERT(data.regType == QQmlType::CppType);
     qmlTypePrivate->extraData.cppTypeData->allocationSize = data.allocationSize;
@@ -48,7 +46,37 @@ void qmltcCreateDynamicMetaObject(QObject *object, const QmltcTypeData &data)
     qmlTypePrivate->baseMetaObject = data.metaObject;
 
     QQmlType qmlType(qmlTypePrivate);
+    qmlTypePrivate->release(); // qmlType holds the only reference now
     Q_ASSERT(qmlType.isValid());
+    return qmlType;
+}
+
+// The type only depends on the static meta object of the generated class.
+// Create it once per class rather than once per object, so that creating
+// another instance only costs the proxy meta object.
+Q_CONSTINIT static QBasicMutex qmltcTypesMutex;
+Q_GLOBAL_STATIC((QHash<const QMetaObject *, QQmlType>), qmltcTypes)
+
+// The proxy meta objects of the instances refer to the types. Like the
+// instances, the types must not outlive the application.
+static void clearQmltcTypes()
+{
+    QMutexLocker locker(&qmltcTypesMutex);
+    qmltcTypes->clear();
+}
+
+void qmltcCreateDynamicMetaObject(QObject *object, const QmltcTypeData &data)
+{
+    QQmlType qmlType;
+    {
+        QMutexLocker locker(&qmltcTypesMutex);
+        if (qmltcTypes->isEmpty())
+            qAddPostRoutine(clearQmltcTypes);
+        auto it = qmltcTypes->find(data.metaObject);
+        if (it == qmltcTypes->end())
+            it = qmltcTypes->insert(data.metaObject, createQmltcType(data));
+        qmlType = *it;
+    }
 
     QObjectPrivate *op = QObjectPrivate::get(object);
     // ### inefficient - rather, call this function only once for the leaf type
@@ -25,6 +25,10 @@ public:
 
     inline void write(const QString &msg)
     {
+        if (m_buffer) {
+            m_buffer->append(msg);
+            return;
+        }
         const QByteArray encodedMsg = msg.toLocal8Bit();
         fwrite(encodedMsg.constData(), size_t(1), size_t(encodedMsg.size()), stderr);
     }
@@ -47,6 +51,9 @@ public:
     void setSilent(bool silent) { m_silent = silent; }
     bool isSilent() const { return m_silent; }
 
+    void setBuffer(QString *buffer) { m_buffer = buffer; }
+    QString *buffer() const { return m_buffer; }
+
     void setCurrentColorID(int colorId) { m_currentColorID = colorId; }
 
     bool coloringEnabled() const { return m_coloringEnabled; }
@@ -54,6 +61,7 @@ public:
 private:
     QFile                       m_out;
     QColorOutput::ColorMapping  m_colorMapping;
+    QString                    *m_buffer = nullptr;
     int                         m_currentColorID = -1;
     bool                        m_coloringEnabled = false;
     bool                        m_silent = false;
@@ -208,6 +216,16 @@ QColorOutput::~QColorOutput() = default;
 bool QColorOutput::isSilent() const { return d->isSilent(); }
 void QColorOutput::setSilent(bool silent) { d->setSilent(silent); }
 
+/*!
+ \internal
+ Makes all further output go to \a buffer instead of \c stderr. This allows
+ callers to print the output of several QColorOutput instances, possibly used on
+ different threads, without interleaving it. Pass \nullptr to write to \c stderr
+ again.
+ */
+void QColorOutput::setBuffer(QString *buffer) { d->setBuffer(buffer); }
+QString *QColorOutput::buffer() const { return d->buffer(); }
+
 /*!
  \internal
  Sends \a message to \c stderr, using the color looked up in the color mapping using \a colorID.
@@ -74,6 +74,9 @@ public:
     bool isSilent() const;
     void setSilent(bool silent);
 
+    QString *buffer() const;
+    void setBuffer(QString *buffer);
+
     void insertMapping(int colorID, ColorCode colorCode);
 
     void writeUncolored(const QString &message);
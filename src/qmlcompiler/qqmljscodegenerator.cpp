@@ -662,6 +662,8 @@ void QQmlJSCodeGenerator::generate_MoveRegExp(int regExpId, int destReg)
 
 void QQmlJSCodeGenerator::generate_LoadClosure(int value)
 {
+    // We don't create call contexts, so closures could not capture the locals of the enclosing
+    // function. Functions that create closures keep running as bytecode.
     Q_UNUSED(value)
     reject(u"LoadClosure"_s);
 }
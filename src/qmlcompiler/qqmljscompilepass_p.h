@@ -78,6 +78,7 @@ public:
         QQmlJSRegisterContent changedRegister;
         int changedRegisterIndex = InvalidRegister;
         bool hasSideEffects = false;
+        bool hasOnlyLocalListSideEffects = false;
         bool isRename = false;
     };
 
@@ -225,15 +226,28 @@ public:
         }
 
         bool hasSideEffects() const { return m_hasSideEffects; }
+        bool hasOnlyLocalListSideEffects() const { return m_hasOnlyLocalListSideEffects; }
 
-        void markSideEffects(bool hasSideEffects) { m_hasSideEffects = hasSideEffects; }
-        void applySideEffects(bool hasSideEffects)
+        void markSideEffects(bool hasSideEffects, bool onlyLocalLists = false)
+        {
+            m_hasSideEffects = hasSideEffects;
+            m_hasOnlyLocalListSideEffects = hasSideEffects && onlyLocalLists;
+        }
+
+        // If onlyLocalLists is set, function must be the function being compiled.
+        void applySideEffects(bool hasSideEffects, bool onlyLocalLists = false,
+                              const Function *function = nullptr)
         {
             if (!hasSideEffects)
                 return;
 
-            for (auto it = registers.begin(), end = registers.end(); it != end; ++it)
-                it.value().affectedBySideEffects = true;
+            Q_ASSERT(!onlyLocalLists || function);
+            for (auto it = registers.begin(), end = registers.end(); it != end; ++it) {
+                if (!onlyLocalLists
+                        || !isDetachedSequence(it.key(), it.value().content, function)) {
+                    it.value().affectedBySideEffects = true;
+                }
+            }
 
             for (auto it = lookups.begin(), end = lookups.end(); it != end; ++it)
                 it.value().affectedBySideEffects = true;
@@ -244,6 +258,70 @@ public:
             applySideEffects(hasSideEffects);
         }
 
+        /*!
+            \internal
+            \brief Marks the current instruction as modifying only a list created by the function
+            itself, for example by pushing to an array literal.
+
+            Such a list cannot alias sequences read from properties or passed as typed arguments.
+            Those are copies. Registers holding them are therefore not affected.
+        */
+        void setHasLocalListSideEffects(const Function *function)
+        {
+            markSideEffects(true, true);
+            applySideEffects(true, true, function);
+        }
+
+        /*!
+            \internal
+            Returns whether the register \a registerIndex with the given \a content holds a
+            sequence that is a copy of its origin: Either it was read from a property, or it is
+            a typed argument of \a function still held in its argument register. Other named
+            types, for example the results of "as" casts, are not considered detached.
+        */
+        static bool isDetachedSequence(
+                int registerIndex, const QQmlJSRegisterContent &content, const Function *function)
+        {
+            if (content.isConversion()) {
+                const QList<QQmlJSRegisterContent> origins = content.conversionOrigins();
+                return std::all_of(origins.begin(), origins.end(), [&](const auto &origin) {
+                    return isDetachedSequence(registerIndex, origin, function);
+                });
+            }
+
+            switch (content.variant()) {
+            case QQmlJSRegisterContent::Property:
+                break;
+            case QQmlJSRegisterContent::TypeByName: {
+                const qsizetype argument = registerIndex - FirstArgument;
+                if (argument < 0 || argument >= function->argumentTypes.size()
+                        || content != function->argumentTypes.at(argument)) {
+                    return false;
+                }
+                break;
+            }
+            default:
+                return false;
+            }
+
+            const QQmlJSScope::ConstPtr contained = content.containedType();
+            return contained
+                    && contained->accessSemantics() == QQmlJSScope::AccessSemantics::Sequence;
+        }
+
+        static bool isLocalList(const QQmlJSRegisterContent &content)
+        {
+            if (content.isConversion()) {
+                const QList<QQmlJSRegisterContent> origins = content.conversionOrigins();
+                return std::all_of(origins.begin(), origins.end(), [](const auto &origin) {
+                    return isLocalList(origin);
+                });
+            }
+
+            // Only array literals produce lists as the result of an operation.
+            return content.variant() == QQmlJSRegisterContent::Operation;
+        }
+
         bool isRename() const { return m_isRename; }
         void setIsRename(bool isRename) { m_isRename = isRename; }
 
@@ -259,6 +337,7 @@ public:
         QQmlJSRegisterContent m_changedRegister;
         int m_changedRegisterIndex = InvalidRegister;
         bool m_hasSideEffects = false;
+        bool m_hasOnlyLocalListSideEffects = false;
         bool m_isRename = false;
     };
 
@@ -355,12 +434,14 @@ protected:
 
         // Side effects are applied at the end of an instruction: An instruction with side
         // effects can still read its registers before the side effects happen.
-        newState.applySideEffects(oldState.hasSideEffects());
+        newState.applySideEffects(oldState.hasSideEffects(),
+                                  oldState.hasOnlyLocalListSideEffects(), m_function);
 
         if (instruction == annotations.constEnd())
             return newState;
 
-        newState.markSideEffects(instruction->second.hasSideEffects);
+        newState.markSideEffects(instruction->second.hasSideEffects,
+                                 instruction->second.hasOnlyLocalListSideEffects);
         newState.setReadRegisters(instruction->second.readRegisters);
         newState.setIsRename(instruction->second.isRename);
 
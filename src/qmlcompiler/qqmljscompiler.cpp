@@ -822,8 +822,10 @@ QQmlJSAotFunction QQmlJSAotCompiler::doCompileAndRecordAotStats(const QV4::Compi
         entry.line = location.startLine;
         entry.column = location.startColumn;
         entry.codegenSuccessful = errors->isEmpty();
+        // m_resourcePath is ":/path/in/resources" for documents compiled into resources.
         QQmlJS::QQmlJSAotCompilerStats::addEntry(
-                function->qmlScope.containedType()->filePath(), entry);
+                function->qmlScope.containedType()->filePath(),
+                m_resourcePath.startsWith(u':') ? u"qrc"_s + m_resourcePath : QString(), entry);
     }
 
     return result;
@@ -8,6 +8,7 @@
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QTextStream>
+#include <QUrl>
 
 QT_BEGIN_NAMESPACE
 
@@ -31,6 +32,13 @@ void AotStats::insert(const AotStats &other)
     for (const auto &[moduleUri, moduleStats] : other.m_entries.asKeyValueRange()) {
         m_entries[moduleUri].insert(moduleStats);
     }
+    m_fileUrls.insert(other.m_fileUrls);
+}
+
+QString AotStats::fileUrl(const QString &filepath) const
+{
+    const auto it = m_fileUrls.constFind(filepath);
+    return it != m_fileUrls.constEnd() ? *it : QUrl::fromLocalFile(filepath).toString();
 }
 
 std::optional<QList<QString>> extractAotstatsFilesList(const QString &aotstatsListPath)
@@ -94,6 +102,9 @@ AotStats AotStats::fromJsonDocument(const QJsonDocument &document)
         for (const auto &filesArrayEntry : filesArray) {
             const QJsonObject &fileObject = filesArrayEntry.toObject();
             QString filepath = fileObject[u"filepath"_s].toString();
+            const QString url = fileObject[u"url"_s].toString();
+            if (!url.isEmpty())
+                result.m_fileUrls[filepath] = url;
             const QJsonArray &statsArray = fileObject[u"entries"_s].toArray();
 
             QList<AotStatsEntry> stats;
@@ -107,6 +118,7 @@ AotStats AotStats::fromJsonDocument(const QJsonDocument &document)
                 stat.line = statsObject[u"line"_s].toInt();
                 stat.column = statsObject[u"column"_s].toInt();
                 stat.codegenSuccessful = statsObject[u"codegenSuccessfull"_s].toBool();
+                stat.runtimeFallbackCalls = statsObject[u"runtimeFallbackCalls"_s].toInteger();
                 stats.append(std::move(stat));
             }
 
@@ -142,11 +154,15 @@ QJsonDocument AotStats::toJsonDocument() const
                 statObject.insert(u"line", stat.line);
                 statObject.insert(u"column", stat.column);
                 statObject.insert(u"codegenSuccessfull", stat.codegenSuccessful);
+                if (stat.runtimeFallbackCalls > 0)
+                    statObject.insert(u"runtimeFallbackCalls", stat.runtimeFallbackCalls);
                 statsArray.append(statObject);
             }
 
             QJsonObject o;
             o.insert(u"filepath"_s, filename);
+            if (const auto url = m_fileUrls.constFind(filename); url != m_fileUrls.constEnd())
+                o.insert(u"url"_s, *url);
             o.insert(u"entries"_s, statsArray);
             filesArray.append(o);
         }
@@ -160,6 +176,142 @@ QJsonDocument AotStats::toJsonDocument() const
     return QJsonDocument(modulesArray);
 }
 
+static QString fallbackKey(const QString &url, int line, const QString &suffix)
+{
+    return url + u':' + QString::number(line) + u':' + suffix;
+}
+
+bool AotStats::applyRuntimeCounts(const QString &runtimeCountsPath)
+{
+    QFile file(runtimeCountsPath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug().noquote() << u"Could not open \"%1\""_s.arg(runtimeCountsPath);
+        return false;
+    }
+
+    QHash<QString, qint64> byColumn;
+    QHash<QString, qint64> byName;
+    const QJsonArray counts = QJsonDocument::fromJson(file.readAll()).array();
+    for (const auto &countsEntry : counts) {
+        const QJsonObject object = countsEntry.toObject();
+        const QString filepath = object[u"filepath"_s].toString();
+        const int line = object[u"line"_s].toInt();
+        const qint64 calls = object[u"calls"_s].toInteger();
+        byColumn[fallbackKey(filepath, line, QString::number(object[u"column"_s].toInt()))]
+                += calls;
+        byName[fallbackKey(filepath, line, object[u"functionName"_s].toString())] += calls;
+    }
+
+    for (auto &files : m_entries) {
+        for (auto it = files.begin(), end = files.end(); it != end; ++it) {
+            for (AotStatsEntry &entry : it.value()) {
+                if (entry.codegenSuccessful)
+                    continue;
+                // The runtime only knows the URL the file was loaded from.
+                const QString url = fileUrl(it.key());
+                const qint64 calls = byColumn.value(
+                        fallbackKey(url, entry.line, QString::number(entry.column)));
+                entry.runtimeFallbackCalls = calls > 0
+                        ? calls
+                        : byName.value(fallbackKey(url, entry.line, entry.functionName));
+            }
+        }
+    }
+
+    return true;
+}
+
+// Line numbers shift whenever a file is edited. Identify functions by name instead, and
+// disambiguate functions of the same name by their order in the file.
+static QHash<QString, AotStatsEntry> entriesByName(const QList<AotStatsEntry> &entries)
+{
+    QHash<QString, AotStatsEntry> result;
+    QHash<QString, int> occurrences;
+    for (const AotStatsEntry &entry : entries) {
+        const int occurrence = occurrences[entry.functionName]++;
+        result.insert(entry.functionName + u'#' + QString::number(occurrence), entry);
+    }
+    return result;
+}
+
+AotStatsDiff AotStats::diff(const AotStats &before, const AotStats &after,
+                            double durationThresholdPercent,
+                            std::chrono::microseconds minimumDurationDelta)
+{
+    AotStatsDiff result;
+    for (const auto &[moduleId, files] : after.m_entries.asKeyValueRange()) {
+        const auto oldFiles = before.m_entries.constFind(moduleId);
+        if (oldFiles == before.m_entries.constEnd())
+            continue;
+
+        for (const auto &[filepath, entries] : files.asKeyValueRange()) {
+            const auto oldEntries = oldFiles->constFind(filepath);
+            if (oldEntries == oldFiles->constEnd())
+                continue;
+
+            const QHash<QString, AotStatsEntry> oldByName = entriesByName(*oldEntries);
+            const QHash<QString, AotStatsEntry> newByName = entriesByName(entries);
+            for (const auto &[name, newEntry] : newByName.asKeyValueRange()) {
+                const auto oldEntry = oldByName.constFind(name);
+                if (oldEntry == oldByName.constEnd())
+                    continue;
+
+                const AotStatsChange change { moduleId, filepath, *oldEntry, newEntry };
+                if (oldEntry->codegenSuccessful && !newEntry.codegenSuccessful) {
+                    result.regressions.append(change);
+                } else if (!oldEntry->codegenSuccessful && newEntry.codegenSuccessful) {
+                    result.fixes.append(change);
+                } else if (oldEntry->codegenSuccessful) {
+                    const auto delta = newEntry.codegenDuration - oldEntry->codegenDuration;
+                    if (delta >= minimumDurationDelta
+                            && delta.count() * 100.0
+                                    > oldEntry->codegenDuration.count()
+                                            * durationThresholdPercent) {
+                        result.slowdowns.append(change);
+                    }
+                }
+            }
+        }
+    }
+
+    const auto byLocation = [](const AotStatsChange &a, const AotStatsChange &b) {
+        return std::tie(a.moduleId, a.filepath, a.after.line, a.after.column)
+                < std::tie(b.moduleId, b.filepath, b.after.line, b.after.column);
+    };
+    std::sort(result.regressions.begin(), result.regressions.end(), byLocation);
+    std::sort(result.fixes.begin(), result.fixes.end(), byLocation);
+    std::sort(result.slowdowns.begin(), result.slowdowns.end(), byLocation);
+    return result;
+}
+
+QJsonDocument AotStatsDiff::toJsonDocument() const
+{
+    const auto toArray = [](const QList<AotStatsChange> &changes) {
+        QJsonArray array;
+        for (const AotStatsChange &change : changes) {
+            QJsonObject o;
+            o.insert(u"moduleId"_s, change.moduleId);
+            o.insert(u"filepath"_s, change.filepath);
+            o.insert(u"functionName"_s, change.after.functionName);
+            o.insert(u"line"_s, change.after.line);
+            o.insert(u"column"_s, change.after.column);
+            o.insert(u"errorMessage"_s, change.after.errorMessage);
+            o.insert(u"oldDurationMicroseconds"_s,
+                     static_cast<qint64>(change.before.codegenDuration.count()));
+            o.insert(u"newDurationMicroseconds"_s,
+                     static_cast<qint64>(change.after.codegenDuration.count()));
+            array.append(o);
+        }
+        return array;
+    };
+
+    QJsonObject o;
+    o.insert(u"regressions"_s, toArray(regressions));
+    o.insert(u"fixes"_s, toArray(fixes));
+    o.insert(u"slowdowns"_s, toArray(slowdowns));
+    return QJsonDocument(o);
+}
+
 void AotStats::addEntry(
         const QString &moduleId, const QString &filepath, const AotStatsEntry &entry)
 {
@@ -178,9 +330,12 @@ bool AotStats::saveToDisk(const QString &filepath) const
     return true;
 }
 
-void QQmlJSAotCompilerStats::addEntry(const QString &filepath, const QQmlJS::AotStatsEntry &entry)
+void QQmlJSAotCompilerStats::addEntry(
+        const QString &filepath, const QString &url, const QQmlJS::AotStatsEntry &entry)
 {
     QQmlJSAotCompilerStats::instance()->addEntry(s_moduleId, filepath, entry);
+    if (!url.isEmpty())
+        QQmlJSAotCompilerStats::instance()->setFileUrl(filepath, url);
 }
 
 } // namespace QQmlJS
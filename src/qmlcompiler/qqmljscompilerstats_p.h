@@ -37,9 +37,33 @@ struct Q_QMLCOMPILER_EXPORT AotStatsEntry
     int column = 0;
     bool codegenSuccessful = true;
 
+    // How often the function was interpreted at run time instead, as recorded
+    // via QML_AOT_FALLBACK_STATS. Only meaningful if codegen failed.
+    qint64 runtimeFallbackCalls = 0;
+
     bool operator<(const AotStatsEntry &) const;
 };
 
+struct Q_QMLCOMPILER_EXPORT AotStatsChange
+{
+    QString moduleId;
+    QString filepath;
+    AotStatsEntry before;
+    AotStatsEntry after;
+};
+
+struct Q_QMLCOMPILER_EXPORT AotStatsDiff
+{
+    QList<AotStatsChange> regressions;
+    QList<AotStatsChange> fixes;
+    QList<AotStatsChange> slowdowns;
+
+    // Slower compilation is reported, but only a loss of AOT coverage is a regression.
+    bool hasRegressions() const { return !regressions.isEmpty(); }
+    bool hasSlowdowns() const { return !slowdowns.isEmpty(); }
+    QJsonDocument toJsonDocument() const;
+};
+
 class Q_QMLCOMPILER_EXPORT AotStats
 {
     friend class QQmlJSAotCompilerStats;
@@ -53,6 +77,10 @@ public:
     void addEntry(const QString &moduleId, const QString &filepath, const AotStatsEntry &entry);
     void insert(const AotStats &other);
 
+    // The URL the file is loaded from at run time, if it differs from its path.
+    QString fileUrl(const QString &filepath) const;
+    void setFileUrl(const QString &filepath, const QString &url) { m_fileUrls[filepath] = url; }
+
     bool saveToDisk(const QString &filepath) const;
 
     static std::optional<AotStats> parseAotstatsFile(const QString &aotstatsPath);
@@ -61,9 +89,18 @@ public:
     static AotStats fromJsonDocument(const QJsonDocument &);
     QJsonDocument toJsonDocument() const;
 
+    bool applyRuntimeCounts(const QString &runtimeCountsPath);
+
+    static AotStatsDiff diff(const AotStats &before, const AotStats &after,
+                             double durationThresholdPercent,
+                             std::chrono::microseconds minimumDurationDelta);
+
 private:
     // module Id -> filename -> stats m_entries
     QHash<QString, QHash<QString, QList<AotStatsEntry>>> m_entries;
+
+    // filename -> URL
+    QHash<QString, QString> m_fileUrls;
 };
 
 class Q_QMLCOMPILER_EXPORT QQmlJSAotCompilerStats
@@ -77,7 +114,8 @@ public:
     static QString moduleId() { return s_moduleId; }
     static void setModuleId(const QString &moduleId) { s_moduleId = moduleId; }
 
-    static void addEntry(const QString &filepath, const QQmlJS::AotStatsEntry &entry);
+    static void addEntry(const QString &filepath, const QString &url,
+                         const QQmlJS::AotStatsEntry &entry);
 
 private:
     static std::unique_ptr<AotStats> s_instance;
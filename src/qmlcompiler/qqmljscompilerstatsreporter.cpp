@@ -20,6 +20,8 @@ AotStatsReporter::AotStatsReporter(const AotStats &aotstats) : m_aotstats(aotsta
                 if (entry.codegenSuccessful) {
                     m_fileCounters[moduleUri][filepath].successes += 1;
                     m_successDurations.append(entry.codegenDuration);
+                } else if (entry.runtimeFallbackCalls > 0) {
+                    m_runtimeFallbacks.append({ filepath, entry });
                 }
             }
             m_moduleCounters[moduleUri].codegens += m_fileCounters[moduleUri][filepath].codegens;
@@ -28,6 +30,11 @@ AotStatsReporter::AotStatsReporter(const AotStats &aotstats) : m_aotstats(aotsta
         m_totalCounters.codegens += m_moduleCounters[moduleUri].codegens;
         m_totalCounters.successes += m_moduleCounters[moduleUri].successes;
     }
+
+    std::sort(m_runtimeFallbacks.begin(), m_runtimeFallbacks.end(),
+              [](const RuntimeFallback &a, const RuntimeFallback &b) {
+        return a.entry.runtimeFallbackCalls > b.entry.runtimeFallbackCalls;
+    });
 }
 
 void AotStatsReporter::formatDetailedStats(QTextStream &s) const
@@ -59,6 +66,8 @@ void AotStatsReporter::formatDetailedStats(QTextStream &s) const
                                                      ? u"Success\n"_s
                                                      : u"Error: "_s + stat.errorMessage + u'\n');
                 s << u"      duration: %1us\n"_s.arg(stat.codegenDuration.count());
+                if (stat.runtimeFallbackCalls > 0)
+                    s << u"      interpreted calls: %1\n"_s.arg(stat.runtimeFallbackCalls);
             }
             s << "\n";
         }
@@ -90,6 +99,26 @@ void AotStatsReporter::formatSummary(QTextStream &s) const
     }
 }
 
+void AotStatsReporter::formatRuntimeFallbacks(QTextStream &s) const
+{
+    if (m_runtimeFallbacks.isEmpty())
+        return;
+
+    // Rank the failures by how often they hurt at run time, so that the most
+    // rewarding ones can be fixed first.
+    constexpr qsizetype maxListed = 20;
+    s << "############ MOST CALLED FUNCTIONS NOT COMPILED TO CPP ############\n";
+    for (qsizetype i = 0, end = std::min(maxListed, m_runtimeFallbacks.size()); i < end; ++i) {
+        const RuntimeFallback &fallback = m_runtimeFallbacks[i];
+        s << u"%1 calls: %2 [%3:%4:%5]\n"_s.arg(fallback.entry.runtimeFallbackCalls)
+                        .arg(fallback.entry.functionName)
+                        .arg(QFileInfo(fallback.filepath).fileName())
+                        .arg(fallback.entry.line)
+                        .arg(fallback.entry.column);
+        s << u"  "_s << fallback.entry.errorMessage << u'\n';
+    }
+}
+
 QString AotStatsReporter::format() const
 {
     QString output;
@@ -97,6 +126,7 @@ QString AotStatsReporter::format() const
 
     formatDetailedStats(s);
     formatSummary(s);
+    formatRuntimeFallbacks(s);
 
     return output;
 }
@@ -34,6 +34,7 @@ public:
 private:
     void formatDetailedStats(QTextStream &) const;
     void formatSummary(QTextStream &) const;
+    void formatRuntimeFallbacks(QTextStream &) const;
     QString formatSuccessRate(int codegens, int successes) const;
 
     const AotStats &m_aotstats;
@@ -48,6 +49,13 @@ private:
     QHash<QString, Counters> m_moduleCounters;
     QHash<QString, QHash<QString, Counters>> m_fileCounters;
     QList<std::chrono::microseconds> m_successDurations;
+
+    struct RuntimeFallback
+    {
+        QString filepath;
+        AotStatsEntry entry;
+    };
+    QList<RuntimeFallback> m_runtimeFallbacks;
 };
 
 } // namespace QQmlJS
@@ -0,0 +1,315 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qqmljsimportcache_p.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+// Bump this whenever the serialization below changes.
+static constexpr quint32 ImportCacheMagic = 0x716d6c63; // "qmlc"
+static constexpr quint32 ImportCacheVersion = 1;
+
+static void writeRevision(QDataStream &stream, QTypeRevision revision)
+{
+    stream << revision.toEncodedVersion<quint16>();
+}
+
+static QTypeRevision readRevision(QDataStream &stream)
+{
+    quint16 encoded;
+    stream >> encoded;
+    return QTypeRevision::fromEncodedVersion(encoded);
+}
+
+static void writeParameter(QDataStream &stream, const QQmlJSMetaParameter &parameter)
+{
+    stream << parameter.name() << parameter.typeName() << quint8(parameter.typeQualifier())
+           << parameter.isPointer() << parameter.isList();
+}
+
+static QQmlJSMetaParameter readParameter(QDataStream &stream)
+{
+    QString name;
+    QString typeName;
+    quint8 typeQualifier;
+    bool isPointer;
+    bool isList;
+    stream >> name >> typeName >> typeQualifier >> isPointer >> isList;
+
+    QQmlJSMetaParameter parameter(name, typeName);
+    parameter.setTypeQualifier(QQmlJSMetaParameter::Constness(typeQualifier));
+    parameter.setIsPointer(isPointer);
+    parameter.setIsList(isList);
+    return parameter;
+}
+
+static void writeMethod(QDataStream &stream, const QQmlJSMetaMethod &method)
+{
+    stream << method.methodName() << quint8(method.methodType()) << qint32(method.revision())
+           << method.isCloned() << method.isConstructor() << method.isJavaScriptFunction();
+    if (method.isConstructor())
+        stream << qint32(method.constructorIndex());
+    writeParameter(stream, method.returnValue());
+
+    const QList<QQmlJSMetaParameter> parameters = method.parameters();
+    stream << qint32(parameters.size());
+    for (const QQmlJSMetaParameter &parameter : parameters)
+        writeParameter(stream, parameter);
+}
+
+static QQmlJSMetaMethod readMethod(QDataStream &stream)
+{
+    QString name;
+    quint8 methodType;
+    qint32 revision;
+    bool isCloned;
+    bool isConstructor;
+    bool isJavaScriptFunction;
+    stream >> name >> methodType >> revision >> isCloned >> isConstructor >> isJavaScriptFunction;
+
+    QQmlJSMetaMethod method;
+    method.setMethodName(name);
+    method.setMethodType(QQmlJSMetaMethodType(methodType));
+    method.setRevision(revision);
+    method.setIsCloned(isCloned);
+    method.setIsJavaScriptFunction(isJavaScriptFunction);
+    if (isConstructor) {
+        qint32 constructorIndex;
+        stream >> constructorIndex;
+        method.setIsConstructor(true);
+        method.setConstructorIndex(QQmlJSMetaMethod::RelativeFunctionIndex(constructorIndex));
+    }
+    method.setReturnValue(readParameter(stream));
+
+    qint32 parameterCount;
+    stream >> parameterCount;
+    for (qint32 i = 0; i < parameterCount && stream.status() == QDataStream::Ok; ++i)
+        method.addParameter(readParameter(stream));
+    return method;
+}
+
+static void writeProperty(QDataStream &stream, const QQmlJSMetaProperty &property)
+{
+    stream << property.propertyName() << property.typeName() << property.read()
+           << property.write() << property.reset() << property.bindable() << property.notify()
+           << property.privateClass() << property.isList() << property.isWritable()
+           << property.isPointer() << property.isTypeConstant() << property.isFinal()
+           << property.isPropertyConstant() << qint32(property.revision())
+           << qint32(property.index());
+}
+
+static QQmlJSMetaProperty readProperty(QDataStream &stream)
+{
+    QString name, typeName, read, write, reset, bindable, notify, privateClass;
+    bool isList, isWritable, isPointer, isTypeConstant, isFinal, isPropertyConstant;
+    qint32 revision, index;
+    stream >> name >> typeName >> read >> write >> reset >> bindable >> notify >> privateClass
+           >> isList >> isWritable >> isPointer >> isTypeConstant >> isFinal
+           >> isPropertyConstant >> revision >> index;
+
+    QQmlJSMetaProperty property;
+    property.setPropertyName(name);
+    property.setTypeName(typeName);
+    property.setRead(read);
+    property.setWrite(write);
+    property.setReset(reset);
+    property.setBindable(bindable);
+    property.setNotify(notify);
+    property.setPrivateClass(privateClass);
+    property.setIsList(isList);
+    property.setIsWritable(isWritable);
+    property.setIsPointer(isPointer);
+    property.setIsTypeConstant(isTypeConstant);
+    property.setIsFinal(isFinal);
+    property.setIsPropertyConstant(isPropertyConstant);
+    property.setRevision(revision);
+    property.setIndex(index);
+    return property;
+}
+
+static void writeEnum(QDataStream &stream, const QQmlJSMetaEnum &metaEnum)
+{
+    stream << metaEnum.name() << metaEnum.alias() << metaEnum.typeName() << metaEnum.isFlag()
+           << metaEnum.isScoped() << metaEnum.keys() << metaEnum.values();
+}
+
+static QQmlJSMetaEnum readEnum(QDataStream &stream)
+{
+    QString name, alias, typeName;
+    bool isFlag, isScoped;
+    QStringList keys;
+    QList<int> values;
+    stream >> name >> alias >> typeName >> isFlag >> isScoped >> keys >> values;
+
+    QQmlJSMetaEnum metaEnum;
+    metaEnum.setName(name);
+    metaEnum.setAlias(alias);
+    metaEnum.setTypeName(typeName);
+    metaEnum.setIsFlag(isFlag);
+    metaEnum.setIsScoped(isScoped);
+    for (const QString &key : std::as_const(keys))
+        metaEnum.addKey(key);
+    for (int value : std::as_const(values))
+        metaEnum.addValue(value);
+    return metaEnum;
+}
+
+QByteArray QQmlJSImportCache::contentHash(const QByteArray &content)
+{
+    return QCryptographicHash::hash(content, QCryptographicHash::Sha1).toHex();
+}
+
+QString QQmlJSImportCache::entryPath(const QByteArray &hash) const
+{
+    return m_directory + u'/' + QString::fromLatin1(hash) + u".qmltypescache"_s;
+}
+
+bool QQmlJSImportCache::load(const QByteArray &hash, Entry *entry) const
+{
+    if (!isEnabled())
+        return false;
+
+    QFile file(entryPath(hash));
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    // Map the file rather than reading it. Many processes read the same few
+    // entries over and over, and the page cache can then be shared.
+    const qint64 size = file.size();
+    const uchar *data = size > 0 ? file.map(0, size) : nullptr;
+    const QByteArray bytes = data
+            ? QByteArray::fromRawData(reinterpret_cast<const char *>(data), size)
+            : file.readAll();
+
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic;
+    quint32 version;
+    quint32 qtVersion;
+    stream >> magic >> version >> qtVersion;
+    if (magic != ImportCacheMagic || version != ImportCacheVersion || qtVersion != QT_VERSION)
+        return false;
+
+    Entry result;
+    stream >> result.dependencies >> result.warningMessage;
+
+    qint32 objectCount;
+    stream >> objectCount;
+    for (qint32 i = 0; i < objectCount && stream.status() == QDataStream::Ok; ++i) {
+        QQmlJSScope::Ptr scope = QQmlJSScope::create();
+
+        // m_filePath is the "file" binding of the component, i.e. the C++
+        // header. It only depends on the content the entry is keyed by.
+
+        quint32 flags;
+        quint8 semantics;
+        stream >> scope->m_filePath >> scope->m_internalName >> scope->m_baseTypeNameOrError
+                >> scope->m_defaultPropertyName >> scope->m_parentPropertyName
+                >> scope->m_attachedTypeName >> scope->m_valueTypeName
+                >> scope->m_extensionTypeName >> scope->m_aliases >> scope->m_interfaceNames
+                >> scope->m_ownDeferredNames >> scope->m_ownImmediateNames
+                >> scope->m_requiredPropertyNames >> flags >> semantics;
+        scope->m_flags = QQmlJSScope::Flags::fromInt(flags);
+        scope->m_semantics = QQmlJSScope::AccessSemantics(semantics);
+
+        qint32 count;
+        stream >> count;
+        for (qint32 j = 0; j < count && stream.status() == QDataStream::Ok; ++j)
+            scope->addOwnProperty(readProperty(stream));
+
+        // Methods are stored in insertion order so that overloads keep their order.
+        stream >> count;
+        for (qint32 j = 0; j < count && stream.status() == QDataStream::Ok; ++j)
+            scope->addOwnMethod(readMethod(stream));
+
+        stream >> count;
+        for (qint32 j = 0; j < count && stream.status() == QDataStream::Ok; ++j)
+            scope->addOwnEnumeration(readEnum(stream));
+
+        QList<QQmlJS::Export> exports;
+        stream >> count;
+        for (qint32 j = 0; j < count && stream.status() == QDataStream::Ok; ++j) {
+            QString package;
+            QString type;
+            stream >> package >> type;
+            const QTypeRevision version = readRevision(stream);
+            const QTypeRevision revision = readRevision(stream);
+            exports.append(QQmlJS::Export(package, type, version, revision));
+        }
+
+        result.objects.append({ scope, exports });
+    }
+
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    *entry = std::move(result);
+    return true;
+}
+
+bool QQmlJSImportCache::store(const QByteArray &hash, const Entry &entry) const
+{
+    if (!isEnabled() || !QDir().mkpath(m_directory))
+        return false;
+
+    // Several tools may populate the cache concurrently. QSaveFile makes sure
+    // readers only ever see complete entries.
+    QSaveFile file(entryPath(hash));
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << ImportCacheMagic << ImportCacheVersion << quint32(QT_VERSION);
+    stream << entry.dependencies << entry.warningMessage;
+
+    stream << qint32(entry.objects.size());
+    for (const QQmlJSExportedScope &object : entry.objects) {
+        const QQmlJSScope::ConstPtr scope = object.scope;
+        stream << scope->m_filePath << scope->m_internalName << scope->m_baseTypeNameOrError
+               << scope->m_defaultPropertyName << scope->m_parentPropertyName
+               << scope->m_attachedTypeName << scope->m_valueTypeName
+               << scope->m_extensionTypeName << scope->m_aliases << scope->m_interfaceNames
+               << scope->m_ownDeferredNames << scope->m_ownImmediateNames
+               << scope->m_requiredPropertyNames << quint32(scope->m_flags.toInt())
+               << quint8(scope->m_semantics);
+
+        stream << qint32(scope->m_properties.size());
+        for (const QQmlJSMetaProperty &property : scope->m_properties)
+            writeProperty(stream, property);
+
+        // QMultiHash iterates values of the same key from the most recently
+        // inserted one. Write them the other way around to restore the order.
+        stream << qint32(scope->m_methods.size());
+        const QStringList methodNames = scope->m_methods.uniqueKeys();
+        for (const QString &name : methodNames) {
+            const QList<QQmlJSMetaMethod> overloads = scope->m_methods.values(name);
+            for (auto method = overloads.crbegin(); method != overloads.crend(); ++method)
+                writeMethod(stream, *method);
+        }
+
+        stream << qint32(scope->m_enumerations.size());
+        for (const QQmlJSMetaEnum &metaEnum : scope->m_enumerations)
+            writeEnum(stream, metaEnum);
+
+        stream << qint32(object.exports.size());
+        for (const QQmlJS::Export &exported : object.exports) {
+            stream << exported.package() << exported.type();
+            writeRevision(stream, exported.version());
+            writeRevision(stream, exported.revision());
+        }
+    }
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+QT_END_NAMESPACE
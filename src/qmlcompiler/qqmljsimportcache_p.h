@@ -0,0 +1,67 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+#ifndef QQMLJSIMPORTCACHE_P_H
+#define QQMLJSIMPORTCACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+
+#include <qtqmlcompilerexports.h>
+
+#include "qqmljsscope_p.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+/*! \internal
+    An on-disk cache of parsed .qmltypes files, shared between all processes
+    that use the same cache directory. Entries are keyed by a hash of the
+    .qmltypes content, so that stale entries are never picked up and the same
+    file found under different import paths is only stored once. Reading an
+    entry skips lexing and parsing the type description.
+
+    Since entries are shared, they must not contain anything that depends on
+    where the .qmltypes file was found. The scopes' file paths are the C++
+    headers named in the content. Entries with warnings, which name the
+    .qmltypes file, are not stored.
+*/
+class Q_QMLCOMPILER_EXPORT QQmlJSImportCache
+{
+public:
+    struct Entry
+    {
+        QList<QQmlJSExportedScope> objects;
+        QStringList dependencies;
+        QString warningMessage;
+    };
+
+    QQmlJSImportCache() = default;
+    explicit QQmlJSImportCache(const QString &directory) : m_directory(directory) {}
+
+    bool isEnabled() const { return !m_directory.isEmpty(); }
+    QString directory() const { return m_directory; }
+
+    static QByteArray contentHash(const QByteArray &content);
+
+    bool load(const QByteArray &hash, Entry *entry) const;
+    bool store(const QByteArray &hash, const Entry &entry) const;
+
+private:
+    QString entryPath(const QByteArray &hash) const;
+
+    QString m_directory;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQMLJSIMPORTCACHE_P_H
@@ -91,13 +91,31 @@ void QQmlJSImporter::readQmltypes(const QString &filename, Import *result)
         return;
     }
 
-    QQmlJSTypeDescriptionReader reader { filename, QString::fromUtf8(file.readAll()) };
-    QStringList dependencyStrings;
-    auto succ = reader(&result->objects, &dependencyStrings);
-    if (!succ)
-        result->warnings.append({ reader.errorMessage(), QtCriticalMsg, QQmlJS::SourceLocation() });
+    const QByteArray content = file.readAll();
+    const QByteArray contentHash = m_importCache.isEnabled()
+            ? QQmlJSImportCache::contentHash(content)
+            : QByteArray();
+
+    QQmlJSImportCache::Entry cached;
+    if (!m_importCache.load(contentHash, &cached)) {
+        QQmlJSTypeDescriptionReader reader { filename, QString::fromUtf8(content) };
+        if (reader(&cached.objects, &cached.dependencies)) {
+            cached.warningMessage = reader.warningMessage();
+
+            // Entries are shared between all copies of the same content. The
+            // warnings name the file they were read from, so don't share them.
+            if (cached.warningMessage.isEmpty())
+                m_importCache.store(contentHash, cached);
+        } else {
+            result->warnings.append(
+                    { reader.errorMessage(), QtCriticalMsg, QQmlJS::SourceLocation() });
+            cached.warningMessage = reader.warningMessage();
+        }
+    }
 
-    const QString warningMessage = reader.warningMessage();
+    result->objects.append(std::move(cached.objects));
+    const QStringList dependencyStrings = std::move(cached.dependencies);
+    const QString warningMessage = cached.warningMessage;
     if (!warningMessage.isEmpty())
         result->warnings.append({ warningMessage, QtWarningMsg, QQmlJS::SourceLocation() });
 
@@ -166,6 +184,7 @@ QQmlJSImporter::QQmlJSImporter(const QStringList &importPaths, QQmlJSResourceFil
     : m_importPaths(importPaths),
       m_mapper(mapper),
       m_flags(flags),
+      m_importCache(qEnvironmentVariable("QT_QML_IMPORT_CACHE_DIR")),
       m_importVisitor([](QQmlJS::AST::Node *rootNode, QQmlJSImporter *self,
                          const ImportVisitorPrerequisites &p) {
           auto visitor = std::unique_ptr<QQmlJS::AST::BaseVisitor>(new QQmlJSImportVisitor(
@@ -17,6 +17,7 @@
 #include <qtqmlcompilerexports.h>
 
 #include "qqmljscontextualtypes_p.h"
+#include "qqmljsimportcache_p.h"
 #include "qqmljsscope_p.h"
 #include "qqmljsresourcefilemapper_p.h"
 #include <QtQml/private/qqmldirparser_p.h>
@@ -163,6 +164,14 @@ public:
 
     void clearCache();
 
+    // Directory for the on-disk cache of parsed .qmltypes files. Defaults to
+    // the QT_QML_IMPORT_CACHE_DIR environment variable; empty disables it.
+    QString importCacheDirectory() const { return m_importCache.directory(); }
+    void setImportCacheDirectory(const QString &directory)
+    {
+        m_importCache = QQmlJSImportCache(directory);
+    }
+
     QQmlJSScope::ConstPtr jsGlobalObject() const;
 
     struct ImportVisitorPrerequisites
@@ -269,6 +278,7 @@ private:
     QQmlJSResourceFileMapper *m_mapper = nullptr;
     QQmlJSResourceFileMapper *m_metaDataMapper = nullptr;
     QQmlJSImporterFlags m_flags;
+    QQmlJSImportCache m_importCache;
     bool useOptionalImports() const { return m_flags.testFlag(UseOptionalImports); };
     bool preferQmlFilesFromSourceFolder() const
     {
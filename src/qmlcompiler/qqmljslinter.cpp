@@ -511,6 +511,7 @@ QQmlJSLinter::LintResult QQmlJSLinter::lintFile(const QString &filename,
             m_logger->setFileName(m_useAbsolutePath ? info.absoluteFilePath() : filename);
             m_logger->setCode(code);
             m_logger->setSilent(silent || json);
+            m_logger->setOutputBuffer(m_outputBuffer);
             QQmlJSScope::Ptr target = QQmlJSScope::create();
             QQmlJSImportVisitor v { target, &m_importer, m_logger.get(),
                                     QQmlJSImportVisitor::implicitImportDirectory(
@@ -567,11 +568,16 @@ QQmlJSLinter::LintResult QQmlJSLinter::lintFile(const QString &filename,
                     std::make_unique<QQmlJSLiteralBindingCheck>(passMan.get()), QString(),
                     QString(), QString());
 
+            // The plugin passes run until the code generation below is done.
+            std::optional<QMutexLocker<QMutex>> pluginLock;
             if (m_enablePlugins) {
                 for (const Plugin &plugin : m_plugins) {
                     if (!plugin.isValid() || !plugin.isEnabled())
                         continue;
 
+                    if (m_pluginMutex && !pluginLock)
+                        pluginLock.emplace(m_pluginMutex);
+
                     QQmlSA::LintPlugin *instance = plugin.m_instance;
                     Q_ASSERT(instance);
                     instance->registerPasses(passMan.get(),
@@ -670,6 +676,7 @@ QQmlJSLinter::LintResult QQmlJSLinter::lintModule(
     m_logger->setFileName(module);
     m_logger->setCode(u""_s);
     m_logger->setSilent(silent || json);
+    m_logger->setOutputBuffer(m_outputBuffer);
 
     const QQmlJSImporter::ImportedTypes types = m_importer.importModule(module);
 
@@ -22,6 +22,7 @@
 #include <QtQml/private/qqmljssourcelocation_p.h>
 
 #include <QtCore/qjsonarray.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qscopedpointer.h>
@@ -131,6 +132,18 @@ public:
 
     void clearCache() { m_importer.clearCache(); }
 
+    void setImportCacheDirectory(const QString &directory)
+    {
+        m_importer.setImportCacheDirectory(directory);
+    }
+
+    // Collects the output of the following lint runs in buffer rather than writing it to stderr.
+    void setOutputBuffer(QString *buffer) { m_outputBuffer = buffer; }
+
+    // Plugin instances are shared by all linters in the process. Linters used on different
+    // threads must pass the same mutex here, so that only one of them runs plugin passes at a time.
+    void setPluginMutex(QMutex *mutex) { m_pluginMutex = mutex; }
+
 private:
     void parseComments(QQmlJSLogger *logger, const QList<QQmlJS::SourceLocation> &comments);
     void processMessages(QJsonArray &warnings);
@@ -140,6 +153,8 @@ private:
     QQmlJSImporter m_importer;
     QScopedPointer<QQmlJSLogger> m_logger;
     QString m_fileContents;
+    QString *m_outputBuffer = nullptr;
+    QMutex *m_pluginMutex = nullptr;
     std::vector<Plugin> m_plugins;
 };
 
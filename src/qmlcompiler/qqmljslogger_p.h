@@ -192,6 +192,8 @@ public:
     void setSilent(bool silent) { m_output.setSilent(silent); }
     bool isSilent() const { return m_output.isSilent(); }
 
+    void setOutputBuffer(QString *buffer) { m_output.setBuffer(buffer); }
+
     void setCode(const QString &code) { m_code = code; }
     QString code() const { return m_code; }
 
@@ -689,6 +689,7 @@ public:
     void setModuleName(const QString &moduleName) { m_moduleName = moduleName; }
 
 private:
+    friend class QQmlJSImportCache;
     friend class QDeferredSharedPointer<QQmlJSScope>;
     friend class QDeferredSharedPointer<const QQmlJSScope>;
     friend class QDeferredWeakPointer<QQmlJSScope>;
@@ -849,7 +849,7 @@ void QQmlJSTypePropagator::generate_StoreElement(int base, int index)
     // If we're writing to a list retrieved from a property, that _should_ have side effects,
     // but currently the QML engine doesn't implement them.
     // TODO: Figure out the above and accurately set the flag.
-    m_state.setHasSideEffects(true);
+    setListMutationSideEffects(baseRegister);
 }
 
 void QQmlJSTypePropagator::propagatePropertyLookup_SAcheck(const QString &propertyName)
@@ -1716,7 +1716,7 @@ bool QQmlJSTypePropagator::propagateArrayMethod(
         for (int i = 0; i < argc; ++i)
             addReadRegister(argv + i, intType);
 
-        m_state.setHasSideEffects(true);
+        setListMutationSideEffects(baseType);
         setReturnType(baseContained);
         return true;
     }
@@ -1735,7 +1735,7 @@ bool QQmlJSTypePropagator::propagateArrayMethod(
         for (int i = 1; i < argc; ++i)
             addReadRegister(argv + i, intType);
 
-        m_state.setHasSideEffects(true);
+        setListMutationSideEffects(baseType);
         setReturnType(baseContained);
         return true;
     }
@@ -1767,7 +1767,7 @@ bool QQmlJSTypePropagator::propagateArrayMethod(
     }
 
     if ((name == u"pop" || name == u"shift") && argc == 0) {
-        m_state.setHasSideEffects(true);
+        setListMutationSideEffects(baseType);
         setReturnType(valueContained);
         return true;
     }
@@ -1781,13 +1781,13 @@ bool QQmlJSTypePropagator::propagateArrayMethod(
         for (int i = 0; i < argc; ++i)
             addReadRegister(argv + i, valueType);
 
-        m_state.setHasSideEffects(true);
+        setListMutationSideEffects(baseType);
         setReturnType(m_typeResolver->int32Type());
         return true;
     }
 
     if (name == u"reverse" && argc == 0) {
-        m_state.setHasSideEffects(true);
+        setListMutationSideEffects(baseType);
         setReturnType(baseContained);
         return true;
     }
@@ -1824,7 +1824,7 @@ bool QQmlJSTypePropagator::propagateArrayMethod(
         for (int i = 2; i < argc; ++i)
             addReadRegister(argv + i, valueType);
 
-        m_state.setHasSideEffects(true);
+        setListMutationSideEffects(baseType);
         setReturnType(baseContained);
         return true;
     }
@@ -1847,6 +1847,17 @@ bool QQmlJSTypePropagator::propagateArrayMethod(
     return false;
 }
 
+void QQmlJSTypePropagator::setListMutationSideEffects(const QQmlJSRegisterContent &list)
+{
+    // Modifying an array created in this function can only be observed through the registers
+    // that hold the same array. Sequences from properties or arguments are unaffected. This keeps
+    // loops that read from an input list and push to a local one free of side effects.
+    if (State::isLocalList(list))
+        m_state.setHasLocalListSideEffects(m_function);
+    else
+        m_state.setHasSideEffects(true);
+}
+
 void QQmlJSTypePropagator::generate_CallPropertyLookup(int lookupIndex, int base, int argc,
                                                        int argv)
 {
@@ -2967,6 +2978,7 @@ void QQmlJSTypePropagator::endInstruction(QV4::Moth::Instr::Type instr)
     currentInstruction.changedRegisterIndex = m_state.changedRegisterIndex();
     currentInstruction.readRegisters = m_state.takeReadRegisters();
     currentInstruction.hasSideEffects = m_state.hasSideEffects();
+    currentInstruction.hasOnlyLocalListSideEffects = m_state.hasOnlyLocalListSideEffects();
     currentInstruction.isRename = m_state.isRename();
 
     bool populates = populatesAccumulator(instr);
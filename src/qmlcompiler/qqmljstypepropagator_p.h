@@ -220,6 +220,7 @@ private:
     bool propagateTranslationMethod(const QList<QQmlJSMetaMethod> &methods, int argc, int argv);
     void propagateStringArgCall(const QQmlJSRegisterContent &base, int argv);
     bool propagateArrayMethod(const QString &name, int argc, int argv, const QQmlJSRegisterContent &valueType);
+    void setListMutationSideEffects(const QQmlJSRegisterContent &list);
     void propagatePropertyLookup(
             const QString &name, int lookupIndex = QQmlJSRegisterContent::InvalidLookupIndex);
     void propagateScopeLookupCall(const QString &functionName, int argc, int argv);
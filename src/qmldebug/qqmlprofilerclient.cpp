@@ -89,6 +89,13 @@ void QQmlProfilerClientPrivate::processCurrentEvent()
         if (typeIndex == -1)
             break;
         currentEvent.event.setTypeIndex(typeIndex);
+        if (currentEvent.type.rangeType() == Binding) {
+            QQmlProfilerBindingStatistics &statistics = bindingStatistics[typeIndex];
+            ++statistics.evaluations;
+            statistics.dependencies += currentEvent.event.number<qint8>(1);
+            if (currentEvent.event.number<qint8>(2))
+                ++statistics.redundantEvaluations;
+        }
         while (!pendingMessages.isEmpty())
             forwardEvents(pendingMessages.dequeue());
         forwardEvents(currentEvent.event);
@@ -173,6 +180,7 @@ void QQmlProfilerClient::clearEvents()
     d->rangesInProgress.clear();
     d->pendingMessages.clear();
     d->pendingDebugMessages.clear();
+    d->bindingStatistics.clear();
     if (d->recordedFeatures != 0) {
         d->recordedFeatures = 0;
         emit recordedFeaturesChanged(0);
@@ -189,6 +197,17 @@ void QQmlProfilerClient::clearAll()
     clearEvents();
 }
 
+/*!
+    Returns the number of evaluations, redundant evaluations, and captured dependencies of all
+    bindings of the event type \a typeIndex received since the events were last cleared.
+    Evaluations are considered redundant if they produce the same value the binding wrote before.
+ */
+QQmlProfilerBindingStatistics QQmlProfilerClient::bindingStatistics(int typeIndex) const
+{
+    Q_D(const QQmlProfilerClient);
+    return d->bindingStatistics.value(typeIndex);
+}
+
 void QQmlProfilerClientPrivate::finalize()
 {
     while (!rangesInProgress.isEmpty()) {
@@ -24,6 +24,15 @@
 
 QT_BEGIN_NAMESPACE
 
+struct QQmlProfilerBindingStatistics
+{
+    qint64 evaluations = 0;
+    qint64 redundantEvaluations = 0;
+    qint64 dependencies = 0;
+};
+
+Q_DECLARE_TYPEINFO(QQmlProfilerBindingStatistics, Q_PRIMITIVE_TYPE);
+
 class QQmlProfilerClientPrivate;
 class QQmlProfilerClient : public QQmlDebugClient
 {
@@ -44,6 +53,8 @@ public:
     void clearEvents();
     void clearAll();
 
+    QQmlProfilerBindingStatistics bindingStatistics(int typeIndex) const;
+
     void sendRecordingStatus(int engineId = -1);
     void setRequestedFeatures(quint64 features);
     void setFlushInterval(quint32 flushInterval);
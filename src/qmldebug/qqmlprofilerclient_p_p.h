@@ -70,6 +70,7 @@ public:
     QStack<QQmlProfilerTypedEvent> rangesInProgress;
     QQueue<QQmlProfilerEvent> pendingMessages;
     QQueue<QQmlProfilerEvent> pendingDebugMessages;
+    QHash<int, QQmlProfilerBindingStatistics> bindingStatistics;
 
     QList<int> trackedEngines;
 };
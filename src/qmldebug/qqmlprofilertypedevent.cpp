@@ -172,6 +172,20 @@ QDataStream &operator>>(QDataStream &stream, QQmlProfilerTypedEvent &event)
     case RangeEnd: {
         event.type = QQmlProfilerEventType(MaximumMessage, rangeType, -1);
         event.event.setRangeStage(RangeEnd);
+        if (rangeType == Binding && !stream.atEnd()) {
+            qint32 numDependencies;
+            bool redundant;
+            stream >> numDependencies >> redundant;
+
+            // The statistics are stored next to the range stage, which has to stay 8bit. Larger
+            // dependency counts are saturated. Trailing zeroes can be omitted.
+            const qint8 dependencies = qint8(qBound(0, numDependencies,
+                                                    int(std::numeric_limits<qint8>::max())));
+            if (redundant)
+                event.event.setNumbers<qint8>({RangeEnd, dependencies, 1});
+            else if (dependencies != 0)
+                event.event.setNumbers<qint8>({RangeEnd, dependencies});
+        }
         break;
     }
     default:
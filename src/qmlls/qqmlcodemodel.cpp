@@ -6,6 +6,7 @@
 #include "qtextdocument_p.h"
 #include "qqmllsutils_p.h"
 
+#include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qthreadpool.h>
@@ -15,6 +16,7 @@
 #include <QtQmlDom/private/qqmldomtop_p.h>
 
 #include <memory>
+#include <optional>
 #include <algorithm>
 
 QT_BEGIN_NAMESPACE
@@ -75,10 +77,22 @@ do all locking needed, get some work, do it without locks, and at the end update
 code model. If there is more work, then they return true. Thus while (xxxSome()); works until there
 is no work left.
 
+While indexing, the identifiers used by each file are recorded in a QQmlLSIndex that is kept on
+disk between sessions.
+
 addDirectoriesToIndex(), the internal addDirectory() and addOpenToUpdate() add more work to do.
 
 indexNeedsUpdate() and openNeedUpdate(), check if there is work to do, and if yes ensure that a
 worker thread (or more) that work on it exist.
+
+Indexing is split into directories, which are cheap to scan, and files, which are expensive
+to load. Scanning a directory queues its files, and several workers then load batches of files from
+the same directory concurrently, each batch into its own copy of the current environment. One
+thread of the pool is left to the OpenDocumentUpdate, which is also started with a higher priority,
+so that open documents stay responsive while the workspace is indexed. Directories of open
+documents are indexed first, as their files are the most likely to be imported by them. Open
+documents themselves are not indexed, as their in-memory version is newer than the one on disk, and
+files of removed directories are dropped even if they are already being loaded.
 */
 
 QQmlCodeModel::QQmlCodeModel(QObject *parent, QQmlToolingSettings *settings)
@@ -119,12 +133,17 @@ QQmlCodeModel::~QQmlCodeModel()
             QMutexLocker l(&m_mutex);
             m_state = State::Stopping;
             m_openDocumentsToUpdate.clear();
+            m_toIndex.clear();
+            m_filesToIndex.clear();
+            m_directoriesToIndex.clear();
+            m_nFilesToIndex = 0;
             shouldWait = m_nIndexInProgress != 0 || m_nUpdateInProgress != 0;
         }
         if (!shouldWait)
             break;
         QThread::yieldCurrentThread();
     }
+    m_index.save();
 }
 
 OpenDocumentSnapshot QQmlCodeModel::snapshotByUrl(const QByteArray &url)
@@ -139,6 +158,7 @@ int QQmlCodeModel::indexEvalProgress() const
     int costToDo = 1;
     for (const ToIndex &el : std::as_const(m_toIndex))
         costToDo += dirCost * el.leftDepth;
+    costToDo += m_nFilesToIndex;
     costToDo += m_indexInProgressCost;
     return m_indexDoneCost * 100 / (costToDo + m_indexDoneCost);
 }
@@ -156,18 +176,43 @@ void QQmlCodeModel::indexEnd()
     m_lastIndexProgress = 0;
     m_nIndexInProgress = 0;
     m_toIndex.clear();
+    m_filesToIndex.clear();
+    m_directoriesToIndex.clear();
+    m_nFilesToIndex = 0;
+    m_filesIndexing.clear();
     m_indexInProgressCost = 0;
     m_indexDoneCost = 0;
+    // keep the index of this session for the next start
+    m_index.save();
 }
 
 void QQmlCodeModel::indexSendProgress(int progress)
 {
-    if (progress <= m_lastIndexProgress)
-        return;
-    m_lastIndexProgress = progress;
+    {
+        QMutexLocker l(&m_mutex);
+        if (progress <= m_lastIndexProgress)
+            return;
+        m_lastIndexProgress = progress;
+    }
     // ### actually send progress
 }
 
+// Paths of files to index are compared with the canonical paths of open documents.
+static QString canonicalPath(const QString &path)
+{
+    const QString canonical = QFileInfo(path).canonicalFilePath();
+    return canonical.isEmpty() ? QDir::cleanPath(path) : canonical;
+}
+
+// Files of the same directory are loaded together, into the same copy of the environment. Large
+// directories are split into several batches, so that they can be loaded in parallel.
+static constexpr qsizetype maxFilesPerBatch = 16;
+
+static QString directoryOf(const QString &canonicalFilePath)
+{
+    return QFileInfo(canonicalFilePath).path();
+}
+
 bool QQmlCodeModel::indexCancelled()
 {
     QMutexLocker l(&m_mutex);
@@ -189,45 +234,126 @@ void QQmlCodeModel::indexDirectory(const QString &path, int depthLeft)
     }
     const QStringList qmljs =
             dir.entryList(QStringList({ u"*.qml"_s, u"*.js"_s, u"*.mjs"_s }), QDir::Files);
+    QStringList files;
+    files.reserve(qmljs.size());
+    for (const QString &file : qmljs)
+        files.append(canonicalPath(dir.filePath(file)));
     int progress = 0;
     {
         QMutexLocker l(&m_mutex);
-        m_indexInProgressCost += qmljs.size();
+        if (!files.isEmpty()) {
+            const QString directory = directoryOf(files.first());
+            QStringList &queued = m_filesToIndex[directory];
+            if (queued.isEmpty())
+                m_directoriesToIndex.append(directory);
+            queued.append(files);
+            m_nFilesToIndex += files.size();
+        }
         progress = indexEvalProgress();
     }
     indexSendProgress(progress);
-    if (qmljs.isEmpty())
+
+    // the files found can be loaded by other workers in parallel
+    indexNeedsUpdate();
+}
+
+void QQmlCodeModel::indexFiles(const QString &directory, const QStringList &paths)
+{
+    if (indexCancelled())
         return;
-    DomItem newCurrent = m_currentEnv.makeCopy(DomItem::CopyOption::EnvConnected).item();
-    for (const QString &file : qmljs) {
-        if (indexCancelled())
-            return;
-        QString fPath = dir.filePath(file);
-        auto newCurrentPtr = newCurrent.ownerAs<DomEnvironment>();
-        FileToLoad fileToLoad = FileToLoad::fromFileSystem(newCurrentPtr, fPath);
-        if (!fileToLoad.canonicalPath().isEmpty()) {
-            newCurrentPtr->loadBuiltins();
-            newCurrentPtr->loadFile(fileToLoad, [](Path, const DomItem &, const DomItem &) {});
-            newCurrentPtr->loadPendingDependencies();
-            newCurrent.commitToBase(m_validEnv.ownerAs<DomEnvironment>());
-        }
+    {
+        QMutexLocker l(&m_mutex);
+        m_indexInProgressCost += paths.size();
+    }
+    auto guard = qScopeGuard([this, &paths]() {
+        int progress = 0;
         {
             QMutexLocker l(&m_mutex);
-            ++m_indexDoneCost;
-            --m_indexInProgressCost;
+            for (const QString &path : paths)
+                m_filesIndexing.remove(path);
+            m_indexInProgressCost -= paths.size();
+            m_indexDoneCost += paths.size();
             progress = indexEvalProgress();
         }
         indexSendProgress(progress);
+    });
+
+    // The files share one copy of the environment, so that the builtins and their common
+    // dependencies are only loaded once.
+    DomItem newCurrent = m_currentEnv.makeCopy(DomItem::CopyOption::EnvConnected).item();
+    auto newCurrentPtr = newCurrent.ownerAs<DomEnvironment>();
+    newCurrentPtr->loadBuiltins();
+
+    struct LoadedFile
+    {
+        QString path;
+        QString canonicalPath;
+        std::optional<QString> code;
+    };
+    QList<LoadedFile> loaded;
+    loaded.reserve(paths.size());
+    for (const QString &path : paths) {
+        if (indexCancelled())
+            return;
+        FileToLoad fileToLoad = FileToLoad::fromFileSystem(newCurrentPtr, path);
+        if (fileToLoad.canonicalPath().isEmpty())
+            continue;
+        newCurrentPtr->loadFile(fileToLoad, [](Path, const DomItem &, const DomItem &) {});
+        LoadedFile file{ path, fileToLoad.canonicalPath(), std::nullopt };
+        if (QFile f(file.canonicalPath); f.open(QIODevice::ReadOnly))
+            file.code = QString::fromUtf8(f.readAll());
+        loaded.append(std::move(file));
+    }
+    newCurrentPtr->loadPendingDependencies();
+
+    // The directory might have been removed, or some of the files opened, in the meantime. Keep
+    // the lock while committing, so that this can't happen between the check and the commit.
+    QMutexLocker l(&m_mutex);
+    if (m_state == State::Stopping)
+        return;
+    QStringList stillIndexing;
+    for (const LoadedFile &file : std::as_const(loaded)) {
+        if (!m_filesIndexing.contains(file.path))
+            continue;
+        stillIndexing.append(file.path);
+        if (file.code)
+            m_index.update(file.canonicalPath, *file.code);
+    }
+    if (stillIndexing.size() == loaded.size()) {
+        newCurrent.commitToBase(m_validEnv.ownerAs<DomEnvironment>());
+    } else if (!stillIndexing.isEmpty()) {
+        // The environment contains stale versions of the files that were dropped. Load the
+        // others again, without them.
+        QStringList &queued = m_filesToIndex[directory];
+        if (queued.isEmpty())
+            m_directoriesToIndex.append(directory);
+        queued.append(stillIndexing);
+        m_nFilesToIndex += stillIndexing.size();
     }
 }
 
+/*!
+\internal
+Sets the file where the index of the workspace is kept between sessions, and loads it. By default,
+a file specific to the first directories added to the index is used in the cache location.
+Passing an empty \a cacheFile disables the persistence.
+*/
+void QQmlCodeModel::setIndexCacheFile(const QString &cacheFile)
+{
+    m_indexCacheFileSet = true;
+    m_index.setCacheFile(cacheFile);
+    m_index.load();
+}
+
 void QQmlCodeModel::addDirectoriesToIndex(const QStringList &paths, QLanguageServer *server)
 {
     Q_UNUSED(server);
+    if (!m_indexCacheFileSet)
+        setIndexCacheFile(QQmlLSIndex::defaultCacheFile(paths));
     // ### create progress, &scan in a separate instance
     const int maxDepth = 5;
     for (const auto &path : paths)
-        addDirectory(path, maxDepth);
+        addDirectory(canonicalPath(path), maxDepth);
     indexNeedsUpdate();
 }
 
@@ -253,8 +379,9 @@ void QQmlCodeModel::addDirectory(const QString &path, int depthLeft)
     }
 }
 
-void QQmlCodeModel::removeDirectory(const QString &path)
+void QQmlCodeModel::removeDirectory(const QString &directory)
 {
+    const QString path = canonicalPath(directory);
     {
         QMutexLocker l(&m_mutex);
         auto toRemove = [path](const QString &p) {
@@ -268,7 +395,18 @@ void QQmlCodeModel::removeDirectory(const QString &path)
             else
                 ++it;
         }
+        for (auto it = m_filesToIndex.begin(); it != m_filesToIndex.end();) {
+            if (toRemove(it.key())) {
+                m_nFilesToIndex -= it->size();
+                it = m_filesToIndex.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        // files that are currently loaded won't be committed anymore
+        m_filesIndexing.removeIf(toRemove);
     }
+    m_index.removePath(path);
     if (auto validEnvPtr = m_validEnv.ownerAs<DomEnvironment>())
         validEnvPtr->removePath(path);
     if (auto currentEnvPtr = m_currentEnv.ownerAs<DomEnvironment>())
@@ -310,6 +448,23 @@ void QQmlCodeModel::newOpenFile(const QByteArray &url, int version, const QStrin
         openDoc.textDocument->setVersion(version);
         openDoc.textDocument->setPlainText(docText);
     }
+    {
+        // the open document will be loaded from docText, drop stale indexing work for it
+        const QString path = url2Path(url);
+        const QString directory = directoryOf(path);
+        QMutexLocker l(&m_mutex);
+        if (!m_openDocumentDirectories.contains(url)) {
+            m_openDocumentDirectories.insert(url, directory);
+            ++m_openDirectories[directory];
+        }
+        const auto queued = m_filesToIndex.find(directory);
+        if (queued != m_filesToIndex.end()) {
+            m_nFilesToIndex -= queued->removeAll(path);
+            if (queued->isEmpty())
+                m_filesToIndex.erase(queued);
+        }
+        m_filesIndexing.remove(path);
+    }
     addOpenToUpdate(url);
     openNeedUpdate();
 }
@@ -334,38 +489,89 @@ const RegisteredSemanticTokens &QQmlCodeModel::registeredTokens() const
 
 void QQmlCodeModel::indexNeedsUpdate()
 {
-    const int maxIndexThreads = 1;
+    // leave one thread for the updates of the open documents
+    const int maxIndexThreads = std::max(1, QThreadPool::globalInstance()->maxThreadCount() - 1);
+    int newThreads = 0;
     {
         QMutexLocker l(&m_mutex);
-        if (m_toIndex.isEmpty() || m_nIndexInProgress >= maxIndexThreads)
+        const int work = m_toIndex.size()
+                + int((m_nFilesToIndex + maxFilesPerBatch - 1) / maxFilesPerBatch);
+        newThreads = std::min(work, maxIndexThreads - m_nIndexInProgress);
+        if (newThreads <= 0)
             return;
-        if (++m_nIndexInProgress == 1)
+        if (m_nIndexInProgress == 0)
             indexStart();
+        m_nIndexInProgress += newThreads;
+    }
+    for (int i = 0; i < newThreads; ++i) {
+        QThreadPool::globalInstance()->start([this]() {
+            while (indexSome()) { }
+        });
     }
-    QThreadPool::globalInstance()->start([this]() {
-        while (indexSome()) { }
-    });
 }
 
 bool QQmlCodeModel::indexSome()
 {
     qCDebug(codeModelLog) << "indexSome";
     ToIndex toIndex;
+    QString directory;
+    QStringList filesToIndex;
     {
         QMutexLocker l(&m_mutex);
-        if (m_toIndex.isEmpty()) {
+        if (m_toIndex.isEmpty() && m_filesToIndex.isEmpty()) {
             if (--m_nIndexInProgress == 0)
                 indexEnd();
             return false;
         }
-        toIndex = m_toIndex.last();
-        m_toIndex.removeLast();
+        if (!m_toIndex.isEmpty()) {
+            // scanning directories is cheap and finds more work for the other workers
+            toIndex = m_toIndex.last();
+            m_toIndex.removeLast();
+        } else {
+            // prefer the directories of open documents, their files are likely imported by them
+            for (auto it = m_openDirectories.cbegin(), end = m_openDirectories.cend(); it != end;
+                 ++it) {
+                if (m_filesToIndex.contains(it.key())) {
+                    directory = it.key();
+                    break;
+                }
+            }
+            // directories that were emptied or removed in the meantime are skipped here
+            const bool fromStack = directory.isEmpty();
+            while (directory.isEmpty()) {
+                Q_ASSERT(!m_directoriesToIndex.isEmpty());
+                QString candidate = m_directoriesToIndex.takeLast();
+                if (m_filesToIndex.contains(candidate))
+                    directory = std::move(candidate);
+            }
+
+            const auto queued = m_filesToIndex.find(directory);
+            const qsizetype batchSize = std::min(queued->size(), maxFilesPerBatch);
+            filesToIndex = queued->sliced(queued->size() - batchSize);
+            queued->resize(queued->size() - batchSize);
+            m_nFilesToIndex -= batchSize;
+            if (queued->isEmpty())
+                m_filesToIndex.erase(queued);
+            else if (fromStack)
+                m_directoriesToIndex.append(directory);
+
+            // open documents are kept up to date by openUpdate() from their newer text
+            filesToIndex.removeIf([this](const QString &path) {
+                const auto url = m_path2url.constFind(path);
+                if (url == m_path2url.cend())
+                    return false;
+                const auto doc = m_openDocuments.constFind(*url);
+                return doc != m_openDocuments.cend() && doc->textDocument;
+            });
+            for (const QString &path : std::as_const(filesToIndex))
+                m_filesIndexing.insert(path);
+        }
     }
     bool hasMore = false;
     {
         auto guard = qScopeGuard([this, &hasMore]() {
             QMutexLocker l(&m_mutex);
-            if (m_toIndex.isEmpty()) {
+            if (m_toIndex.isEmpty() && m_filesToIndex.isEmpty()) {
                 if (--m_nIndexInProgress == 0)
                     indexEnd();
                 hasMore = false;
@@ -373,7 +579,10 @@ bool QQmlCodeModel::indexSome()
                 hasMore = true;
             }
         });
-        indexDirectory(toIndex.path, toIndex.leftDepth);
+        if (!toIndex.path.isEmpty())
+            indexDirectory(toIndex.path, toIndex.leftDepth);
+        else if (!filesToIndex.isEmpty())
+            indexFiles(directory, filesToIndex);
     }
     return hasMore;
 }
@@ -389,9 +598,11 @@ void QQmlCodeModel::openNeedUpdate()
         if (++m_nUpdateInProgress == 1)
             openUpdateStart();
     }
+    // jump ahead of queued indexing work: the user is waiting for this
+    const int openUpdatePriority = 1;
     QThreadPool::globalInstance()->start([this]() {
         while (openUpdateSome()) { }
-    });
+    }, openUpdatePriority);
 }
 
 bool QQmlCodeModel::openUpdateSome()
@@ -616,11 +827,56 @@ void QQmlCodeModel::onCppFileChanged(const QString &)
     m_rebuildRequired = true;
 }
 
+/*!
+\internal
+Many document versions don't change the text at all: undoing the last change, or edits that cancel
+each other out before the update could start. Parsing and building the Dom again would give exactly
+the current snapshot, so only move its version forward.
+
+This is the only case where parsing is skipped: any other edit reparses the whole document and
+builds its Dom again. The generated parser cannot resume in the middle of a document, and Dom items
+hold absolute source locations and the semantic scopes of the whole file, so unchanged parts of the
+previous snapshot cannot be reused.
+
+newDocForOpenFile() doesn't take this shortcut while a CMake rebuild is pending: the full update
+triggers the rebuild and resolves the dependencies of the document again against its output.
+
+Returns true if the snapshot of \a url was updated to \a version without reparsing.
+*/
+bool QQmlCodeModel::updateVersionOfUnchangedDoc(const QByteArray &url, int version,
+                                                const QString &docText)
+{
+    QMutexLocker l(&m_mutex);
+    const auto it = m_openDocuments.find(url);
+    if (it == m_openDocuments.end() || !it->textDocument)
+        return false;
+
+    OpenDocumentSnapshot &snapshot = it->snapshot;
+    if (!snapshot.doc || !snapshot.docVersion || *snapshot.docVersion >= version)
+        return false;
+    if (snapshot.doc.field(Fields::code).value().toString() != docText)
+        return false;
+
+    qCDebug(codeModelLog) << "text of" << url << "is unchanged in version" << version;
+    if (snapshot.validDocVersion && *snapshot.validDocVersion == *snapshot.docVersion)
+        snapshot.validDocVersion = version;
+    snapshot.docVersion = version;
+    return true;
+}
+
 void QQmlCodeModel::newDocForOpenFile(const QByteArray &url, int version, const QString &docText)
 {
     qCDebug(codeModelLog) << "updating doc" << url << "to version" << version << "("
                           << docText.size() << "chars)";
 
+    // the pending CMake rebuild is only triggered by the full update below
+    const bool rebuildPending = m_cmakeStatus == HasCMake && m_rebuildRequired
+            && !buildPathsForFileUrl(url).isEmpty();
+    if (!rebuildPending && updateVersionOfUnchangedDoc(url, version, docText)) {
+        emit updatedSnapshot(url);
+        return;
+    }
+
     const QString fPath = url2Path(url, UrlLookup::ForceLookup);
     if (m_cmakeStatus == RequiresInitialization)
         initializeCMakeStatus(fPath);
@@ -647,6 +903,8 @@ void QQmlCodeModel::newDocForOpenFile(const QByteArray &url, int version, const
             setDocumentationRootPath(m_settings->value(docDir).toString());
     }
 
+    m_index.update(fPath, docText);
+
     Path p;
     auto newCurrentPtr = newCurrent.ownerAs<DomEnvironment>();
     newCurrentPtr->loadFile(FileToLoad::fromMemory(newCurrentPtr, fPath, docText),
@@ -712,6 +970,13 @@ void QQmlCodeModel::closeOpenFile(const QByteArray &url)
 {
     QMutexLocker l(&m_mutex);
     m_openDocuments.remove(url);
+    const QString directory = m_openDocumentDirectories.take(url);
+    if (!directory.isNull()) {
+        const auto it = m_openDirectories.find(directory);
+        Q_ASSERT(it != m_openDirectories.end());
+        if (--*it == 0)
+            m_openDirectories.erase(it);
+    }
 }
 
 void QQmlCodeModel::setRootUrls(const QList<QByteArray> &urls)
@@ -16,6 +16,7 @@
 //
 
 #include "qlanguageserver_p.h"
+#include "qqmllsindex_p.h"
 #include "qtextdocument_p.h"
 
 #include <QObject>
@@ -124,12 +125,16 @@ public:
 
     QSet<QString> ignoreForWatching() const { return m_ignoreForWatching; }
 
+    const QQmlLSIndex &index() const { return m_index; }
+    void setIndexCacheFile(const QString &cacheFile);
+
 Q_SIGNALS:
     void updatedSnapshot(const QByteArray &url);
     void documentationRootPathChanged(const QString &path);
 
 private:
     void indexDirectory(const QString &path, int depthLeft);
+    void indexFiles(const QString &directory, const QStringList &paths);
     int indexEvalProgress() const; // to be called in the mutex
     void indexStart(); // to be called in the mutex
     void indexEnd(); // to be called in the mutex
@@ -141,6 +146,7 @@ private:
     void openUpdateStart();
     void openUpdateEnd();
     void openUpdate(const QByteArray &);
+    bool updateVersionOfUnchangedDoc(const QByteArray &url, int version, const QString &docText);
 
     static bool callCMakeBuild(const QStringList &buildPaths);
     void addFileWatches(const QQmlJS::Dom::DomItem &qmlFile);
@@ -152,6 +158,12 @@ private:
     int m_lastIndexProgress = 0;
     int m_nIndexInProgress = 0;
     QList<ToIndex> m_toIndex;
+    // Files to index, by directory, and the order in which the directories were queued. The
+    // latter may contain directories that have been indexed or removed already.
+    QHash<QString, QStringList> m_filesToIndex;
+    QStringList m_directoriesToIndex;
+    qsizetype m_nFilesToIndex = 0;
+    QSet<QString> m_filesIndexing;
     int m_indexInProgressCost = 0;
     int m_indexDoneCost = 0;
     int m_nUpdateInProgress = 0;
@@ -165,6 +177,9 @@ private:
     QHash<QByteArray, QString> m_url2path;
     QHash<QString, QByteArray> m_path2url;
     QHash<QByteArray, OpenDocument> m_openDocuments;
+    // The directories of the open documents, and how many documents are open in each
+    QHash<QByteArray, QString> m_openDocumentDirectories;
+    QHash<QString, int> m_openDirectories;
     QQmlToolingSettings *m_settings;
     QFileSystemWatcher m_cppFileWatcher;
     QFactoryLoader m_pluginLoader;
@@ -173,6 +188,8 @@ private:
     RegisteredSemanticTokens m_tokens;
     QString m_documentationRootPath;
     QSet<QString> m_ignoreForWatching;
+    QQmlLSIndex m_index;
+    bool m_indexCacheFileSet = false;
 private slots:
     void onCppFileChanged(const QString &);
 };
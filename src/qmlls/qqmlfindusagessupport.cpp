@@ -47,7 +47,7 @@ void QQmlFindUsagesSupport::process(QQmlFindUsagesSupport::RequestPointerArgumen
     QQmlLSUtils::ItemLocation &front =
             std::get<QList<QQmlLSUtils::ItemLocation>>(itemsFound).front();
 
-    auto usages = QQmlLSUtils::findUsagesOf(front.domItem);
+    auto usages = QQmlLSUtils::findUsagesOf(front.domItem, &m_codeModel->index());
 
     QQmlJS::Dom::DomItem files = front.domItem.top().field(QQmlJS::Dom::Fields::qmlFileWithPath);
 
@@ -0,0 +1,315 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qqmllsindex_p.h"
+
+#include <QtQml/private/qqmljsengine_p.h>
+#include <QtQml/private/qqmljslexer_p.h>
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qstandardpaths.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace QmlLsp {
+
+using namespace Qt::StringLiterals;
+
+// Bump this whenever the serialization below, or what identifiersOf() records, changes.
+static constexpr quint32 IndexMagic = 0x716c7369; // "qlsi"
+static constexpr quint32 IndexVersion = 3;
+
+/*!
+\internal
+\class QQmlLSIndex
+
+Remembers which identifiers are used in each file of the workspace. Find usages and rename use it
+to skip files that cannot contain a usage, instead of visiting the Dom of every file.
+
+The index is kept on disk between sessions. Each entry stores a hash of the file content it was
+built from, so that entries of modified files are recomputed instead of being trusted. Entries
+loaded from disk are only used once update() confirmed that the file still has that content, until
+then their file is always considered.
+
+Identifiers are collected with the lexer only, which is much cheaper than building the Dom. This
+over-approximates the usages, which is fine: false positives are filtered out by the Dom visit
+anyway. The values of string literals are recorded as well, as they can name properties. Files that
+could not be lexed completely are always considered, and so are files where a regular
+expression literal cannot be told apart from a division without parsing.
+*/
+
+QString QQmlLSIndex::cacheFile() const
+{
+    QMutexLocker l(&m_mutex);
+    return m_cacheFile;
+}
+
+void QQmlLSIndex::setCacheFile(const QString &cacheFile)
+{
+    QMutexLocker l(&m_mutex);
+    m_cacheFile = cacheFile;
+}
+
+/*!
+\internal
+Returns a cache file that is specific to the workspace consisting of \a rootPaths.
+*/
+QString QQmlLSIndex::defaultCacheFile(const QStringList &rootPaths)
+{
+    const QString cacheLocation =
+            QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation);
+    if (cacheLocation.isEmpty())
+        return QString();
+
+    QStringList sortedPaths = rootPaths;
+    sortedPaths.sort();
+    const QByteArray key = QCryptographicHash::hash(sortedPaths.join(u'\n').toUtf8(),
+                                                    QCryptographicHash::Sha1).toHex();
+    return cacheLocation + u"/qmlls/"_s + QString::fromLatin1(key) + u".qmllsindex"_s;
+}
+
+bool QQmlLSIndex::load()
+{
+    const QString path = cacheFile();
+    if (path.isEmpty())
+        return false;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic;
+    quint32 version;
+    quint32 qtVersion;
+    stream >> magic >> version >> qtVersion;
+    if (magic != IndexMagic || version != IndexVersion || qtVersion != QT_VERSION)
+        return false;
+
+    QHash<QString, Entry> entries;
+    qint32 count;
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        QString filePath;
+        Entry entry;
+        stream >> filePath >> entry.hash >> entry.identifiers >> entry.complete;
+        entries.insert(filePath, std::move(entry));
+    }
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    QMutexLocker l(&m_mutex);
+    // entries computed in this session are newer than the ones on disk
+    entries.insert(m_entries);
+    m_entries = std::move(entries);
+    return true;
+}
+
+bool QQmlLSIndex::save()
+{
+    QHash<QString, Entry> entries;
+    QString path;
+    {
+        QMutexLocker l(&m_mutex);
+        if (!m_dirty || m_cacheFile.isEmpty())
+            return false;
+        entries = m_entries;
+        path = m_cacheFile;
+        m_dirty = false;
+    }
+
+    if (!QDir().mkpath(QFileInfo(path).path()))
+        return false;
+
+    // QSaveFile makes sure that a concurrently starting qmlls never sees a partial index
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << IndexMagic << IndexVersion << quint32(QT_VERSION);
+    stream << qint32(entries.size());
+    for (auto it = entries.cbegin(), end = entries.cend(); it != end; ++it)
+        stream << it.key() << it->hash << it->identifiers << it->complete;
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+/*!
+\internal
+Updates the entry of \a filePath from its content \a code. Lexing is skipped if the content did not
+change since the entry was computed, possibly in an earlier session.
+*/
+void QQmlLSIndex::update(const QString &filePath, const QString &code)
+{
+    const QByteArray hash = QCryptographicHash::hash(code.toUtf8(), QCryptographicHash::Sha1);
+    {
+        QMutexLocker l(&m_mutex);
+        const auto it = m_entries.find(filePath);
+        if (it != m_entries.end() && it->hash == hash) {
+            it->validated = true;
+            return;
+        }
+    }
+
+    Entry entry;
+    entry.hash = hash;
+    entry.identifiers = identifiersOf(code, &entry.complete);
+    entry.validated = true;
+
+    QMutexLocker l(&m_mutex);
+    m_entries.insert(filePath, std::move(entry));
+    m_dirty = true;
+}
+
+void QQmlLSIndex::removePath(const QString &path)
+{
+    QMutexLocker l(&m_mutex);
+    const qsizetype removed = m_entries.removeIf([&path](QHash<QString, Entry>::iterator it) {
+        const QString &p = it.key();
+        return p.startsWith(path) && (p.size() == path.size() || p.at(path.size()) == u'/');
+    });
+    if (removed > 0)
+        m_dirty = true;
+}
+
+/*!
+\internal
+Returns false if \a filePath certainly does not use any of \a names. Entries that were loaded
+from disk but not yet checked against the current content of their file by update() are not
+trusted.
+*/
+bool QQmlLSIndex::mightUse(const QString &filePath, const QStringList &names) const
+{
+    QMutexLocker l(&m_mutex);
+    const auto it = m_entries.constFind(filePath);
+    if (it == m_entries.constEnd() || !it->complete || !it->validated)
+        return true;
+    for (const QString &name : names) {
+        if (it->identifiers.contains(name))
+            return true;
+    }
+    return false;
+}
+
+std::optional<QQmlLSIndex::Entry> QQmlLSIndex::entry(const QString &filePath) const
+{
+    QMutexLocker l(&m_mutex);
+    const auto it = m_entries.constFind(filePath);
+    if (it == m_entries.constEnd())
+        return {};
+    return *it;
+}
+
+enum class SlashKind { Division, RegExp, Ambiguous };
+
+// Without the parser, only the token before a '/' tells whether it starts a regular expression
+// literal or is a division.
+static SlashKind slashKindAfter(int token, QStringView text)
+{
+    using namespace QQmlJS;
+    switch (token) {
+    case Lexer::T_RPAREN: // "(a) / b" or "if (a) /b/.exec(c)"
+    case Lexer::T_RBRACE: // "({}) / b" or "{} /b/.exec(c)"
+        return SlashKind::Ambiguous;
+    case Lexer::T_RBRACKET:
+    case Lexer::T_IDENTIFIER:
+    case Lexer::T_NUMERIC_LITERAL:
+    case Lexer::T_STRING_LITERAL:
+    case Lexer::T_MULTILINE_STRING_LITERAL:
+    case Lexer::T_NO_SUBSTITUTION_TEMPLATE:
+    case Lexer::T_TEMPLATE_TAIL:
+    case Lexer::T_PLUS_PLUS:
+    case Lexer::T_MINUS_MINUS:
+    case Lexer::T_THIS:
+    case Lexer::T_SUPER:
+    case Lexer::T_NULL:
+    case Lexer::T_TRUE:
+    case Lexer::T_FALSE:
+        return SlashKind::Division;
+    case Lexer::T_RETURN:
+    case Lexer::T_TYPEOF:
+    case Lexer::T_INSTANCEOF:
+    case Lexer::T_IN:
+    case Lexer::T_NEW:
+    case Lexer::T_DELETE:
+    case Lexer::T_VOID:
+    case Lexer::T_THROW:
+    case Lexer::T_CASE:
+    case Lexer::T_DO:
+    case Lexer::T_ELSE:
+        return SlashKind::RegExp;
+    default:
+        break;
+    }
+    // other keywords can be used as identifiers in QML, like "property" or "from"
+    return !text.isEmpty() && text.front().isLetter() ? SlashKind::Ambiguous : SlashKind::RegExp;
+}
+
+QSet<QString> QQmlLSIndex::identifiersOf(const QString &code, bool *complete)
+{
+    QSet<QString> result;
+    QQmlJS::Engine engine;
+    QQmlJS::Lexer lexer(&engine);
+    lexer.setCode(code, 1, /* qmlMode = */ true);
+
+    *complete = true;
+    SlashKind slash = SlashKind::RegExp;
+    for (int token = lexer.lex(); token != QQmlJS::Lexer::EOF_SYMBOL; token = lexer.lex()) {
+        if (token == QQmlJS::Lexer::T_ERROR) {
+            *complete = false;
+            break;
+        }
+
+        if (token == QQmlJS::Lexer::T_DIVIDE_ || token == QQmlJS::Lexer::T_DIVIDE_EQ) {
+            if (slash == SlashKind::RegExp) {
+                // the body of a regular expression like /'/ must not be lexed as tokens
+                if (!lexer.scanRegExp(token == QQmlJS::Lexer::T_DIVIDE_EQ
+                                              ? QQmlJS::Lexer::EqualPrefix
+                                              : QQmlJS::Lexer::NoPrefix)) {
+                    *complete = false;
+                    break;
+                }
+                slash = SlashKind::Division;
+                continue;
+            }
+            if (slash == SlashKind::Ambiguous) {
+                // Lexing a regular expression as a division only goes wrong if its body starts
+                // a string, a template or a comment, which could hide the identifiers after it.
+                QStringView rest =
+                        QStringView(code).mid(lexer.tokenOffset() + lexer.tokenLength());
+                rest = rest.left(rest.indexOf(u'\n'));
+                if (rest.contains(u'\'') || rest.contains(u'"') || rest.contains(u'`')
+                    || rest.contains(u'/')) {
+                    *complete = false;
+                    break;
+                }
+            }
+        }
+        // keywords can be used as property names in QML, so keep them as well
+        const QStringView text = QStringView(code).mid(lexer.tokenOffset(), lexer.tokenLength());
+        slash = slashKindAfter(token, text);
+        if (!text.isEmpty()
+            && (text.front().isLetter() || text.front() == u'_' || text.front() == u'$')) {
+            result.insert(text.toString());
+        } else if (token == QQmlJS::Lexer::T_STRING_LITERAL
+                   || token == QQmlJS::Lexer::T_MULTILINE_STRING_LITERAL) {
+            // properties can be named by strings, like in Binding { property: "foo" }
+            if (const QStringView value = lexer.tokenSpell(); !value.isEmpty())
+                result.insert(value.toString());
+        }
+    }
+    return result;
+}
+
+} // namespace QmlLsp
+
+QT_END_NAMESPACE
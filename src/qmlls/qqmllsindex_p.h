@@ -0,0 +1,68 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQMLLSINDEX_P_H
+#define QQMLLSINDEX_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+namespace QmlLsp {
+
+class QQmlLSIndex
+{
+public:
+    struct Entry
+    {
+        QByteArray hash;
+        QSet<QString> identifiers;
+        bool complete = false;
+        // not stored on disk: whether the hash was compared to the content of the file
+        bool validated = false;
+    };
+
+    QString cacheFile() const;
+    void setCacheFile(const QString &cacheFile);
+    static QString defaultCacheFile(const QStringList &rootPaths);
+
+    bool load();
+    bool save();
+
+    void update(const QString &filePath, const QString &code);
+    void removePath(const QString &path);
+    bool mightUse(const QString &filePath, const QStringList &names) const;
+    std::optional<Entry> entry(const QString &filePath) const;
+
+    static QSet<QString> identifiersOf(const QString &code, bool *complete);
+
+private:
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    QString m_cacheFile;
+    bool m_dirty = false;
+};
+
+} // namespace QmlLsp
+
+QT_END_NAMESPACE
+
+#endif // QQMLLSINDEX_P_H
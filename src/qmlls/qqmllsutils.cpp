@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qqmllsutils_p.h"
+#include "qqmllsindex_p.h"
 
 #include <QtCore/qassert.h>
 #include <QtLanguageServer/private/qlanguageserverspectypes_p.h>
@@ -863,7 +864,8 @@ static FieldFilter filterForFindUsages()
     return filter;
 };
 
-static void findUsagesOfNonJSIdentifiers(const DomItem &item, const QString &name, Usages &result)
+static void findUsagesOfNonJSIdentifiers(const DomItem &item, const QString &name, Usages &result,
+                                         const QmlLsp::QQmlLSIndex *index)
 {
     const auto expressionType = resolveExpressionType(item, ResolveOwnerType);
     if (!expressionType)
@@ -966,6 +968,9 @@ static void findUsagesOfNonJSIdentifiers(const DomItem &item, const QString &nam
     const DomItem qmlFiles = item.top().field(Fields::qmlFileWithPath);
     const auto filter = filterForFindUsages();
     for (const QString &file : qmlFiles.keys()) {
+        // visiting the Dom is expensive, skip files that don't even mention the names
+        if (index && !index->mightUse(file, namesToCheck))
+            continue;
         const DomItem currentFileComponents =
                 qmlFiles.key(file).field(Fields::currentItem).field(Fields::components);
         currentFileComponents.visitTree(Path(), emptyChildrenVisitor,
@@ -988,7 +993,8 @@ static std::optional<Location> locationFromJSIdentifierDefinition(const DomItem
     return Location::tryFrom(definitionOfItem.canonicalFilePath(), location, definitionOfItem);
 }
 
-static void findUsagesHelper(const DomItem &item, const QString &name, Usages &result)
+static void findUsagesHelper(const DomItem &item, const QString &name, Usages &result,
+                             const QmlLsp::QQmlLSIndex *index)
 {
     qCDebug(QQmlLSUtilsLog) << "Looking for JS identifier with name" << name;
     DomItem definitionOfItem = findJSIdentifierDefinition(item, name);
@@ -996,7 +1002,7 @@ static void findUsagesHelper(const DomItem &item, const QString &name, Usages &r
     // if there is no definition found: check if name was a property or an id instead
     if (!definitionOfItem) {
         qCDebug(QQmlLSUtilsLog) << "No defining JS-Scope found!";
-        findUsagesOfNonJSIdentifiers(item, name, result);
+        findUsagesOfNonJSIdentifiers(item, name, result, index);
         return;
     }
 
@@ -1036,19 +1042,19 @@ static void findUsagesHelper(const DomItem &item, const QString &name, Usages &r
         result.appendUsage(*definition);
 }
 
-Usages findUsagesOf(const DomItem &item)
+Usages findUsagesOf(const DomItem &item, const QmlLsp::QQmlLSIndex *index)
 {
     Usages result;
 
     switch (item.internalKind()) {
     case DomType::ScriptIdentifierExpression: {
         const QString name = item.field(Fields::identifier).value().toString();
-        findUsagesHelper(item, name, result);
+        findUsagesHelper(item, name, result, index);
         break;
     }
     case DomType::ScriptVariableDeclarationEntry: {
         const QString name = item.field(Fields::identifier).value().toString();
-        findUsagesHelper(item, name, result);
+        findUsagesHelper(item, name, result, index);
         break;
     }
     case DomType::EnumDecl:
@@ -1058,7 +1064,7 @@ Usages findUsagesOf(const DomItem &item)
     case DomType::Binding:
     case DomType::MethodInfo: {
         const QString name = item.field(Fields::name).value().toString();
-        findUsagesHelper(item, name, result);
+        findUsagesHelper(item, name, result, index);
         break;
     }
     case DomType::QmlComponent: {
@@ -1067,7 +1073,7 @@ Usages findUsagesOf(const DomItem &item)
         // get rid of extra qualifiers
         if (const auto dotIndex = name.indexOf(u'.'); dotIndex != -1)
             name = name.sliced(dotIndex + 1);
-        findUsagesHelper(item, name, result);
+        findUsagesHelper(item, name, result, index);
         break;
     }
     default:
@@ -2280,10 +2286,11 @@ Special cases:
 \endlist
 */
 RenameUsages renameUsagesOf(const DomItem &item, const QString &dirtyNewName,
-                            const std::optional<ExpressionType> &targetType)
+                            const std::optional<ExpressionType> &targetType,
+                            const QmlLsp::QQmlLSIndex *index)
 {
     RenameUsages result;
-    const Usages locations = findUsagesOf(item);
+    const Usages locations = findUsagesOf(item, index);
     if (locations.isEmpty())
         return result;
 
@@ -25,6 +25,10 @@
 
 QT_BEGIN_NAMESPACE
 
+namespace QmlLsp {
+class QQmlLSIndex;
+}
+
 Q_DECLARE_LOGGING_CATEGORY(QQmlLSUtilsLog);
 
 namespace QQmlLSUtils {
@@ -264,13 +268,14 @@ QLspSpecification::Range qmlLocationToLspLocation(Location qmlLocation);
 DomItem baseObject(const DomItem &qmlObject);
 std::optional<Location> findTypeDefinitionOf(const DomItem &item);
 std::optional<Location> findDefinitionOf(const DomItem &item);
-Usages findUsagesOf(const DomItem &item);
+Usages findUsagesOf(const DomItem &item, const QmlLsp::QQmlLSIndex *index = nullptr);
 
 std::optional<ErrorMessage>
 checkNameForRename(const DomItem &item, const QString &newName,
                    const std::optional<ExpressionType> &targetType = std::nullopt);
 RenameUsages renameUsagesOf(const DomItem &item, const QString &newName,
-                            const std::optional<ExpressionType> &targetType = std::nullopt);
+                            const std::optional<ExpressionType> &targetType = std::nullopt,
+                            const QmlLsp::QQmlLSIndex *index = nullptr);
 std::optional<ExpressionType> resolveExpressionType(const DomItem &item, ResolveOptions);
 bool isValidEcmaScriptIdentifier(QStringView view);
 
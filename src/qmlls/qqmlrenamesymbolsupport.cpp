@@ -60,7 +60,8 @@ void QQmlRenameSymbolSupport::process(QQmlRenameSymbolSupport::RequestPointerArg
     // collect them into editsByFileUris.
     QMap<QUrl, QList<QLspSpecification::TextEdit>> editsByFileUris;
 
-    const auto renames = QQmlLSUtils::renameUsagesOf(front.domItem, newName, expressionType);
+    const auto renames = QQmlLSUtils::renameUsagesOf(front.domItem, newName, expressionType,
+                                                     &m_codeModel->index());
     for (const auto &rename : renames.renameInFile()) {
         QLspSpecification::TextEdit edit;
 
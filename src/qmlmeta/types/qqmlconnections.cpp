@@ -412,7 +412,8 @@ void QQmlConnections::connectSignalsToMethods()
 
             if (QQmlVMEMetaObject *vmeMetaObject = QQmlVMEMetaObject::get(this)) {
                 int signalIndex = QQmlPropertyPrivate::get(prop)->signalIndex();
-                auto *signal = new QQmlBoundSignal(target, signalIndex, this, qmlEngine(this));
+                auto *signal = new (engine->qmlEngine()) QQmlBoundSignal(
+                        target, signalIndex, this, qmlEngine(this));
                 signal->setEnabled(d->enabled);
 
                 QV4::Scoped<QV4::JavaScriptFunctionObject> method(
@@ -459,8 +460,9 @@ void QQmlConnections::connectSignalsToBindings()
         QQmlProperty prop(target, propName);
         if (prop.isValid() && (prop.type() & QQmlProperty::SignalProperty)) {
             int signalIndex = QQmlPropertyPrivate::get(prop)->signalIndex();
+            QQmlEngine *engine = qmlEngine(this);
             QQmlBoundSignal *signal =
-                new QQmlBoundSignal(target, signalIndex, this, qmlEngine(this));
+                new (engine) QQmlBoundSignal(target, signalIndex, this, engine);
             signal->setEnabled(d->enabled);
 
             auto f = d->compilationUnit->runtimeFunctions[binding->value.compiledScriptIndex];
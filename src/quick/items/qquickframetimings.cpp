@@ -0,0 +1,229 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qquickframetimings_p.h"
+#include <private/qquickitem_p.h>
+#include <private/qquickwindow_p.h>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \qmltype FrameTimings
+    \nativetype QQuickFrameTimings
+    \inqmlmodule QtQuick
+    \ingroup qtquick-visual
+    \since 6.9
+    \brief Provides a per-phase breakdown of the most recent frames of a window.
+
+    The FrameTimings attached type records how long each phase of producing a
+    frame took for the window the item belongs to. This helps telling apart a
+    frame that was late because of work on the main (gui) thread, such as
+    bindings, animations, polishing or garbage collection, from one that was
+    late because of the render thread.
+
+    \qml
+    Item {
+        FrameTimings.enabled: true
+
+        Timer {
+            interval: 5000; running: true; repeat: true
+            onTriggered: console.log("95th percentile of polish:",
+                                     parent.FrameTimings.percentile(FrameTimings.Polish, 95), "ms")
+        }
+    }
+    \endqml
+
+    Recording is off by default and has a negligible cost when disabled. The
+    timings are shared by all items in the same window, so setting \l enabled
+    or \l capacity on one item changes them for all of them. They are
+    collected by the \c threaded render loop only; with other render loops no
+    frames are recorded.
+
+    \note The time spent on animations is measured after the sync, so it is
+    attributed to the frame following the one in which the animations were
+    advanced. Garbage collection runs incrementally in between frames and is
+    attributed to the next frame. Windows sharing a QML engine also share its
+    garbage collector, so each collection is attributed to one window only.
+ */
+
+QQuickFrameTimings::QQuickFrameTimings(QQuickItem *item)
+    : QObject(item)
+{
+    if (Q_LIKELY(item)) {
+        connect(item, &QQuickItem::windowChanged, this, &QQuickFrameTimings::setWindow);
+        setWindow(item->window());
+    }
+}
+
+QQuickFrameTimings *QQuickFrameTimings::qmlAttachedProperties(QObject *object)
+{
+    if (QQuickItem *item = qobject_cast<QQuickItem *>(object))
+        return new QQuickFrameTimings(item);
+
+    return nullptr;
+}
+
+QSGFrameTimings *QQuickFrameTimings::timings() const
+{
+    return m_window ? &QQuickWindowPrivate::get(m_window)->frameTimings : nullptr;
+}
+
+/*!
+    \qmlattachedproperty bool QtQuick::FrameTimings::enabled
+
+    This property controls whether frame timings are recorded for the window.
+
+    The default value is \c false.
+ */
+bool QQuickFrameTimings::isEnabled() const
+{
+    if (QSGFrameTimings *t = timings())
+        return t->isEnabled();
+    return m_enabled;
+}
+
+void QQuickFrameTimings::setEnabled(bool enabled)
+{
+    if (enabled == isEnabled())
+        return;
+
+    m_enabled = enabled;
+    // the attached objects of all items in the window are notified by the window's timings
+    if (QSGFrameTimings *t = timings())
+        t->setEnabled(enabled);
+    else
+        emit enabledChanged();
+}
+
+/*!
+    \qmlattachedproperty int QtQuick::FrameTimings::capacity
+
+    This property holds the number of most recent frames that are kept.
+
+    The default value is \c 240.
+ */
+int QQuickFrameTimings::capacity() const
+{
+    if (QSGFrameTimings *t = timings())
+        return int(t->capacity());
+    return m_capacity;
+}
+
+void QQuickFrameTimings::setCapacity(int capacity)
+{
+    capacity = qMax(capacity, 1);
+    if (capacity == this->capacity())
+        return;
+
+    m_capacity = capacity;
+    if (QSGFrameTimings *t = timings())
+        t->setCapacity(capacity);
+    else
+        emit capacityChanged();
+}
+
+/*!
+    \qmlattachedmethod list<var> QtQuick::FrameTimings::frames()
+
+    Returns the recorded frames, oldest first. Each frame is an object with the
+    properties \c frameNumber, \c animations, \c polish, \c syncWait,
+    \c garbageCollection, \c sync, \c renderPrepare, \c renderRecord and
+    \c present, plus the totals \c guiThread and \c renderThread. All durations
+    are in milliseconds.
+
+    \value animations           Advancing the animations on the gui thread.
+    \value polish               Polishing items, for example laying out positioners.
+    \value syncWait             The gui thread waiting for the render thread to start the sync.
+    \value garbageCollection    The JavaScript garbage collector, on the gui thread.
+    \value sync                 Synchronizing the items with the scene graph.
+    \value renderPrepare        Preparing the frame in the renderer, for example uploading geometry.
+    \value renderRecord         Recording the render pass.
+    \value present              Submitting and presenting the frame.
+ */
+QVariantList QQuickFrameTimings::frames() const
+{
+    QVariantList result;
+    QSGFrameTimings *t = timings();
+    if (!t)
+        return result;
+
+    const auto toMs = [](qint64 ns) { return qreal(ns) / 1000000.0; };
+    const QList<QSGFrameTimings::Frame> frames = t->frames();
+    result.reserve(frames.size());
+    for (const QSGFrameTimings::Frame &frame : frames) {
+        QVariantMap map;
+        map.insert(QStringLiteral("frameNumber"), frame.frameNumber);
+        map.insert(QStringLiteral("animations"), toMs(frame.phases[QSGFrameTimings::Animations]));
+        map.insert(QStringLiteral("polish"), toMs(frame.phases[QSGFrameTimings::Polish]));
+        map.insert(QStringLiteral("syncWait"), toMs(frame.phases[QSGFrameTimings::SyncWait]));
+        map.insert(QStringLiteral("garbageCollection"), toMs(frame.phases[QSGFrameTimings::GarbageCollection]));
+        map.insert(QStringLiteral("sync"), toMs(frame.phases[QSGFrameTimings::Sync]));
+        map.insert(QStringLiteral("renderPrepare"), toMs(frame.phases[QSGFrameTimings::RenderPrepare]));
+        map.insert(QStringLiteral("renderRecord"), toMs(frame.phases[QSGFrameTimings::RenderRecord]));
+        map.insert(QStringLiteral("present"), toMs(frame.phases[QSGFrameTimings::Present]));
+        map.insert(QStringLiteral("guiThread"), toMs(frame.guiThreadTime()));
+        map.insert(QStringLiteral("renderThread"), toMs(frame.renderThreadTime()));
+        result.append(map);
+    }
+    return result;
+}
+
+/*!
+    \qmlattachedmethod real QtQuick::FrameTimings::percentile(Phase phase, real p)
+
+    Returns the \a p th percentile, with \a p between 0 and 100, of the
+    duration of \a phase over the recorded frames, in milliseconds.
+
+    For example, \c{percentile(FrameTimings.Sync, 99)} returns the sync
+    duration that 99 percent of the recorded frames did not exceed.
+ */
+qreal QQuickFrameTimings::percentile(QQuickFrameTimings::Phase phase, qreal p) const
+{
+    if (QSGFrameTimings *t = timings())
+        return qreal(t->percentile(QSGFrameTimings::Phase(phase), p)) / 1000000.0;
+    return 0;
+}
+
+/*!
+    \qmlattachedmethod void QtQuick::FrameTimings::clear()
+
+    Discards the recorded frames.
+ */
+void QQuickFrameTimings::clear()
+{
+    if (QSGFrameTimings *t = timings())
+        t->clear();
+}
+
+void QQuickFrameTimings::setWindow(QQuickWindow *window)
+{
+    if (m_window == window)
+        return;
+
+    const bool wasEnabled = isEnabled();
+    const int oldCapacity = capacity();
+
+    if (QSGFrameTimings *t = timings())
+        disconnect(t, nullptr, this, nullptr);
+
+    m_window = window;
+    if (QSGFrameTimings *t = timings()) {
+        // only push explicitly requested settings, other attached objects
+        // in the same window may have enabled recording already
+        if (m_enabled)
+            t->setEnabled(true);
+        if (m_capacity != QSGFrameTimings::DefaultCapacity)
+            t->setCapacity(m_capacity);
+        connect(t, &QSGFrameTimings::enabledChanged, this, &QQuickFrameTimings::enabledChanged);
+        connect(t, &QSGFrameTimings::capacityChanged, this, &QQuickFrameTimings::capacityChanged);
+    }
+
+    if (isEnabled() != wasEnabled)
+        emit enabledChanged();
+    if (capacity() != oldCapacity)
+        emit capacityChanged();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qquickframetimings_p.cpp"
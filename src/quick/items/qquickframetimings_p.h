@@ -0,0 +1,86 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QQUICKFRAMETIMINGS_P_H
+#define QQUICKFRAMETIMINGS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qobject.h>
+#include <QtCore/qpointer.h>
+#include <QtCore/qvariant.h>
+#include <QtQml/qqml.h>
+#include <QtQuick/private/qtquickglobal_p.h>
+#include <QtQuick/private/qsgframetimings_p.h>
+#include <QtCore/private/qglobal_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class QQuickItem;
+class QQuickWindow;
+
+class Q_QUICK_EXPORT QQuickFrameTimings : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled WRITE setEnabled NOTIFY enabledChanged FINAL)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged FINAL)
+
+    QML_NAMED_ELEMENT(FrameTimings)
+    QML_ADDED_IN_VERSION(6, 9)
+    QML_UNCREATABLE("FrameTimings is only available via attached properties.")
+    QML_ATTACHED(QQuickFrameTimings)
+
+public:
+    enum Phase {
+        Animations = QSGFrameTimings::Animations,
+        Polish = QSGFrameTimings::Polish,
+        SyncWait = QSGFrameTimings::SyncWait,
+        GarbageCollection = QSGFrameTimings::GarbageCollection,
+        Sync = QSGFrameTimings::Sync,
+        RenderPrepare = QSGFrameTimings::RenderPrepare,
+        RenderRecord = QSGFrameTimings::RenderRecord,
+        Present = QSGFrameTimings::Present
+    };
+    Q_ENUM(Phase)
+
+    QQuickFrameTimings(QQuickItem *item = nullptr);
+
+    static QQuickFrameTimings *qmlAttachedProperties(QObject *object);
+
+    bool isEnabled() const;
+    void setEnabled(bool enabled);
+
+    int capacity() const;
+    void setCapacity(int capacity);
+
+    Q_INVOKABLE QVariantList frames() const;
+    Q_INVOKABLE qreal percentile(QQuickFrameTimings::Phase phase, qreal p) const;
+    Q_INVOKABLE void clear();
+
+Q_SIGNALS:
+    void enabledChanged();
+    void capacityChanged();
+
+private Q_SLOTS:
+    void setWindow(QQuickWindow *window);
+
+private:
+    QSGFrameTimings *timings() const;
+
+    QPointer<QQuickWindow> m_window;
+    bool m_enabled = false;
+    int m_capacity = QSGFrameTimings::DefaultCapacity;
+};
+
+QT_END_NAMESPACE
+
+#endif // QQUICKFRAMETIMINGS_P_H
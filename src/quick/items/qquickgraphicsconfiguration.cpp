@@ -269,6 +269,14 @@ QT_BEGIN_NAMESPACE
       Writing pipeline cache contents to 'filename'
     \endcode
 
+    Next to the pipeline cache data, the scene graph also saves a description
+    of the graphics pipelines it created, in a file with the same name and the
+    \c{.qsgpipelines} suffix. In the next run, the first time a material is
+    rendered to a given render target, all pipelines recorded for that
+    material and render target are created at once. This avoids a stall each
+    time a new combination of blending, clipping or depth state is encountered
+    for the first time, for example when navigating to a new screen.
+
     \section1 The Automatic Pipeline Cache
 
     When no filename is provided for save and load, the automatic pipeline
@@ -26,6 +26,9 @@
 #include <private/qabstractanimation_p.h>
 
 #include <QtGui/qpainter.h>
+#include <QtGui/qglyphrun.h>
+#include <QtGui/qtextlayout.h>
+#include <QtGui/qscreen.h>
 #include <QtGui/qevent.h>
 #include <QtGui/qmatrix4x4.h>
 #include <QtGui/private/qevent_p.h>
@@ -43,6 +46,7 @@
 #include <private/qqmldebugserviceinterfaces_p.h>
 #include <private/qqmldebugconnector_p.h>
 #include <private/qsgdefaultrendercontext_p.h>
+#include <private/qsgdistancefieldglyphstore_p.h>
 #include <private/qsgsoftwarerenderer_p.h>
 #if QT_CONFIG(opengl)
 #include <private/qopengl_p.h>
@@ -52,6 +56,7 @@
 #include <private/qdebug_p.h>
 #endif
 #include <QtCore/qpointer.h>
+#include <QtCore/qelapsedtimer.h>
 
 #include <rhi/qrhi.h>
 
@@ -62,6 +67,7 @@ QT_BEGIN_NAMESPACE
 
 Q_STATIC_LOGGING_CATEGORY(lcDirty, "qt.quick.dirty")
 Q_LOGGING_CATEGORY(lcQuickWindow, "qt.quick.window")
+Q_STATIC_LOGGING_CATEGORY(lcIncubation, "qt.quick.incubation")
 
 bool QQuickWindowPrivate::defaultAlphaBuffer = false;
 
@@ -76,11 +82,11 @@ class QQuickWindowIncubationController : public QObject, public QQmlIncubationCo
     Q_OBJECT
 
 public:
-    QQuickWindowIncubationController(QSGRenderLoop *loop)
-        : m_renderLoop(loop), m_timer(0)
+    QQuickWindowIncubationController(QQuickWindow *window, QSGRenderLoop *loop)
+        : m_window(window), m_renderLoop(loop), m_timer(0)
     {
-        // Allow incubation for 1/3 of a frame.
-        m_incubation_time = qMax(1, int(1000 / QGuiApplication::primaryScreen()->refreshRate()) / 3);
+        // Allow incubation for 1/3 of a frame when there is no frame to measure.
+        m_incubation_time = qMax(1, frameInterval() / 3);
 
         QAnimationDriver *animationDriver = m_renderLoop->animationDriver();
         if (animationDriver) {
@@ -89,6 +95,8 @@ public:
         }
     }
 
+    const QQuickWindowIncubationStatistics &statistics() const { return m_statistics; }
+
 protected:
     void timerEvent(QTimerEvent *) override
     {
@@ -105,13 +113,57 @@ protected:
         }
     }
 
+    int frameInterval() const
+    {
+        QScreen *screen = m_window ? m_window->screen() : QGuiApplication::primaryScreen();
+        const qreal refreshRate = screen ? screen->refreshRate() : 60;
+        return qMax(1, int(1000 / (refreshRate > 0 ? refreshRate : 60)));
+    }
+
+    // The render loop asks us to incubate once the GUI thread is done with
+    // polish, sync and animations for the current frame. Whatever is left of
+    // the frame interval at that point can be spent on incubation, minus a
+    // quarter of a frame reserved for event delivery. The frame may belong to
+    // a different window, or be a mere animation tick, so we measure from the
+    // start time the render loop recorded for it.
+    int frameBudget() const
+    {
+        const qint64 elapsed = m_renderLoop->incubationFrameElapsed();
+        if (elapsed < 0)
+            return m_incubation_time;
+        const int interval = frameInterval();
+        const int remaining = interval - int(qMin<qint64>(elapsed, interval)) - interval / 4;
+        return qBound(1, remaining, interval);
+    }
+
+    void incubateAndRecord(int msecs)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        m_lastCount = incubatingObjectCount();
+        m_frameObjects = 0;
+        m_incubating = true;
+        incubateFor(msecs);
+        m_incubating = false;
+
+        m_statistics.frames++;
+        m_statistics.lastFrameBudget = msecs;
+        m_statistics.lastFrameTime = timer.elapsed();
+        m_statistics.lastFrameObjects = m_frameObjects;
+        m_statistics.maxFrameObjects = qMax(m_statistics.maxFrameObjects, m_frameObjects);
+        m_statistics.totalObjects += m_frameObjects;
+        qCDebug(lcIncubation, "[window %p] incubated %d objects in %d ms (budget %d ms, %d pending)",
+                m_window.data(), m_frameObjects, int(m_statistics.lastFrameTime), msecs,
+                incubatingObjectCount());
+    }
+
 public slots:
     void incubate() {
         if (m_renderLoop && incubatingObjectCount()) {
             if (m_renderLoop->interleaveIncubation()) {
-                incubateFor(m_incubation_time);
+                incubateAndRecord(frameBudget());
             } else {
-                incubateFor(m_incubation_time * 2);
+                incubateAndRecord(m_incubation_time * 2);
                 if (incubatingObjectCount())
                     incubateAgain();
             }
@@ -123,14 +175,23 @@ public slots:
 protected:
     void incubatingObjectCountChanged(int count) override
     {
+        if (m_incubating && count < m_lastCount)
+            m_frameObjects += m_lastCount - count;
+        m_lastCount = count;
+
         if (count && m_renderLoop && !m_renderLoop->interleaveIncubation())
             incubateAgain();
     }
 
 private:
+    QPointer<QQuickWindow> m_window;
     QPointer<QSGRenderLoop> m_renderLoop;
+    QQuickWindowIncubationStatistics m_statistics;
     int m_incubation_time;
     int m_timer;
+    int m_lastCount = 0;
+    int m_frameObjects = 0;
+    bool m_incubating = false;
 };
 
 #if QT_CONFIG(accessibility)
@@ -323,6 +384,12 @@ struct PolishLoopDetector
     int numPolishLoopsInSequence = 0;
 };
 
+QQuickWindowIncubationStatistics QQuickWindowPrivate::incubationStatistics() const
+{
+    return incubationController ? incubationController->statistics()
+                                : QQuickWindowIncubationStatistics();
+}
+
 void QQuickWindowPrivate::polishItems()
 {
     // An item can trigger polish on another item, or itself for that matter,
@@ -2707,6 +2774,11 @@ QImage QQuickWindow::grabWindow()
     for this window. QQuickView automatically installs this controller for you,
     otherwise you will need to install it yourself using \l{QQmlEngine::setIncubationController()}.
 
+    When the render loop interleaves incubation with rendering, the controller
+    measures how much of the current frame interval is left after polishing,
+    synchronizing and advancing animations, and spends exactly that on
+    incubation. Otherwise a fixed slice of a third of a frame is used.
+
     The controller is owned by the window and will be destroyed when the window
     is deleted.
 */
@@ -2718,7 +2790,7 @@ QQmlIncubationController *QQuickWindow::incubationController() const
         return nullptr; // TODO: make sure that this is safe
 
     if (!d->incubationController)
-        d->incubationController = new QQuickWindowIncubationController(d->windowManager);
+        d->incubationController = new QQuickWindowIncubationController(const_cast<QQuickWindow *>(this), d->windowManager);
     return d->incubationController;
 }
 
@@ -4433,6 +4505,52 @@ void QQuickWindow::setTextRenderType(QQuickWindow::TextRenderType renderType)
     QQuickWindowPrivate::textRenderType = renderType;
 }
 
+/*!
+    \since 6.9
+
+    Starts generating the distance fields for the glyphs needed to show \a text
+    with \a font on a worker thread, so that text using them can be shown
+    later on without generating the glyphs on the render thread first. This
+    avoids stutter when, for example, switching the user interface to a
+    language whose glyphs have not been shown yet.
+
+    \a renderTypeQuality must match the \l{Text::renderTypeQuality}{renderTypeQuality}
+    of the text elements that will show the glyphs; the default value of -1
+    corresponds to \c Text.DefaultRenderTypeQuality. Fallback fonts chosen for
+    characters that \a font does not cover are preloaded as well. The function
+    returns immediately and can be called at any time, also before any window
+    is shown.
+
+    This only has an effect for text rendered with
+    QQuickWindow::QtTextRendering, i.e. using distance fields.
+
+    When the \c QSG_DISTANCEFIELD_DISK_CACHE environment variable is set to a
+    non-zero value, generated distance fields are additionally stored in the
+    application's cache directory and reused by subsequent runs of the
+    application.
+
+    \sa setTextRenderType()
+*/
+void QQuickWindow::preloadDistanceFieldGlyphs(const QFont &font, const QString &text,
+                                              int renderTypeQuality)
+{
+    QString layoutText = text;
+    layoutText.replace(QLatin1Char('\n'), QChar::LineSeparator);
+
+    QTextLayout layout(layoutText, font);
+    layout.beginLayout();
+    while (layout.createLine().isValid())
+        ;
+    layout.endLayout();
+
+    const QList<QGlyphRun> glyphRuns = layout.glyphRuns();
+    for (const QGlyphRun &glyphRun : glyphRuns) {
+        QSGDistanceFieldGlyphStore::instance()->preload(glyphRun.rawFont(),
+                                                        glyphRun.glyphIndexes(),
+                                                        renderTypeQuality);
+    }
+}
+
 
 /*!
     \since 6.0
@@ -37,6 +37,7 @@ class QRhi;
 class QRhiSwapChain;
 class QRhiTexture;
 class QSGTextNode;
+class QFont;
 
 class Q_QUICK_EXPORT QQuickWindow : public QWindow
 {
@@ -161,6 +162,8 @@ public:
 
     static TextRenderType textRenderType();
     static void setTextRenderType(TextRenderType renderType);
+    static void preloadDistanceFieldGlyphs(const QFont &font, const QString &text,
+                                           int renderTypeQuality = -1);
 
     QRhi *rhi() const;
     QRhiSwapChain *swapChain() const;
@@ -18,6 +18,7 @@
 #include <QtQuick/private/qquickdeliveryagent_p_p.h>
 #include <QtQuick/private/qquickevents_p_p.h>
 #include <QtQuick/private/qsgcontext_p.h>
+#include <QtQuick/private/qsgframetimings_p.h>
 #include <QtQuick/private/qquickpaletteproviderprivatebase_p.h>
 #include <QtQuick/private/qquickrendertarget_p.h>
 #include <QtQuick/private/qquickgraphicsdevice_p.h>
@@ -104,6 +105,16 @@ struct QQuickWindowRenderTarget
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(QQuickWindowRenderTarget::ResetFlags)
 
+struct QQuickWindowIncubationStatistics
+{
+    int frames = 0;             // number of incubation slices run
+    int lastFrameBudget = 0;    // msecs handed to the incubator in the last slice
+    qint64 lastFrameTime = 0;   // msecs actually spent in the last slice
+    int lastFrameObjects = 0;   // objects completed in the last slice
+    int maxFrameObjects = 0;
+    qint64 totalObjects = 0;
+};
+
 class Q_QUICK_EXPORT QQuickWindowPrivate
     : public QWindowPrivate
     , public QQuickPaletteProviderPrivateBase<QQuickWindow, QQuickWindowPrivate>
@@ -219,6 +230,8 @@ public:
 
     QColor clearColor;
 
+    QSGFrameTimings frameTimings;
+
     uint persistentGraphics : 1;
     uint persistentSceneGraph : 1;
     uint inDestructor : 1;
@@ -238,6 +251,7 @@ public:
     QQuickGraphicsConfiguration graphicsConfig;
 
     mutable QQuickWindowIncubationController *incubationController;
+    QQuickWindowIncubationStatistics incubationStatistics() const;
 
     static bool defaultAlphaBuffer;
     static QQuickWindow::TextRenderType textRenderType;
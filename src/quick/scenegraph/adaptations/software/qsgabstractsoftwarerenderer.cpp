@@ -9,13 +9,35 @@
 #include "qsgsoftwarerenderablenode_p.h"
 
 #include <QtCore/QLoggingCategory>
+#include <QtGui/QImage>
+#include <QtGui/QPainter>
 #include <QtGui/QWindow>
 #include <QtQuick/QSGSimpleRectNode>
 
+#if QT_CONFIG(thread)
+#include <QtCore/QThread>
+#include <QtQuick/private/qsgworkerpool_p.h>
+#endif
+
 Q_STATIC_LOGGING_CATEGORY(lc2DRender, "qt.scenegraph.softwarecontext.abstractrenderer")
 
 QT_BEGIN_NAMESPACE
 
+#if QT_CONFIG(thread)
+// Size of the tiles, in logical pixels, that renderNodesTiled() rasterizes in parallel
+static const int TileSize = 128;
+
+static int renderThreadCount()
+{
+    static const int count = [] {
+        bool ok = false;
+        const int threads = qEnvironmentVariableIntValue("QSG_SOFTWARE_RENDER_THREADS", &ok);
+        return ok ? threads : QThread::idealThreadCount();
+    }();
+    return count;
+}
+#endif
+
 QSGAbstractSoftwareRenderer::QSGAbstractSoftwareRenderer(QSGRenderContext *context)
     : QSGRenderer(context)
     , m_background(new QSGSimpleRectNode)
@@ -109,6 +131,132 @@ QRegion QSGAbstractSoftwareRenderer::renderNodes(QPainter *painter)
     return dirtyRegion;
 }
 
+/*!
+    \internal
+    Paints the render list like renderNodes(), but splits the area to update
+    into tiles that are rasterized in parallel. Each tile is painted by its own
+    QPainter on an image sharing the memory of \a image, the paint device of
+    \a painter.
+
+    Nodes that cannot be painted concurrently are painted with \a painter, in
+    order, between the parallel batches of the nodes around them. If \a image
+    is null, or cannot be split into tiles, this is the same as renderNodes().
+ */
+QRegion QSGAbstractSoftwareRenderer::renderNodesTiled(QPainter *painter, QImage *image)
+{
+#if QT_CONFIG(thread)
+    const int threadCount = renderThreadCount();
+    // Tiles must start at whole device pixels, and scanlines must stay aligned
+    const qreal dpr = image ? image->devicePixelRatio() : 1.0;
+    if (!image || threadCount < 2 || image->depth() % 8 != 0 || !qFuzzyCompare(dpr, qreal(qRound(dpr)))
+        || m_renderableNodes.size() < 2) {
+        return renderNodes(painter);
+    }
+
+    QRegion dirtyRegion;
+    QVector<QSGSoftwareRenderableNode *> batch;
+    auto iterator = m_renderableNodes.begin();
+    // First node is the background and needs to painted without blending, see renderTiles()
+    if (m_clearColorEnabled) {
+        auto backgroundNode = *iterator;
+        backgroundNode->prepareConcurrentRendering(dpr);
+        batch.append(backgroundNode);
+    }
+    iterator++;
+
+    for (; iterator != m_renderableNodes.end(); ++iterator) {
+        auto node = *iterator;
+        if (node->prepareConcurrentRendering(dpr)) {
+            batch.append(node);
+            continue;
+        }
+        dirtyRegion += renderTiles(painter, image, batch, threadCount);
+        batch.clear();
+        dirtyRegion += node->renderNode(painter);
+    }
+    dirtyRegion += renderTiles(painter, image, batch, threadCount);
+
+    return dirtyRegion;
+#else
+    Q_UNUSED(image);
+    return renderNodes(painter);
+#endif
+}
+
+QRegion QSGAbstractSoftwareRenderer::renderTiles(QPainter *painter, QImage *image,
+                                                 const QVector<QSGSoftwareRenderableNode *> &nodes,
+                                                 int threadCount)
+{
+    QRegion dirtyRegion;
+    if (nodes.isEmpty())
+        return dirtyRegion;
+
+    QSGSoftwareRenderableNode *opaqueNode = m_clearColorEnabled ? m_renderableNodes.first() : nullptr;
+
+#if QT_CONFIG(thread)
+    QRegion region;
+    for (auto node : nodes) {
+        if (node->isDirty())
+            region += node->dirtyRegion();
+    }
+
+    QVector<QRect> tiles;
+    const QRect bounds = region.boundingRect();
+    const int left = bounds.left() - (bounds.left() % TileSize + TileSize) % TileSize;
+    const int top = bounds.top() - (bounds.top() % TileSize + TileSize) % TileSize;
+    for (int y = top; y <= bounds.bottom(); y += TileSize) {
+        for (int x = left; x <= bounds.right(); x += TileSize) {
+            const QRect tile(x, y, TileSize, TileSize);
+            if (region.intersects(tile))
+                tiles.append(tile);
+        }
+    }
+
+    if (tiles.size() > 1) {
+        const qreal dpr = image->devicePixelRatio();
+        const QRect imageRect = image->rect();
+        // Detaches, if needed, before any tile wraps the pixels
+        uchar *bits = image->bits();
+        const qsizetype bytesPerLine = image->bytesPerLine();
+        const int bytesPerPixel = image->depth() / 8;
+        const QImage::Format format = image->format();
+
+        auto renderTile = [&](const QRect &tile) {
+            const QRect deviceRect = QRect(tile.topLeft() * dpr, tile.size() * dpr) & imageRect;
+            if (deviceRect.isEmpty())
+                return;
+            QImage tileImage(bits + deviceRect.y() * bytesPerLine + deviceRect.x() * bytesPerPixel,
+                             deviceRect.width(), deviceRect.height(), bytesPerLine, format);
+            tileImage.setDevicePixelRatio(dpr);
+
+            QPainter tilePainter(&tileImage);
+            tilePainter.setRenderHint(QPainter::Antialiasing);
+            // Nodes replace the world transform, so move the tile origin with the view transform
+            tilePainter.setWindow(tile.x(), tile.y(), TileSize, TileSize);
+            tilePainter.setViewport(0, 0, TileSize, TileSize);
+            for (auto node : nodes) {
+                if (node->boundingRectMax().intersects(tile))
+                    node->renderTile(&tilePainter, tile, node == opaqueNode);
+            }
+        };
+
+        QSGWorkerPool::run(tiles.size(), threadCount,
+                           [&](qsizetype i) { renderTile(tiles.at(i)); });
+
+        for (auto node : nodes)
+            dirtyRegion += node->finishRendering();
+        return dirtyRegion;
+    }
+#else
+    Q_UNUSED(image);
+    Q_UNUSED(threadCount);
+#endif
+
+    for (auto node : nodes)
+        dirtyRegion += node->renderNode(painter, node == opaqueNode);
+    return dirtyRegion;
+}
+
 void QSGAbstractSoftwareRenderer::buildRenderList()
 {
     // Clear the previous renderlist
@@ -136,9 +284,7 @@ QRegion QSGAbstractSoftwareRenderer::optimizeRenderList()
         }
 
         // Keep up with obscured regions
-        if (node->isOpaque()) {
-            m_obscuredRegion += node->boundingRectMin();
-        }
+        m_obscuredRegion += node->opaqueRegion();
 
         if (node->isDirty()) {
             // Don't paint things outside of the rendering area
@@ -153,7 +299,7 @@ QRegion QSGAbstractSoftwareRenderer::optimizeRenderList()
             // Get the dirty region's to pass to the next nodes
             if (node->isOpaque()) {
                 // if isOpaque, subtract node's dirty rect from m_dirtyRegion
-                m_dirtyRegion -= node->boundingRectMin();
+                m_dirtyRegion -= node->opaqueRegion();
             } else {
                 // if isAlpha, add node's dirty rect to m_dirtyRegion
                 m_dirtyRegion += node->dirtyRegion();
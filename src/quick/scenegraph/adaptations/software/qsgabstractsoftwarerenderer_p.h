@@ -22,6 +22,7 @@
 QT_BEGIN_NAMESPACE
 
 class QSGSimpleRectNode;
+class QImage;
 
 class QSGSoftwareRenderableNode;
 class QSGSoftwareRenderableNodeUpdater;
@@ -45,6 +46,7 @@ public:
 
 protected:
     QRegion renderNodes(QPainter *painter);
+    QRegion renderNodesTiled(QPainter *painter, QImage *image);
     void buildRenderList();
     QRegion optimizeRenderList();
 
@@ -63,6 +65,8 @@ private:
     void nodeMaterialUpdated(QSGNode *node);
     void nodeMatrixUpdated(QSGNode *node);
     void nodeOpacityUpdated(QSGNode *node);
+    QRegion renderTiles(QPainter *painter, QImage *image,
+                        const QVector<QSGSoftwareRenderableNode *> &nodes, int threadCount);
 
     QHash<QSGNode*, QSGSoftwareRenderableNode*> m_nodes;
     QVector<QSGSoftwareRenderableNode*> m_renderableNodes;
@@ -4,10 +4,56 @@
 #include "qsgsoftwareinternalrectanglenode_p.h"
 #include <qmath.h>
 
+#include <QtCore/QCache>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QMutex>
 #include <QtGui/QPainter>
+#include <QtGui/QPainterPath>
+
+#include <algorithm>
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+struct CornerPixmapKey
+{
+    int radius;
+    qreal devicePixelRatio;
+    qreal penWidth;
+    QRgb penColor;
+    QRgb fillColor;
+
+    friend bool operator==(const CornerPixmapKey &a, const CornerPixmapKey &b) noexcept
+    {
+        return a.radius == b.radius && a.devicePixelRatio == b.devicePixelRatio
+                && a.penWidth == b.penWidth && a.penColor == b.penColor
+                && a.fillColor == b.fillColor;
+    }
+
+    friend size_t qHash(const CornerPixmapKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.radius, key.devicePixelRatio, key.penWidth, key.penColor,
+                          key.fillColor);
+    }
+};
+
+using CornerPixmapCache = QCache<CornerPixmapKey, QPixmap>;
+}
+
+// Corner pixmaps are shared by all rectangles with the same style. Pixmaps that
+// are still in use stay alive in their nodes when they are evicted from the cache.
+// The cost of a pixmap is its size in KB.
+static const qsizetype MaxCornerPixmapCacheCost = 4 * 1024;
+Q_CONSTINIT static QBasicMutex cornerPixmapMutex;
+Q_GLOBAL_STATIC(CornerPixmapCache, cornerPixmaps, MaxCornerPixmapCacheCost)
+
+// Pixmaps must not outlive the application
+static void clearCornerPixmaps()
+{
+    QMutexLocker locker(&cornerPixmapMutex);
+    cornerPixmaps()->clear();
+}
+
 QSGSoftwareInternalRectangleNode::QSGSoftwareInternalRectangleNode()
     : m_penWidth(0)
     , m_radius(0)
@@ -236,16 +282,24 @@ void QSGSoftwareInternalRectangleNode::update()
         generateCornerPixmap();
         m_cornerPixmapIsDirty = false;
     }
+
+    m_transformedPixmap = QPixmap();
+}
+
+void QSGSoftwareInternalRectangleNode::updateDevicePixelRatio(qreal devicePixelRatio)
+{
+    if (!qFuzzyCompare(devicePixelRatio, m_devicePixelRatio)) {
+        m_devicePixelRatio = devicePixelRatio;
+        generateCornerPixmap();
+        m_transformedPixmap = QPixmap();
+    }
 }
 
 void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
 {
     //We can only check for a device pixel ratio change when we know what
     //paint device is being used.
-    if (!qFuzzyCompare(painter->device()->devicePixelRatio(), m_devicePixelRatio)) {
-        m_devicePixelRatio = painter->device()->devicePixelRatio();
-        generateCornerPixmap();
-    }
+    updateDevicePixelRatio(painter->device()->devicePixelRatio());
 
     if (painter->transform().isRotating()) {
         //Rotated rectangles lose the benefits of direct rendering, and have poor rendering
@@ -262,37 +316,34 @@ void QSGSoftwareInternalRectangleNode::paint(QPainter *painter)
             painter->setPen(Qt::NoPen);
             painter->setBrush(m_brush);
             painter->drawRect(m_rect);
-        } else if (m_topLeftRadius < 0
-                   && m_topRightRadius < 0
-                   && m_bottomLeftRadius < 0
-                   && m_bottomRightRadius < 0) {
+        } else {
             //Rounded Rects and Rects with Borders
             //Avoids broken behaviors of QPainter::drawRect/roundedRect
-            QPixmap pixmap = QPixmap(qRound(m_rect.width() * m_devicePixelRatio), qRound(m_rect.height() * m_devicePixelRatio));
-            pixmap.fill(Qt::transparent);
-            pixmap.setDevicePixelRatio(m_devicePixelRatio);
-            QPainter pixmapPainter(&pixmap);
-            paintRectangle(&pixmapPainter, QRect(0, 0, m_rect.width(), m_rect.height()));
-
-            QPainter::RenderHints previousRenderHints = painter->renderHints();
-            painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
-            painter->drawPixmap(m_rect, pixmap);
-            painter->setRenderHints(previousRenderHints);
-        } else {
-            // Corners with different radii. Split implementation to avoid
-            // performance regression of the majority of cases
-            QPixmap pixmap = QPixmap(qRound(m_rect.width() * m_devicePixelRatio), qRound(m_rect.height() * m_devicePixelRatio));
-            pixmap.fill(Qt::transparent);
-            pixmap.setDevicePixelRatio(m_devicePixelRatio);
-            QPainter pixmapPainter(&pixmap);
-            // Slow function relying on paths
-            paintRectangleIndividualCorners(&pixmapPainter, QRect(0, 0, m_rect.width(), m_rect.height()));
+            //The pixmap only depends on the rectangle, so it is kept until it changes
+            if (m_transformedPixmap.isNull()) {
+                QPixmap pixmap = QPixmap(qRound(m_rect.width() * m_devicePixelRatio), qRound(m_rect.height() * m_devicePixelRatio));
+                pixmap.fill(Qt::transparent);
+                pixmap.setDevicePixelRatio(m_devicePixelRatio);
+                QPainter pixmapPainter(&pixmap);
+                if (m_topLeftRadius < 0
+                    && m_topRightRadius < 0
+                    && m_bottomLeftRadius < 0
+                    && m_bottomRightRadius < 0) {
+                    paintRectangle(&pixmapPainter, QRect(0, 0, m_rect.width(), m_rect.height()));
+                } else {
+                    // Corners with different radii. Split implementation to avoid
+                    // performance regression of the majority of cases
+                    // Slow function relying on paths
+                    paintRectangleIndividualCorners(&pixmapPainter, QRect(0, 0, m_rect.width(), m_rect.height()));
+                }
+                pixmapPainter.end();
+                m_transformedPixmap = pixmap;
+            }
 
             QPainter::RenderHints previousRenderHints = painter->renderHints();
             painter->setRenderHint(QPainter::SmoothPixmapTransform, true);
-            painter->drawPixmap(m_rect, pixmap);
+            painter->drawPixmap(m_rect, m_transformedPixmap);
             painter->setRenderHints(previousRenderHints);
-
         }
 
 
@@ -328,6 +379,37 @@ bool QSGSoftwareInternalRectangleNode::isOpaque() const
     return true;
 }
 
+/*!
+    \internal
+    Returns the parts of rect() that are painted with opaque pixels. For rounded
+    rectangles, that is the rectangle without the corners.
+ */
+QList<QRectF> QSGSoftwareInternalRectangleNode::opaqueRects() const
+{
+    if (m_color.alpha() < 255)
+        return {};
+    if (m_penWidth > 0.0f && m_penColor.alpha() < 255)
+        return {};
+    for (const QGradientStop &stop : std::as_const(m_stops)) {
+        if (stop.second.alpha() < 255)
+            return {};
+    }
+
+    const qreal radius = std::max({ m_radius, m_topLeftRadius, m_topRightRadius,
+                                    m_bottomLeftRadius, m_bottomRightRadius, qreal(0) });
+    if (radius <= 0)
+        return { QRectF(m_rect) };
+
+    QList<QRectF> rects;
+    const QRectF horizontal = QRectF(m_rect).adjusted(0, radius, 0, -radius);
+    if (horizontal.isValid())
+        rects.append(horizontal);
+    const QRectF vertical = QRectF(m_rect).adjusted(radius, 0, -radius, 0);
+    if (vertical.isValid())
+        rects.append(vertical);
+    return rects;
+}
+
 QRectF QSGSoftwareInternalRectangleNode::rect() const
 {
     //TODO: double check that this is correct.
@@ -442,10 +524,46 @@ void QSGSoftwareInternalRectangleNode::paintRectangle(QPainter *painter, const Q
                                  QPointF(brushRect.x() + brushRect.width(), brushRect.y() + brushRect.height() - innerRectRadius));
                 painter->fillRect(rightRect, m_color);
             } else {
-                //Rounded Rect with gradient (slow)
-                painter->setPen(Qt::NoPen);
-                painter->setBrush(m_brush);
-                painter->drawRoundedRect(brushRect, innerRectRadius, innerRectRadius);
+                //Rounded Rects with gradient: the band between the corners is 1 blit, only
+                //the top and bottom bands with the corners need the rasterizer. The bands
+                //are split on device pixels, so that no pixel is blended twice at the seams
+                painter->setRenderHint(QPainter::Antialiasing, true);
+                const QTransform &transform = painter->deviceTransform();
+                qreal bandTop = brushRect.top() + innerRectRadius;
+                qreal bandBottom = brushRect.bottom() - innerRectRadius;
+                if (transform.type() <= QTransform::TxScale && transform.m22() > 0) {
+                    bandTop = (qCeil(bandTop * transform.m22() + transform.dy()) - transform.dy()) / transform.m22();
+                    bandBottom = (qFloor(bandBottom * transform.m22() + transform.dy()) - transform.dy()) / transform.m22();
+                }
+
+                if (transform.type() <= QTransform::TxScale && transform.m22() > 0 && bandTop < bandBottom) {
+                    const qreal diameter = innerRectRadius * 2;
+                    QPainterPath topBand;
+                    topBand.moveTo(brushRect.left(), bandTop);
+                    topBand.lineTo(brushRect.left(), brushRect.top() + innerRectRadius);
+                    topBand.arcTo(QRectF(brushRect.left(), brushRect.top(), diameter, diameter), 180, -90);
+                    topBand.lineTo(brushRect.right() - innerRectRadius, brushRect.top());
+                    topBand.arcTo(QRectF(brushRect.right() - diameter, brushRect.top(), diameter, diameter), 90, -90);
+                    topBand.lineTo(brushRect.right(), bandTop);
+                    topBand.closeSubpath();
+                    painter->fillPath(topBand, m_brush);
+
+                    painter->fillRect(QRectF(QPointF(brushRect.left(), bandTop), QPointF(brushRect.right(), bandBottom)), m_brush);
+
+                    QPainterPath bottomBand;
+                    bottomBand.moveTo(brushRect.right(), bandBottom);
+                    bottomBand.lineTo(brushRect.right(), brushRect.bottom() - innerRectRadius);
+                    bottomBand.arcTo(QRectF(brushRect.right() - diameter, brushRect.bottom() - diameter, diameter, diameter), 0, -90);
+                    bottomBand.lineTo(brushRect.left() + innerRectRadius, brushRect.bottom());
+                    bottomBand.arcTo(QRectF(brushRect.left(), brushRect.bottom() - diameter, diameter, diameter), 270, -90);
+                    bottomBand.lineTo(brushRect.left(), bandBottom);
+                    bottomBand.closeSubpath();
+                    painter->fillPath(bottomBand, m_brush);
+                } else {
+                    painter->setPen(Qt::NoPen);
+                    painter->setBrush(m_brush);
+                    painter->drawRoundedRect(brushRect, innerRectRadius, innerRectRadius);
+                }
             }
         } else {
             //non-rounded rects only need 1 blit
@@ -529,16 +647,25 @@ void QSGSoftwareInternalRectangleNode::generateCornerPixmap()
 {
     //Generate new corner Pixmap
     int radius = qFloor(qMin(qMin(m_rect.width(), m_rect.height()) * 0.5, m_radius));
-    const auto width = qRound(radius * 2 * m_devicePixelRatio);
 
-    if (m_cornerPixmap.width() != width)
-        m_cornerPixmap = QPixmap(width, width);
+    //Most rectangles of a scene share a few styles, so share their corners as well
+    const CornerPixmapKey key { radius, m_devicePixelRatio, m_penWidth, m_penColor.rgba(),
+                                m_stops.isEmpty() ? m_brush.color().rgba() : QRgb(0) };
+    {
+        QMutexLocker locker(&cornerPixmapMutex);
+        if (const QPixmap *cached = cornerPixmaps()->object(key)) {
+            m_cornerPixmap = *cached;
+            return;
+        }
+    }
 
-    m_cornerPixmap.setDevicePixelRatio(m_devicePixelRatio);
-    m_cornerPixmap.fill(Qt::transparent);
+    const auto width = qRound(radius * 2 * m_devicePixelRatio);
+    QPixmap cornerPixmap(width, width);
+    cornerPixmap.setDevicePixelRatio(m_devicePixelRatio);
+    cornerPixmap.fill(Qt::transparent);
 
     if (radius > 0) {
-        QPainter cornerPainter(&m_cornerPixmap);
+        QPainter cornerPainter(&cornerPixmap);
         cornerPainter.setRenderHint(QPainter::Antialiasing);
         cornerPainter.setCompositionMode(QPainter::CompositionMode_Source);
 
@@ -563,6 +690,14 @@ void QSGSoftwareInternalRectangleNode::generateCornerPixmap()
         }
         cornerPainter.end();
     }
+
+    m_cornerPixmap = cornerPixmap;
+
+    const qsizetype cost = qMax(qsizetype(1), qsizetype(width) * width * cornerPixmap.depth() / 8 / 1024);
+    QMutexLocker locker(&cornerPixmapMutex);
+    if (cornerPixmaps()->isEmpty())
+        qAddPostRoutine(clearCornerPixmaps);
+    cornerPixmaps()->insert(key, new QPixmap(cornerPixmap), cost);
 }
 
 QT_END_NAMESPACE
@@ -45,8 +45,10 @@ public:
     void update() override;
 
     void paint(QPainter *);
+    void updateDevicePixelRatio(qreal devicePixelRatio);
 
     bool isOpaque() const;
+    QList<QRectF> opaqueRects() const;
     QRectF rect() const;
 private:
     void paintRectangle(QPainter *painter, const QRect &rect);
@@ -69,6 +71,7 @@ private:
 
     bool m_cornerPixmapIsDirty;
     QPixmap m_cornerPixmap;
+    QPixmap m_transformedPixmap;
 
     qreal m_devicePixelRatio;
 };
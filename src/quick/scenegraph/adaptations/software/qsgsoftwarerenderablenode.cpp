@@ -192,6 +192,20 @@ void QSGSoftwareRenderableNode::update()
     if (m_opacity < 1.0f)
         m_isOpaque = false;
 
+    // The area that hides everything behind the node. Rounded rectangles are not
+    // opaque as a whole, but still hide what is behind the inside of them.
+    m_opaqueRegion = QRegion();
+    if (m_isOpaque) {
+        m_opaqueRegion = m_boundingRectMin;
+    } else if (m_nodeType == Rectangle && m_opacity >= 1.0f && !m_transform.isRotating()
+               && !m_boundingRectMax.isEmpty()) {
+        const auto opaqueRects = m_handle.rectangleNode->opaqueRects();
+        for (const QRectF &rect : opaqueRects)
+            m_opaqueRegion += toRectMin(m_transform.mapRect(rect)).intersected(m_boundingRectMax);
+    }
+    if (m_hasClipRegion && m_clipRegion.rectCount() > 1)
+        m_opaqueRegion &= m_clipRegion;
+
     m_dirtyRegion = QRegion(m_boundingRectMax);
 }
 
@@ -250,12 +264,82 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
         }
     }
 
+    paint(painter, m_dirtyRegion, forceOpaquePainting);
+
+    return finishRendering();
+}
+
+/*!
+    \internal
+    Returns whether the node can be painted with renderTile() from a worker
+    thread, concurrently with other tiles. Anything the node lazily computes
+    when painting on a device with \a devicePixelRatio is computed here, on
+    the render thread.
+ */
+bool QSGSoftwareRenderableNode::prepareConcurrentRendering(qreal devicePixelRatio)
+{
+    switch (m_nodeType) {
+    case QSGSoftwareRenderableNode::SimpleRect:
+    case QSGSoftwareRenderableNode::SimpleTexture:
+    case QSGSoftwareRenderableNode::NinePatch:
+    case QSGSoftwareRenderableNode::SimpleRectangle:
+        return true;
+    case QSGSoftwareRenderableNode::Rectangle:
+        // Rotated rectangles are painted through temporary pixmaps
+        if (m_transform.isRotating())
+            return false;
+        m_handle.rectangleNode->updateDevicePixelRatio(devicePixelRatio);
+        return true;
+    default:
+        // Image nodes update their cached pixmaps, glyph nodes share the glyph
+        // cache of the font engine, and painter and render nodes may paint
+        // through the active painter of the render context.
+        return false;
+    }
+}
+
+/*!
+    \internal
+    Paints the part of the dirty region of the node that is inside \a tile.
+    The node state is left untouched, so that several tiles can be painted
+    concurrently. Call finishRendering() once all tiles are done.
+ */
+void QSGSoftwareRenderableNode::renderTile(QPainter *painter, const QRect &tile, bool forceOpaquePainting) const
+{
+    Q_ASSERT(painter);
+
+    if (!m_isDirty || qFuzzyIsNull(m_opacity))
+        return;
+
+    const QRegion region = m_dirtyRegion.intersected(tile);
+    if (!region.isEmpty())
+        paint(painter, region, forceOpaquePainting);
+}
+
+QRegion QSGSoftwareRenderableNode::finishRendering()
+{
+    if (!m_isDirty || qFuzzyIsNull(m_opacity) || m_dirtyRegion.isEmpty()) {
+        m_isDirty = false;
+        m_dirtyRegion = QRegion();
+        return QRegion();
+    }
+
+    QRegion areaToBeFlushed = m_dirtyRegion;
+    m_previousDirtyRegion = QRegion(m_boundingRectMax);
+    m_isDirty = false;
+    m_dirtyRegion = QRegion();
+
+    return areaToBeFlushed;
+}
+
+void QSGSoftwareRenderableNode::paint(QPainter *painter, const QRegion &region, bool forceOpaquePainting) const
+{
     painter->save();
     painter->setOpacity(m_opacity);
 
-    // Set clipRegion to m_dirtyRegion (in world coordinates, so must be done before the setTransform below)
+    // Set clipRegion to region (in world coordinates, so must be done before the setTransform below)
     // as m_dirtyRegion already accounts for clipRegion
-    painter->setClipRegion(m_dirtyRegion, Qt::ReplaceClip);
+    painter->setClipRegion(region, Qt::ReplaceClip);
     if (m_clipRegion.rectCount() > 1)
         painter->setClipRegion(m_clipRegion, Qt::IntersectClip);
 
@@ -310,13 +394,6 @@ QRegion QSGSoftwareRenderableNode::renderNode(QPainter *painter, bool forceOpaqu
     }
 
     painter->restore();
-
-    QRegion areaToBeFlushed = m_dirtyRegion;
-    m_previousDirtyRegion = QRegion(m_boundingRectMax);
-    m_isDirty = false;
-    m_dirtyRegion = QRegion();
-
-    return areaToBeFlushed;
 }
 
 bool QSGSoftwareRenderableNode::isDirtyRegionEmpty() const
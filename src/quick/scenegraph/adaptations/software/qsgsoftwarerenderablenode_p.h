@@ -62,8 +62,12 @@ public:
     void update();
 
     QRegion renderNode(QPainter *painter, bool forceOpaquePainting = false);
+    bool prepareConcurrentRendering(qreal devicePixelRatio);
+    void renderTile(QPainter *painter, const QRect &tile, bool forceOpaquePainting = false) const;
+    QRegion finishRendering();
     QRect boundingRectMin() const { return m_boundingRectMin; }
     QRect boundingRectMax() const { return m_boundingRectMax; }
+    QRegion opaqueRegion() const { return m_opaqueRegion; }
     NodeType type() const { return m_nodeType; }
     bool isOpaque() const { return m_isOpaque; }
     bool isDirty() const { return m_isDirty; }
@@ -87,6 +91,8 @@ public:
     QRegion dirtyRegion() const;
 
 private:
+    void paint(QPainter *painter, const QRegion &region, bool forceOpaquePainting) const;
+
     union RenderableNodeHandle {
         QSGNode *node;
         QSGSimpleRectNode *simpleRectNode;
@@ -118,6 +124,7 @@ private:
 
     QRect m_boundingRectMin;
     QRect m_boundingRectMax;
+    QRegion m_opaqueRegion;
 };
 
 QT_END_NAMESPACE
@@ -8,6 +8,7 @@
 #include "qsgsoftwarecontext_p.h"
 #include "qsgsoftwarerenderablenode_p.h"
 
+#include <QtGui/QImage>
 #include <QtGui/QPaintDevice>
 #include <QtGui/QBackingStore>
 #include <QElapsedTimer>
@@ -124,7 +125,9 @@ void QSGSoftwareRenderer::render()
     rc->m_activePainter = &painter;
 
     // Render the contents Renderlist
-    m_flushRegion = renderNodes(&painter);
+    // Raster images are split into tiles that are painted by several threads
+    QImage *image = paintDevice->devType() == QInternal::Image ? static_cast<QImage *>(paintDevice) : nullptr;
+    m_flushRegion = renderNodesTiled(&painter, image);
     qint64 renderTime = renderTimer.elapsed();
 
     painter.end();
@@ -728,6 +728,7 @@ bool QSGSoftwareThreadedRenderLoop::event(QEvent *e)
     if (e->type() == QEvent::Timer) {
         QTimerEvent *te = static_cast<QTimerEvent *>(e);
         if (te->timerId() == animationTimer) {
+            startIncubationFrame();
             m_anim->advance();
             emit timeToIncubate();
             return true;
@@ -914,6 +915,8 @@ void QSGSoftwareThreadedRenderLoop::polishAndSync(QSGSoftwareThreadedRenderLoop:
         return;
     }
 
+    startIncubationFrame();
+
     Q_TRACE_SCOPE(QSG_polishAndSync);
 
     Q_TRACE(QSG_polishItems_entry);
@@ -7,8 +7,14 @@
 
 #include <qmath.h>
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QtNumeric>
+#if QT_CONFIG(thread)
+#include <QtCore/QThread>
+#include <QtCore/QVarLengthArray>
+#endif
 
 #include <QtGui/QGuiApplication>
 
@@ -16,6 +22,11 @@
 #include "qsgmaterialshader_p.h"
 
 #include "qsgrhivisualizer_p.h"
+#include "qsgrhisupport_p.h"
+
+#if QT_CONFIG(thread)
+#include <private/qsgworkerpool_p.h>
+#endif
 
 #include <algorithm>
 
@@ -269,6 +280,92 @@ ShaderManager::Shader *ShaderManager::prepareMaterialNoRewrite(QSGMaterial *mate
     return shader;
 }
 
+// A stable identity of the shaders, render target and resource layout of a
+// pipeline. Unlike GraphicsPipelineStateKey this stays valid across runs.
+static QByteArray pipelineGroup(const ShaderManager::Shader *sms, const GraphicsPipelineStateKey &k)
+{
+    // Serializing the shaders is expensive, so it is only done once per shader
+    if (sms->stagesDigest.isEmpty()) {
+        QByteArray data;
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        for (const QRhiShaderStage &stage : sms->stages)
+            stream << quint32(stage.type()) << quint32(stage.shaderVariant()) << stage.shader().serialized();
+        sms->stagesDigest = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(sms->stagesDigest);
+    for (const QVector<quint32> *description : { &k.renderTargetDescription, &k.srbLayoutDescription }) {
+        const quint32 size = quint32(description->size());
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(&size), sizeof(size)));
+        hash.addData(QByteArrayView(reinterpret_cast<const char *>(description->constData()),
+                                    description->size() * sizeof(quint32)));
+    }
+    return hash.result();
+}
+
+static QByteArray pipelineDescription(const QByteArray &group, const GraphicsState &s)
+{
+    QByteArray description;
+    QDataStream stream(&description, QIODevice::WriteOnly);
+    stream << group << s.depthTest << s.depthWrite << quint32(s.depthFunc) << s.blending
+           << quint32(s.srcColor) << quint32(s.dstColor) << quint32(s.srcAlpha)
+           << quint32(s.dstAlpha) << quint32(s.opColor) << quint32(s.opAlpha)
+           << quint32(s.colorWrite.toInt()) << quint32(s.cullMode) << s.usesScissor
+           << s.stencilTest << qint32(s.sampleCount) << quint32(s.drawMode) << s.lineWidth
+           << quint32(s.polygonMode) << qint32(s.multiViewCount);
+    return description;
+}
+
+static bool parsePipelineDescription(const QByteArray &description, QByteArray *group, GraphicsState *s)
+{
+    QDataStream stream(description);
+    quint32 depthFunc, srcColor, dstColor, srcAlpha, dstAlpha, opColor, opAlpha, colorWrite;
+    quint32 cullMode, drawMode, polygonMode;
+    qint32 sampleCount, multiViewCount;
+    stream >> *group >> s->depthTest >> s->depthWrite >> depthFunc >> s->blending
+           >> srcColor >> dstColor >> srcAlpha >> dstAlpha >> opColor >> opAlpha
+           >> colorWrite >> cullMode >> s->usesScissor >> s->stencilTest >> sampleCount
+           >> drawMode >> s->lineWidth >> polygonMode >> multiViewCount;
+    if (stream.status() != QDataStream::Ok)
+        return false;
+
+    s->depthFunc = QRhiGraphicsPipeline::CompareOp(depthFunc);
+    s->srcColor = QRhiGraphicsPipeline::BlendFactor(srcColor);
+    s->dstColor = QRhiGraphicsPipeline::BlendFactor(dstColor);
+    s->srcAlpha = QRhiGraphicsPipeline::BlendFactor(srcAlpha);
+    s->dstAlpha = QRhiGraphicsPipeline::BlendFactor(dstAlpha);
+    s->opColor = QRhiGraphicsPipeline::BlendOp(opColor);
+    s->opAlpha = QRhiGraphicsPipeline::BlendOp(opAlpha);
+    s->colorWrite = QRhiGraphicsPipeline::ColorMask::fromInt(colorWrite);
+    s->cullMode = QRhiGraphicsPipeline::CullMode(cullMode);
+    s->sampleCount = sampleCount;
+    s->drawMode = QSGGeometry::DrawingMode(drawMode);
+    s->polygonMode = QRhiGraphicsPipeline::PolygonMode(polygonMode);
+    s->multiViewCount = multiViewCount;
+    return true;
+}
+
+/*
+    Returns the graphics states of the pipelines that were created for \a group
+    in earlier runs, and forgets about them.
+ */
+QList<GraphicsState> ShaderManager::takeRecordedPipelines(QRhi *rhi, const QByteArray &group)
+{
+    if (recordedPipelinesRhi != rhi) {
+        recordedPipelinesRhi = rhi;
+        recordedPipelines.clear();
+        const QList<QByteArray> descriptions = QSGRhiSupport::instance()->pipelineDescriptions(rhi);
+        for (const QByteArray &description : descriptions) {
+            QByteArray descriptionGroup;
+            GraphicsState state;
+            if (parsePipelineDescription(description, &descriptionGroup, &state))
+                recordedPipelines[descriptionGroup].append(state);
+        }
+    }
+    return recordedPipelines.take(group);
+}
+
 void ShaderManager::invalidated()
 {
     qDeleteAll(stockShaders);
@@ -279,6 +376,10 @@ void ShaderManager::invalidated()
     qDeleteAll(pipelineCache);
     pipelineCache.clear();
 
+    // the pipelines are gone, so create them up front again after reinitialization
+    recordedPipelinesRhi = nullptr;
+    recordedPipelines.clear();
+
     qDeleteAll(srbPool);
     srbPool.clear();
 }
@@ -422,7 +523,7 @@ void Updater::visitNode(Node *n)
             n->renderNodeElement()->root = m_roots.last();
         Q_FALLTHROUGH();    // to visit children
     default:
-        SHADOWNODE_TRAVERSE(n) visitNode(child);
+        visitChildren(n);
         break;
     }
 
@@ -431,6 +532,20 @@ void Updater::visitNode(Node *n)
     n->dirtyState = {};
 }
 
+void Updater::visitChildren(Node *n)
+{
+    // When nothing is inherited from n, only the children that changed or have
+    // changed descendants need a visit. That keeps the cost of a frame
+    // proportional to the number of changes instead of the size of the scene.
+    if (m_added == 0 && m_force_update == 0 && m_transformChange == 0 && m_opacityChange == 0) {
+        while (Node *child = n->takeDirtyChild())
+            visitNode(child);
+    } else {
+        while (n->takeDirtyChild()) { }
+        SHADOWNODE_TRAVERSE(n) visitNode(child);
+    }
+}
+
 void Updater::visitClipNode(Node *n)
 {
     ClipBatchRootInfo *extra = n->clipInfo();
@@ -448,7 +563,7 @@ void Updater::visitClipNode(Node *n)
     cn->setRendererMatrix(&extra->matrix);
     m_combined_matrix_stack << &m_identityMatrix;
 
-    SHADOWNODE_TRAVERSE(n) visitNode(child);
+    visitChildren(n);
 
     m_current_clip = cn->clipList();
     m_rootMatrices.pop_back();
@@ -472,12 +587,12 @@ void Updater::visitOpacityNode(Node *n)
             n->isOpaque = is;
         }
         ++m_opacityChange;
-        SHADOWNODE_TRAVERSE(n) visitNode(child);
+        visitChildren(n);
         --m_opacityChange;
     } else {
         if (m_added > 0)
             n->isOpaque = on->opacity() > OPAQUE_LIMIT;
-        SHADOWNODE_TRAVERSE(n) visitNode(child);
+        visitChildren(n);
     }
 
     m_opacity_stack.pop_back();
@@ -527,7 +642,7 @@ void Updater::visitTransformNode(Node *n)
     if (dirty)
         ++m_transformChange;
 
-    SHADOWNODE_TRAVERSE(n) visitNode(child);
+    visitChildren(n);
 
     if (dirty)
         --m_transformChange;
@@ -582,7 +697,7 @@ void Updater::visitGeometryNode(Node *n)
         }
     }
 
-    SHADOWNODE_TRAVERSE(n) visitNode(child);
+    visitChildren(n);
 }
 
 void Updater::updateRootTransforms(Node *node, Node *root, const QMatrix4x4 &combined)
@@ -890,10 +1005,18 @@ Renderer::Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMod
     m_batchNodeThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_NODE_THRESHOLD", 64);
     m_batchVertexThreshold = qt_sg_envInt("QSG_RENDERER_BATCH_VERTEX_THRESHOLD", 1024);
     m_srbPoolThreshold = qt_sg_envInt("QSG_RENDERER_SRB_POOL_THRESHOLD", 1024);
+#if QT_CONFIG(thread)
+    m_uploadThreadCount = qt_sg_envInt("QSG_RENDERER_UPLOAD_THREADS", QThread::idealThreadCount());
+#else
+    m_uploadThreadCount = 1;
+#endif
+    m_uploadParallelThreshold = qt_sg_envInt("QSG_RENDERER_UPLOAD_PARALLEL_THRESHOLD", 256 * 1024);
 
     if (Q_UNLIKELY(debug_build() || debug_render())) {
         qDebug("Batch thresholds: nodes: %d vertices: %d Srb pool threshold: %d",
                m_batchNodeThreshold, m_batchVertexThreshold, m_srbPoolThreshold);
+        qDebug("Upload threads: %d parallel threshold: %d bytes",
+               m_uploadThreadCount, m_uploadParallelThreshold);
     }
 }
 
@@ -1089,6 +1212,8 @@ void Renderer::unmap(Buffer *buffer, bool isIndexBuf)
         }
     }
     if (buffer->buf) {
+        if (!isIndexBuf)
+            m_uploadedVertexBytes += buffer->size;
         if (buffer->buf->type() != QRhiBuffer::Dynamic) {
             m_resourceUpdates->uploadStaticBuffer(buffer->buf, 0, buffer->size, buffer->data);
             buffer->nonDynamicChangeCount += 1;
@@ -1189,7 +1314,8 @@ void Renderer::nodeWasTransformed(Node *node, int *vertexCount)
                 if (!e->batch->isOpaque) {
                     invalidateBatchAndOverlappingRenderOrders(e->batch);
                 } else if (e->batch->merged) {
-                    e->batch->needsUpload = true;
+                    e->needsVertexUpload = true;
+                    e->batch->needsVertexUpload = true;
                 }
             }
         }
@@ -1449,9 +1575,15 @@ void Renderer::nodeChanged(QSGNode *node, QSGNode::DirtyState state)
                                               | QSGNode::DirtyForceUpdate);
     if (dirtyChain != 0) {
         dirtyChain = QSGNode::DirtyState(dirtyChain << 16);
+        Node *child = shadowNode;
         Node *sn = shadowNode->parent();
         while (sn) {
+            // Everything above was marked by an earlier change already
+            if (child->isInDirtyList && (sn->dirtyState & dirtyChain) == dirtyChain)
+                break;
             sn->dirtyState |= dirtyChain;
+            sn->addDirtyChild(child);
+            child = sn;
             sn = sn->parent();
         }
     }
@@ -1944,28 +2076,11 @@ void Renderer::uploadMergedElement(Element *e, int vaOffset, char **vertexData,
     if (Q_UNLIKELY(debug_upload())) qDebug() << "  - uploading element:" << e << e->node << (void *) *vertexData << (qintptr) (*zData - *vertexData) << (qintptr) (*indexData - *vertexData);
     QSGGeometry *g = e->node->geometry();
 
-    const QMatrix4x4 &localx = *e->node->matrix();
-    const float *localxdata = localx.constData();
-
     const int vCount = g->vertexCount();
     const int vSize = g->sizeOfVertex();
-    memcpy(*vertexData, g->vertexData(), vSize * vCount);
-
-    // apply vertex transform..
-    char *vdata = *vertexData + vaOffset;
-    if (localx.flags() == QMatrix4x4::Translation) {
-        for (int i=0; i<vCount; ++i) {
-            Pt *p = (Pt *) vdata;
-            p->x += localxdata[12];
-            p->y += localxdata[13];
-            vdata += vSize;
-        }
-    } else if (localx.flags() > QMatrix4x4::Translation) {
-        for (int i=0; i<vCount; ++i) {
-            ((Pt *) vdata)->map(localx);
-            vdata += vSize;
-        }
-    }
+    e->vertexOffset = quint32(*vertexData - e->batch->vbo.data);
+    e->needsVertexUpload = false;
+    writeMergedVertices(e, vaOffset, *vertexData);
 
     if (useDepthBuffer()) {
         float *vzorder = (float *) *zData;
@@ -2040,6 +2155,126 @@ void Renderer::uploadMergedElement(Element *e, int vaOffset, char **vertexData,
     *indexCount += iCount;
 }
 
+/* Writes the vertices of the element, transformed to the batch root, to
+   vertexData.
+ */
+void Renderer::writeMergedVertices(Element *e, int vaOffset, char *vertexData)
+{
+    QSGGeometry *g = e->node->geometry();
+
+    const QMatrix4x4 &localx = *e->node->matrix();
+    const float *localxdata = localx.constData();
+
+    const int vCount = g->vertexCount();
+    const int vSize = g->sizeOfVertex();
+    memcpy(vertexData, g->vertexData(), vSize * vCount);
+
+    // apply vertex transform..
+    char *vdata = vertexData + vaOffset;
+    if (localx.flags() == QMatrix4x4::Translation) {
+        for (int i=0; i<vCount; ++i) {
+            Pt *p = (Pt *) vdata;
+            p->x += localxdata[12];
+            p->y += localxdata[13];
+            vdata += vSize;
+        }
+    } else if (localx.flags() > QMatrix4x4::Translation) {
+        for (int i=0; i<vCount; ++i) {
+            ((Pt *) vdata)->map(localx);
+            vdata += vSize;
+        }
+    }
+}
+
+/* Uploads only the vertices of the elements of a merged batch that were
+   transformed since the batch was last uploaded. The rest of the vertex data,
+   the z data and the index data stay valid, as they only depend on the
+   geometry and the order of the elements. Returns false when the batch needs
+   a full upload instead.
+
+   Repeated nodes are not drawn with instanced draw calls: materials read
+   their transform from the uniform buffer, so a per-instance transform would
+   need another shader variant of every material, custom ones included.
+   Merged batches already draw such nodes in a single call, this keeps the
+   upload cost proportional to the number of nodes that moved.
+ */
+bool Renderer::uploadChangedVertices(Batch *b)
+{
+    if (!b->needsVertexUpload)
+        return false;
+    b->needsVertexUpload = false;
+    if (b->needsUpload)
+        return false;
+
+    bool canUpdate = b->merged && b->first && b->vbo.buf
+            && m_visualizer->mode() == Visualizer::VisualizeNothing;
+    const quint32 vertexDataSize = canUpdate ? b->vertexCount * b->first->node->geometry()->sizeOfVertex() : 0;
+    const QSGMaterial::Flags flags = canUpdate ? b->first->node->activeMaterial()->flags() : QSGMaterial::Flags();
+
+    // The new transforms may prevent merging, see prepareBatchUpload()
+    for (Element *e = b->first; canUpdate && e; e = e->nextInBatch) {
+        if (!e->needsVertexUpload)
+            continue;
+        e->ensureBoundsValid();
+        const QSGGeometry *eg = e->node->geometry();
+        canUpdate = !e->boundsOutsideFloatRange
+                && is2DSafe(*e->node->matrix())
+                && ((flags & QSGMaterial::RequiresFullMatrixExceptTranslate) == 0 || e->translateOnlyToRoot)
+                && e->vertexOffset + eg->vertexCount() * eg->sizeOfVertex() <= vertexDataSize;
+    }
+    if (!canUpdate) {
+        b->needsUpload = true;
+        return false;
+    }
+
+    // Partial uploads count as changes of a static buffer just like full ones do, so that a
+    // batch whose elements keep moving gets a dynamic buffer from unmap() eventually.
+    if (b->vbo.buf->type() != QRhiBuffer::Dynamic
+            && ++b->vbo.nonDynamicChangeCount > DYNAMIC_VERTEX_INDEX_BUFFER_THRESHOLD) {
+        b->needsUpload = true;
+        return false;
+    }
+
+    if (vertexDataSize > quint32(m_vertexUploadPool.size()))
+        m_vertexUploadPool.resize(vertexDataSize);
+    char *vertexData = m_vertexUploadPool.data();
+
+    // Neighbouring elements are uploaded in one go
+    quint32 rangeStart = 0;
+    quint32 rangeEnd = 0;
+    const auto uploadRange = [&] {
+        if (rangeEnd == rangeStart)
+            return;
+        m_uploadedVertexBytes += rangeEnd - rangeStart;
+        if (b->vbo.buf->type() == QRhiBuffer::Dynamic) {
+            m_resourceUpdates->updateDynamicBuffer(b->vbo.buf, rangeStart, rangeEnd - rangeStart,
+                                                   vertexData + rangeStart);
+        } else {
+            m_resourceUpdates->uploadStaticBuffer(b->vbo.buf, rangeStart, rangeEnd - rangeStart,
+                                                  vertexData + rangeStart);
+        }
+    };
+
+    for (Element *e = b->first; e; e = e->nextInBatch) {
+        if (!e->needsVertexUpload)
+            continue;
+        e->needsVertexUpload = false;
+        if (e->vertexOffset != rangeEnd) {
+            uploadRange();
+            rangeStart = e->vertexOffset;
+        }
+        writeMergedVertices(e, b->positionAttribute, vertexData + e->vertexOffset);
+        const QSGGeometry *eg = e->node->geometry();
+        rangeEnd = e->vertexOffset + eg->vertexCount() * eg->sizeOfVertex();
+    }
+    uploadRange();
+
+    if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "uploaded transformed elements only...";
+    if (Q_UNLIKELY(debug_render()))
+        b->uploadedThisFrame = true;
+    return true;
+}
+
 QMatrix4x4 qsg_matrixForRoot(Node *node)
 {
     if (node->type() == QSGNode::TransformNodeType)
@@ -2050,21 +2285,41 @@ QMatrix4x4 qsg_matrixForRoot(Node *node)
 }
 
 void Renderer::uploadBatch(Batch *b)
+{
+    if (uploadChangedVertices(b))
+        return;
+
+    quint32 vertexBufferSize;
+    quint32 indexBufferSize;
+    if (!prepareBatchUpload(b, &vertexBufferSize, &indexBufferSize))
+        return;
+
+    map(&b->ibo, indexBufferSize, true);
+    map(&b->vbo, vertexBufferSize);
+
+    fillBatchBuffers(b);
+    finishBatchUpload(b);
+}
+
+/* Decides whether the batch is merged and computes the sizes of its vertex
+   and index data. Returns false if there is nothing to upload.
+ */
+bool Renderer::prepareBatchUpload(Batch *b, quint32 *vertexBufferSize, quint32 *indexBufferSize)
 {
     // Early out if nothing has changed in this batch..
     if (!b->needsUpload) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "already uploaded...";
-        return;
+        return false;
     }
 
     if (!b->first) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch:" << b << "is invalid...";
-        return;
+        return false;
     }
 
     if (b->isRenderNode) {
         if (Q_UNLIKELY(debug_upload())) qDebug() << " Batch: " << b << "is a render node...";
-        return;
+        return false;
     }
 
     // Figure out if we can merge or not, if not, then just render the batch as is..
@@ -2111,7 +2366,7 @@ void Renderer::uploadBatch(Batch *b)
     // Abort if there are no vertices in this batch.. We abort this late as
     // this is a broken usecase which we do not care to optimize for...
     if (b->vertexCount == 0 || (b->merged && b->indexCount == 0))
-        return;
+        return false;
 
     /* Allocate memory for this batch. Merged batches are divided into three separate blocks
            1. Vertex data for all elements, as they were in the QSGGeometry object, but
@@ -2135,8 +2390,18 @@ void Renderer::uploadBatch(Batch *b)
         ibufferSize = unmergedIndexSize;
     }
 
-    map(&b->ibo, ibufferSize, true);
-    map(&b->vbo, bufferSize);
+    *vertexBufferSize = bufferSize;
+    *indexBufferSize = ibufferSize;
+    return true;
+}
+
+/* Writes the vertex and index data of the batch to its mapped buffers. This
+   only touches the batch and the geometry of its elements, so different
+   batches can be filled concurrently.
+ */
+void Renderer::fillBatchBuffers(Batch *b)
+{
+    QSGGeometry *g = b->first->node->geometry();
 
     if (Q_UNLIKELY(debug_upload())) qDebug() << " - batch" << b << " first:" << b->first << " root:"
                                              << b->root << " merged:" << b->merged << " positionAttribute" << b->positionAttribute
@@ -2149,7 +2414,7 @@ void Renderer::uploadBatch(Batch *b)
 
         quint16 iOffset16 = 0;
         quint32 iOffset32 = 0;
-        e = b->first;
+        Element *e = b->first;
         uint verticesInSet = 0;
         // Start a new set already after 65534 vertices because 0xFFFF may be
         // used for an always-on primitive restart with some apis (adapt for
@@ -2199,6 +2464,7 @@ void Renderer::uploadBatch(Batch *b)
             int vbs = g->vertexCount() * g->sizeOfVertex();
             memcpy(vboData, g->vertexData(), vbs);
             vboData = vboData + vbs;
+            e->needsVertexUpload = false;
             const int indexCount = g->indexCount();
             if (indexCount) {
                 const int effectiveIndexSize = m_uint32IndexForRhi ? sizeof(quint32) : g->sizeOfIndex();
@@ -2284,7 +2550,10 @@ void Renderer::uploadBatch(Batch *b)
         }
     }
 #endif // QT_NO_DEBUG_OUTPUT
+}
 
+void Renderer::finishBatchUpload(Batch *b)
+{
     unmap(&b->vbo);
     unmap(&b->ibo, true);
 
@@ -2296,6 +2565,87 @@ void Renderer::uploadBatch(Batch *b)
         b->uploadedThisFrame = true;
 }
 
+#if QT_CONFIG(thread)
+/* Estimates the vertex data of the batches that need a full upload this
+   frame, without deciding whether they are merged yet.
+ */
+qsizetype Renderer::pendingVertexUploadSize() const
+{
+    qsizetype size = 0;
+    for (const QDataBuffer<Batch *> *batches : { &m_opaqueBatches, &m_alphaBatches }) {
+        for (int i = 0; i < batches->size(); ++i) {
+            const Batch *b = batches->at(i);
+            if (!b->needsUpload || b->isRenderNode)
+                continue;
+            for (const Element *e = b->first; e; e = e->nextInBatch) {
+                const QSGGeometry *g = e->node->geometry();
+                size += qsizetype(g->vertexCount()) * g->sizeOfVertex();
+            }
+        }
+    }
+    return size;
+}
+
+/* Uploads all opaque and alpha batches like uploadBatch() does, but fills
+   the vertex and index data of different batches on several threads.
+
+   Each batch gets its own, aligned, slice of the shared upload pools, so
+   the fill jobs never write to the same memory. Everything that talks to
+   QRhi, mapping and unmapping the buffers, stays on the render thread.
+ */
+void Renderer::uploadBatchesConcurrently()
+{
+    struct Upload {
+        Batch *batch;
+        quint32 vertexOffset;
+        quint32 vertexSize;
+        quint32 indexOffset;
+        quint32 indexSize;
+    };
+    QVarLengthArray<Upload, 64> uploads;
+    quint32 vertexPoolSize = 0;
+    quint32 indexPoolSize = 0;
+    const auto align = [](quint32 size) { return (size + 15) & ~quint32(15); };
+
+    if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Opaque and Alpha Batches:");
+    for (const QDataBuffer<Batch *> *batches : { &m_opaqueBatches, &m_alphaBatches }) {
+        for (int i = 0; i < batches->size(); ++i) {
+            Batch *b = batches->at(i);
+            if (uploadChangedVertices(b))
+                continue;
+            Upload upload = { b, vertexPoolSize, 0, indexPoolSize, 0 };
+            if (!prepareBatchUpload(b, &upload.vertexSize, &upload.indexSize))
+                continue;
+            vertexPoolSize += align(upload.vertexSize);
+            indexPoolSize += align(upload.indexSize);
+            uploads.append(upload);
+        }
+    }
+
+    if (uploads.isEmpty())
+        return;
+
+    if (vertexPoolSize > quint32(m_vertexUploadPool.size()))
+        m_vertexUploadPool.resize(vertexPoolSize);
+    if (indexPoolSize > quint32(m_indexUploadPool.size()))
+        m_indexUploadPool.resize(indexPoolSize);
+
+    for (const Upload &upload : std::as_const(uploads)) {
+        upload.batch->vbo.data = m_vertexUploadPool.data() + upload.vertexOffset;
+        upload.batch->vbo.size = upload.vertexSize;
+        upload.batch->ibo.data = m_indexUploadPool.data() + upload.indexOffset;
+        upload.batch->ibo.size = upload.indexSize;
+    }
+
+    QSGWorkerPool::run(uploads.size(), m_uploadThreadCount, [&](qsizetype i) {
+        fillBatchBuffers(uploads.at(i).batch);
+    });
+
+    for (const Upload &upload : std::as_const(uploads))
+        finishBatchUpload(upload.batch);
+}
+#endif
+
 void Renderer::applyClipStateToGraphicsState()
 {
     m_gstate.usesScissor = (m_currentClipState.type & ClipState::ScissorClip);
@@ -2702,45 +3052,63 @@ bool Renderer::ensurePipelineState(Element *e, const ShaderManager::Shader *sms,
     }
 
     // Build a new one. This is potentially expensive.
+    QRhiGraphicsPipeline *ps = buildPipelineState(m_gstate, sms, e->srb);
+    if (!ps)
+        return false;
+
+    m_shaderManager->pipelineCache.insert(k, ps);
+    if (depthPostPass)
+        e->depthPostPassPs = ps;
+    else
+        e->ps = ps;
+
+    createRecordedPipelines(k, sms, e->srb);
+    return true;
+}
+
+QRhiGraphicsPipeline *Renderer::buildPipelineState(const GraphicsState &state,
+                                                   const ShaderManager::Shader *sms,
+                                                   QRhiShaderResourceBindings *srb)
+{
     QRhiGraphicsPipeline *ps = m_rhi->newGraphicsPipeline();
     ps->setShaderStages(sms->stages.cbegin(), sms->stages.cend());
     ps->setVertexInputLayout(sms->inputLayout);
-    ps->setShaderResourceBindings(e->srb);
+    ps->setShaderResourceBindings(srb);
     ps->setRenderPassDescriptor(renderTarget().rpDesc);
 
     QRhiGraphicsPipeline::Flags flags;
-    if (needsBlendConstant(m_gstate.srcColor) || needsBlendConstant(m_gstate.dstColor)
-            || needsBlendConstant(m_gstate.srcAlpha) || needsBlendConstant(m_gstate.dstAlpha))
+    if (needsBlendConstant(state.srcColor) || needsBlendConstant(state.dstColor)
+            || needsBlendConstant(state.srcAlpha) || needsBlendConstant(state.dstAlpha))
     {
         flags |= QRhiGraphicsPipeline::UsesBlendConstants;
     }
-    if (m_gstate.usesScissor)
+    if (state.usesScissor)
         flags |= QRhiGraphicsPipeline::UsesScissor;
-    if (m_gstate.stencilTest)
+    if (state.stencilTest)
         flags |= QRhiGraphicsPipeline::UsesStencilRef;
 
     ps->setFlags(flags);
-    ps->setTopology(qsg_topology(m_gstate.drawMode));
-    ps->setCullMode(m_gstate.cullMode);
-    ps->setPolygonMode(m_gstate.polygonMode);
-    ps->setMultiViewCount(m_gstate.multiViewCount);
+    ps->setTopology(qsg_topology(state.drawMode));
+    ps->setCullMode(state.cullMode);
+    ps->setPolygonMode(state.polygonMode);
+    ps->setMultiViewCount(state.multiViewCount);
 
     QRhiGraphicsPipeline::TargetBlend blend;
-    blend.colorWrite = m_gstate.colorWrite;
-    blend.enable = m_gstate.blending;
-    blend.srcColor = m_gstate.srcColor;
-    blend.dstColor = m_gstate.dstColor;
-    blend.srcAlpha = m_gstate.srcAlpha;
-    blend.dstAlpha = m_gstate.dstAlpha;
-    blend.opColor = m_gstate.opColor;
-    blend.opAlpha = m_gstate.opAlpha;
+    blend.colorWrite = state.colorWrite;
+    blend.enable = state.blending;
+    blend.srcColor = state.srcColor;
+    blend.dstColor = state.dstColor;
+    blend.srcAlpha = state.srcAlpha;
+    blend.dstAlpha = state.dstAlpha;
+    blend.opColor = state.opColor;
+    blend.opAlpha = state.opAlpha;
     ps->setTargetBlends({ blend });
 
-    ps->setDepthTest(m_gstate.depthTest);
-    ps->setDepthWrite(m_gstate.depthWrite);
-    ps->setDepthOp(m_gstate.depthFunc);
+    ps->setDepthTest(state.depthTest);
+    ps->setDepthWrite(state.depthWrite);
+    ps->setDepthOp(state.depthFunc);
 
-    if (m_gstate.stencilTest) {
+    if (state.stencilTest) {
         ps->setStencilTest(true);
         QRhiGraphicsPipeline::StencilOpState stencilOp;
         stencilOp.compareOp = QRhiGraphicsPipeline::Equal;
@@ -2751,24 +3119,47 @@ bool Renderer::ensurePipelineState(Element *e, const ShaderManager::Shader *sms,
         ps->setStencilBack(stencilOp);
     }
 
-    ps->setSampleCount(m_gstate.sampleCount);
+    ps->setSampleCount(state.sampleCount);
 
-    ps->setLineWidth(m_gstate.lineWidth);
+    ps->setLineWidth(state.lineWidth);
 
     if (!ps->create()) {
         qWarning("Failed to build graphics pipeline state");
         delete ps;
-        return false;
+        return nullptr;
     }
 
-    m_shaderManager->pipelineCache.insert(k, ps);
-    if (depthPostPass)
-        e->depthPostPassPs = ps;
-    else
-        e->ps = ps;
-    return true;
+    return ps;
 }
 
+// The first pipeline for a combination of shaders, render target and resource
+// layout also creates the pipelines with the same combination that earlier runs
+// needed. These are then ready when a later scene needs them, instead of
+// stalling that frame. The pipeline cache data from disk makes this cheap.
+void Renderer::createRecordedPipelines(const GraphicsPipelineStateKey &k,
+                                       const ShaderManager::Shader *sms,
+                                       QRhiShaderResourceBindings *srb)
+{
+    const QByteArray group = pipelineGroup(sms, k);
+    QSGRhiSupport::instance()->addPipelineDescription(m_rhi, pipelineDescription(group, k.state));
+
+    const QList<GraphicsState> states = m_shaderManager->takeRecordedPipelines(m_rhi, group);
+    for (const GraphicsState &state : states) {
+        // these have to match the render target
+        if (state.sampleCount != k.state.sampleCount || state.multiViewCount != k.state.multiViewCount)
+            continue;
+
+        GraphicsPipelineStateKey recorded = k;
+        recorded.state = state;
+        if (m_shaderManager->pipelineCache.contains(recorded))
+            continue;
+
+        if (QRhiGraphicsPipeline *ps = buildPipelineState(state, sms, srb))
+            m_shaderManager->pipelineCache.insert(recorded, ps);
+    }
+}
+
+
 static QRhiSampler *newSampler(QRhi *rhi, const QSGSamplerDescription &desc)
 {
     QRhiSampler::Filter magFilter;
@@ -3661,9 +4052,13 @@ void Renderer::render()
         return;
 
     prepareRenderPass(&m_mainRenderPassContext);
+
+    QElapsedTimer recordTimer;
+    recordTimer.start();
     beginRenderPass(&m_mainRenderPassContext);
     recordRenderPass(&m_mainRenderPassContext);
     endRenderPass(&m_mainRenderPassContext);
+    m_lastRecordTime = recordTimer.nsecsElapsed();
 }
 
 // An alternative to render() is to call prepareInline() and renderInline() at
@@ -3807,19 +4202,30 @@ void Renderer::prepareRenderPass(RenderPassContext *ctx)
     m_vertexUploadPool.reset();
     m_indexUploadPool.reset();
 
-    if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Opaque Batches:");
-    for (int i=0; i<m_opaqueBatches.size(); ++i) {
-        Batch *b = m_opaqueBatches.at(i);
-        uploadBatch(b);
-    }
-    if (Q_UNLIKELY(debug_render())) ctx->timeUploadOpaque = ctx->timer.restart();
+#if QT_CONFIG(thread)
+    // Small scenes are done faster than it takes to wake up the workers
+    if (m_uploadThreadCount > 1 && m_visualizer->mode() == Visualizer::VisualizeNothing
+            && pendingVertexUploadSize() >= m_uploadParallelThreshold) {
+        // Reported as part of the opaque upload time
+        uploadBatchesConcurrently();
+        if (Q_UNLIKELY(debug_render())) ctx->timeUploadOpaque = ctx->timer.restart();
+    } else
+#endif
+    {
+        if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Opaque Batches:");
+        for (int i=0; i<m_opaqueBatches.size(); ++i) {
+            Batch *b = m_opaqueBatches.at(i);
+            uploadBatch(b);
+        }
+        if (Q_UNLIKELY(debug_render())) ctx->timeUploadOpaque = ctx->timer.restart();
 
-    if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Alpha Batches:");
-    for (int i=0; i<m_alphaBatches.size(); ++i) {
-        Batch *b = m_alphaBatches.at(i);
-        uploadBatch(b);
+        if (Q_UNLIKELY(debug_upload())) qDebug("Uploading Alpha Batches:");
+        for (int i=0; i<m_alphaBatches.size(); ++i) {
+            Batch *b = m_alphaBatches.at(i);
+            uploadBatch(b);
+        }
+        if (Q_UNLIKELY(debug_render())) ctx->timeUploadAlpha = ctx->timer.restart();
     }
-    if (Q_UNLIKELY(debug_render())) ctx->timeUploadAlpha = ctx->timer.restart();
 
     if (Q_UNLIKELY(debug_render())) {
         qDebug().nospace() << "Rendering:" << Qt::endl
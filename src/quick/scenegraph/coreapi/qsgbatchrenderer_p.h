@@ -276,6 +276,7 @@ struct Element {
         , orphaned(false)
         , isRenderNode(false)
         , isMaterialBlended(false)
+        , needsVertexUpload(false)
     {
     }
 
@@ -298,6 +299,8 @@ struct Element {
     Rect bounds; // in device coordinates
 
     int order = 0;
+    // where the vertices of this element start in a merged batch's vertex buffer
+    quint32 vertexOffset = 0;
     QRhiShaderResourceBindings *srb = nullptr;
     QRhiGraphicsPipeline *ps = nullptr;
     QRhiGraphicsPipeline *depthPostPassPs = nullptr;
@@ -309,6 +312,7 @@ struct Element {
     uint orphaned : 1;
     uint isRenderNode : 1;
     uint isMaterialBlended : 1;
+    uint needsVertexUpload : 1;
 };
 
 struct RenderNodeElement : public Element {
@@ -419,6 +423,7 @@ struct Batch
         indexCount = 0;
         isOpaque = false;
         needsUpload = false;
+        needsVertexUpload = false;
         merged = false;
         positionAttribute = -1;
         uploadedThisFrame = false;
@@ -441,6 +446,7 @@ struct Batch
 
     uint isOpaque : 1;
     uint needsUpload : 1;
+    uint needsVertexUpload : 1; // only the vertices of some elements changed
     uint merged : 1;
     uint isRenderNode : 1;
     uint ubufDataValid : 1;
@@ -507,6 +513,15 @@ struct Node
         child->m_next = nullptr;
         child->m_prev = nullptr;
         child->setParent(nullptr);
+
+        if (child->isInDirtyList) {
+            Node **link = &m_dirtyChild;
+            while (*link != child)
+                link = &(*link)->m_nextDirty;
+            *link = child->m_nextDirty;
+            child->m_nextDirty = nullptr;
+            child->isInDirtyList = false;
+        }
     }
 
     Node *firstChild() const { return m_child; }
@@ -528,13 +543,36 @@ struct Node
         return n;
     }
 
+    // Children that changed, or have changed descendants, since the last
+    // Updater pass. This lets the Updater skip clean siblings.
+    void addDirtyChild(Node *child) {
+        Q_ASSERT(child->m_parent == this);
+        if (child->isInDirtyList)
+            return;
+        child->m_nextDirty = m_dirtyChild;
+        child->isInDirtyList = true;
+        m_dirtyChild = child;
+    }
+
+    Node *takeDirtyChild() {
+        Node *child = m_dirtyChild;
+        if (child) {
+            m_dirtyChild = child->m_nextDirty;
+            child->m_nextDirty = nullptr;
+            child->isInDirtyList = false;
+        }
+        return child;
+    }
 
+    Node *m_dirtyChild;
+    Node *m_nextDirty;
 
     QSGNode::DirtyState dirtyState;
 
     uint isOpaque : 1;
     uint isBatchRoot : 1;
     uint becameBatchRoot : 1;
+    uint isInDirtyList : 1;
 
     inline QSGNode::NodeType type() const { return sgNode->type(); }
 
@@ -574,6 +612,7 @@ public:
 
     void updateStates(QSGNode *n) override;
     void visitNode(Node *n);
+    void visitChildren(Node *n);
     void registerWithParentRoot(QSGNode *subRoot, QSGNode *parentRoot);
 
 private:
@@ -663,6 +702,8 @@ struct ShaderManagerShader
     QRhiVertexInputLayout inputLayout;
     QVarLengthArray<QRhiShaderStage, 2> stages;
     float lastOpacity;
+    // identifies the stages across runs, computed when first needed
+    mutable QByteArray stagesDigest;
 };
 
 class ShaderManager : public QObject
@@ -697,10 +738,17 @@ public:
                                      QSGRendererInterface::RenderMode renderMode = QSGRendererInterface::RenderMode2D,
                                      int multiViewCount = 0);
 
+    QList<GraphicsState> takeRecordedPipelines(QRhi *rhi, const QByteArray &group);
+
 private:
     QHash<ShaderKey, Shader *> rewrittenShaders;
     QHash<ShaderKey, Shader *> stockShaders;
 
+    // Pipelines recorded in earlier runs that were not created yet, grouped
+    // by shaders, render target and resource layout.
+    QRhi *recordedPipelinesRhi = nullptr;
+    QHash<QByteArray, QList<GraphicsState>> recordedPipelines;
+
     QSGDefaultRenderContext *context;
 };
 
@@ -748,6 +796,9 @@ public:
     Renderer(QSGDefaultRenderContext *ctx, QSGRendererInterface::RenderMode renderMode = QSGRendererInterface::RenderMode2D);
     ~Renderer();
 
+    // Bytes handed to vertex buffer uploads so far, for autotests
+    quint64 uploadedVertexBytes() const { return m_uploadedVertexBytes; }
+
 protected:
     void nodeChanged(QSGNode *node, QSGNode::DirtyState state) override;
     void render() override;
@@ -812,9 +863,24 @@ private:
     void invalidateBatchAndOverlappingRenderOrders(Batch *batch);
 
     void uploadBatch(Batch *b);
+    bool prepareBatchUpload(Batch *b, quint32 *vertexBufferSize, quint32 *indexBufferSize);
+    void fillBatchBuffers(Batch *b);
+    void finishBatchUpload(Batch *b);
+#if QT_CONFIG(thread)
+    qsizetype pendingVertexUploadSize() const;
+    void uploadBatchesConcurrently();
+#endif
     void uploadMergedElement(Element *e, int vaOffset, char **vertexData, char **zData, char **indexData, void *iBasePtr, int *indexCount);
+    void writeMergedVertices(Element *e, int vaOffset, char *vertexData);
+    bool uploadChangedVertices(Batch *b);
 
     bool ensurePipelineState(Element *e, const ShaderManager::Shader *sms, bool depthPostPass = false);
+    QRhiGraphicsPipeline *buildPipelineState(const GraphicsState &state,
+                                             const ShaderManager::Shader *sms,
+                                             QRhiShaderResourceBindings *srb);
+    void createRecordedPipelines(const GraphicsPipelineStateKey &k,
+                                 const ShaderManager::Shader *sms,
+                                 QRhiShaderResourceBindings *srb);
     QRhiTexture *dummyTexture();
     void updateMaterialDynamicData(ShaderManager::Shader *sms, QSGMaterialShader::RenderState &renderState,
                                    QSGMaterial *material, const Batch *batch, Element *e, int ubufOffset, int ubufRegionSize,
@@ -891,6 +957,8 @@ private:
     int m_batchNodeThreshold;
     int m_batchVertexThreshold;
     int m_srbPoolThreshold;
+    int m_uploadThreadCount;
+    int m_uploadParallelThreshold;
 
     Visualizer *m_visualizer;
 
@@ -902,6 +970,7 @@ private:
 
     QDataBuffer<char> m_vertexUploadPool;
     QDataBuffer<char> m_indexUploadPool;
+    quint64 m_uploadedVertexBytes = 0;
 
     Allocator<Node, 256> m_nodeAllocator;
     Allocator<Element, 64> m_elementAllocator;
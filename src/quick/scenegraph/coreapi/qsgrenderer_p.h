@@ -89,6 +89,9 @@ public:
 
     void clearChangedFlag() { m_changed_emitted = false; }
 
+    // Time spent recording the main render pass in the last render(), in nanoseconds.
+    qint64 lastRecordTime() const { return m_lastRecordTime; }
+
     // Accessed by QSGMaterialShader::RenderState.
     QByteArray *currentUniformData() const { return m_current_uniform_data; }
     QRhiResourceUpdateBatch *currentResourceUpdateBatch() const { return m_current_resource_update_batch; }
@@ -135,6 +138,7 @@ protected:
         QSGRenderContext::RenderPassCallback end = nullptr;
         void *userData = nullptr;
     } m_renderPassRecordingCallbacks;
+    qint64 m_lastRecordTime = 0;
 
 private:
     QSGNodeUpdater *m_node_updater;
@@ -6,6 +6,7 @@
 #include <qmath.h>
 #include <QtQuick/private/qsgdistancefieldglyphnode_p.h>
 #include <QtQuick/private/qsgcontext_p.h>
+#include <QtQuick/private/qsgdistancefieldglyphstore_p.h>
 #include <private/qrawfont_p.h>
 #include <QtGui/qguiapplication.h>
 #include <qdir.h>
@@ -13,6 +14,11 @@
 
 #include <private/qquickprofiler_p.h>
 #include <QElapsedTimer>
+#include <QThread>
+
+#if QT_CONFIG(thread)
+#include <QtQuick/private/qsgworkerpool_p.h>
+#endif
 
 #include <qtquick_tracepoints_p.h>
 
@@ -27,6 +33,24 @@ Q_TRACE_POINT(qtquick, QSGDistanceFieldGlyphCache_glyphStore_exit)
 
 static QElapsedTimer qsg_render_timer;
 
+#if QT_CONFIG(thread)
+static int qsg_glyphRenderThreadCount()
+{
+    static const int count = qEnvironmentVariableIsSet("QSG_DISTANCEFIELD_THREADS")
+            ? qMax(1, qEnvironmentVariableIntValue("QSG_DISTANCEFIELD_THREADS"))
+            : QThread::idealThreadCount();
+    return count;
+}
+
+static int qsg_glyphRenderParallelThreshold()
+{
+    static const int threshold = qEnvironmentVariableIsSet("QSG_DISTANCEFIELD_PARALLEL_THRESHOLD")
+            ? qEnvironmentVariableIntValue("QSG_DISTANCEFIELD_PARALLEL_THRESHOLD")
+            : 16;
+    return threshold;
+}
+#endif
+
 QSGDistanceFieldGlyphCache::Texture QSGDistanceFieldGlyphCache::s_emptyTexture;
 
 QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(const QRawFont &font, int renderTypeQuality)
@@ -49,6 +73,8 @@ QSGDistanceFieldGlyphCache::QSGDistanceFieldGlyphCache(const QRawFont &font, int
 
 QSGDistanceFieldGlyphCache::~QSGDistanceFieldGlyphCache()
 {
+    if (!m_glyphStoreKey.isEmpty())
+        QSGDistanceFieldGlyphStore::instance()->save(m_glyphStoreKey);
 }
 
 int QSGDistanceFieldGlyphCache::baseFontSize() const
@@ -161,22 +187,67 @@ void QSGDistanceFieldGlyphCache::update()
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphAdaptationLayerFrame);
     Q_TRACE(QSGDistanceFieldGlyphCache_glyphRender_entry);
 
-    QList<QDistanceField> distanceFields;
+    // Glyphs may have been generated ahead of time by a preload, or in an
+    // earlier run when the disk cache is enabled.
+    QSGDistanceFieldGlyphStore *store = nullptr;
+    if (QSGDistanceFieldGlyphStore::isActive()) {
+        store = QSGDistanceFieldGlyphStore::instance();
+        if (m_glyphStoreKey.isEmpty()) {
+            m_glyphStoreKey = QSGDistanceFieldGlyphStore::fontKey(m_referenceFont, baseFontSize(),
+                                                                  m_doubleGlyphResolution);
+        }
+    }
+
+    struct GlyphToRender {
+        int index;
+        QSize size;
+        QPainterPath path;
+    };
+    QList<GlyphToRender> glyphsToRender;
+
     const int pendingGlyphsSize = m_pendingGlyphs.size();
-    distanceFields.reserve(pendingGlyphsSize);
+    QList<QDistanceField> distanceFields(pendingGlyphsSize);
     for (int i = 0; i < pendingGlyphsSize; ++i) {
         GlyphData &gd = glyphData(m_pendingGlyphs.at(i));
 
         QSize size = QSize(qCeil(gd.texCoord.width + gd.texCoord.xMargin * 2),
                            qCeil(gd.texCoord.height + gd.texCoord.yMargin * 2));
 
-        distanceFields.append(QDistanceField(size,
-                                             gd.path,
-                                             m_pendingGlyphs.at(i),
-                                             m_doubleGlyphResolution));
+        if (store)
+            distanceFields[i] = store->glyph(m_glyphStoreKey, m_pendingGlyphs.at(i), size);
+        if (distanceFields.at(i).isNull())
+            glyphsToRender.append({ i, size, gd.path });
         gd.path = QPainterPath(); // no longer needed, so release memory used by the painter path
     }
 
+    // Generating the distance fields only reads the paths fetched above, so
+    // the glyphs are independent of each other and can be rendered on several
+    // threads. Paths are not fetched on the workers because font engines are
+    // not thread safe.
+    QDistanceField *fields = distanceFields.data();
+    auto renderGlyph = [&](qsizetype i) {
+        const GlyphToRender &g = glyphsToRender.at(i);
+        fields[g.index] = QDistanceField(g.size,
+                                         g.path,
+                                         m_pendingGlyphs.at(g.index),
+                                         m_doubleGlyphResolution);
+    };
+
+#if QT_CONFIG(thread)
+    // A few glyphs are done faster than it takes to wake up the workers
+    const int threadCount = glyphsToRender.size() < qsg_glyphRenderParallelThreshold()
+            ? 1 : qsg_glyphRenderThreadCount();
+    QSGWorkerPool::run(glyphsToRender.size(), threadCount, renderGlyph);
+#else
+    for (qsizetype i = 0; i < glyphsToRender.size(); ++i)
+        renderGlyph(i);
+#endif
+
+    if (store) {
+        for (const GlyphToRender &g : std::as_const(glyphsToRender))
+            store->insert(m_glyphStoreKey, distanceFields.at(g.index));
+    }
+
     qint64 renderTime = 0;
     int count = m_pendingGlyphs.size();
     if (profileFrames)
@@ -526,6 +526,7 @@ private:
     QDataBuffer<glyph_t> m_pendingGlyphs;
     QSet<glyph_t> m_populatingGlyphs;
     QSGDistanceFieldGlyphConsumerList m_registeredNodes;
+    QByteArray m_glyphStoreKey;
 
     static Texture s_emptyTexture;
 };
@@ -0,0 +1,455 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsgdistancefieldglyphstore_p.h"
+#include "qsgcontext_p.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qsysinfo.h>
+#include <QtGui/private/qrawfont_p.h>
+#include <QtQml/private/qqmlglobal_p.h>
+#include <qmath.h>
+
+#if QT_CONFIG(thread)
+#include <QtCore/qthreadpool.h>
+#include <private/qsgworkerpool_p.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+DEFINE_BOOL_CONFIG_OPTION(qsgDistanceFieldDiskCache, QSG_DISTANCEFIELD_DISK_CACHE)
+
+// Bump this whenever the format of the glyph cache files changes.
+static constexpr quint32 GlyphFileMagic = 0x71736764; // "qsgd"
+static constexpr quint32 GlyphFileVersion = 1;
+static constexpr qsizetype MaxGlyphsPerFont = 4096;
+static constexpr qint32 MaxGlyphSize = 4096;
+
+Q_GLOBAL_STATIC(QSGDistanceFieldGlyphStore, qsg_distanceFieldGlyphStore)
+
+std::atomic<bool> QSGDistanceFieldGlyphStore::s_active = false;
+
+QSGDistanceFieldGlyphStore::~QSGDistanceFieldGlyphStore()
+{
+    // The preloads still running or queued refer to the store, let them
+    // finish without generating anything else.
+    m_cancelled.store(true, std::memory_order_relaxed);
+    waitForPreloads();
+}
+
+QSGDistanceFieldGlyphStore *QSGDistanceFieldGlyphStore::instance()
+{
+    return qsg_distanceFieldGlyphStore();
+}
+
+bool QSGDistanceFieldGlyphStore::isActive()
+{
+    return s_active.load(std::memory_order_relaxed) || isDiskCacheEnabled();
+}
+
+/*!
+    \internal
+
+    Returns true when generated distance fields are persisted on disk. This
+    is opt-in via the \c QSG_DISTANCEFIELD_DISK_CACHE environment variable,
+    and is disabled by \c QSG_RHI_DISABLE_DISK_CACHE like the pipeline cache.
+ */
+bool QSGDistanceFieldGlyphStore::isDiskCacheEnabled()
+{
+    static const bool enabled = qsgDistanceFieldDiskCache()
+            && !qEnvironmentVariableIntValue("QSG_RHI_DISABLE_DISK_CACHE");
+    return enabled;
+}
+
+static QString glyphCacheDir()
+{
+    static bool checked = false;
+    static QString currentCacheDir;
+
+    if (checked)
+        return currentCacheDir;
+
+    checked = true;
+
+    // Application specific, like the automatic pipeline cache.
+    const QString cachePath = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (!cachePath.isEmpty()) {
+        const QString dir = cachePath + QLatin1String("/qtdistancefieldcache-")
+                + QSysInfo::buildAbi() + QLatin1Char('/');
+        QDir::root().mkpath(dir);
+        if (QFileInfo(dir).isWritable())
+            currentCacheDir = dir;
+    }
+
+    return currentCacheDir;
+}
+
+static inline QString glyphCacheFileName(const QByteArray &key)
+{
+    const QString dir = glyphCacheDir();
+    if (dir.isEmpty())
+        return QString();
+
+    return dir + QString::fromLatin1(key) + QLatin1String(".qsgdf");
+}
+
+/*!
+    \internal
+
+    Returns a key identifying the distance fields generated from \a font with
+    the given parameters. The 'head' table of a font file contains a checksum
+    of the whole file, so together with the naming table it identifies the
+    font file without having to read all of it.
+ */
+QByteArray QSGDistanceFieldGlyphStore::fontKey(const QRawFont &font, int baseFontSize,
+                                               bool doubleGlyphResolution)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const QByteArray head = font.fontTable("head");
+    if (!head.isEmpty()) {
+        hash.addData(head);
+        hash.addData(font.fontTable("name"));
+    } else {
+        hash.addData(font.familyName().toUtf8());
+        hash.addData(font.styleName().toUtf8());
+    }
+
+    const QRawFontPrivate *fontD = QRawFontPrivate::get(font);
+    const int glyphCount = fontD->fontEngine ? fontD->fontEngine->glyphCount() : 0;
+    const QByteArray parameters = QByteArray::number(glyphCount) + ':'
+            + QByteArray::number(font.weight()) + ':'
+            + QByteArray::number(int(font.style())) + ':'
+            + QByteArray::number(baseFontSize) + ':'
+            + (doubleGlyphResolution ? "2" : "1");
+    hash.addData(parameters);
+
+    return hash.result().toHex();
+}
+
+static QDistanceField distanceFieldForPath(const QPainterPath &path, glyph_t glyph,
+                                           bool doubleGlyphResolution)
+{
+    const qreal scaleFactor = qreal(1) / QT_DISTANCEFIELD_SCALE(doubleGlyphResolution);
+    const QRectF boundingRect = path.boundingRect();
+    if (boundingRect.isEmpty())
+        return QDistanceField();
+
+    const qreal margin = QT_DISTANCEFIELD_RADIUS(doubleGlyphResolution)
+            / qreal(QT_DISTANCEFIELD_SCALE(doubleGlyphResolution));
+    const QSize size(qCeil(boundingRect.width() * scaleFactor + margin * 2),
+                     qCeil(boundingRect.height() * scaleFactor + margin * 2));
+    return QDistanceField(size, path, glyph, doubleGlyphResolution);
+}
+
+/*!
+    \internal
+
+    Generates the distance field for \a glyph the same way
+    QSGDistanceFieldGlyphCache::update() does. \a referenceFont must have the
+    pixel size the cache uses internally.
+ */
+QDistanceField QSGDistanceFieldGlyphStore::generate(const QRawFont &referenceFont, glyph_t glyph,
+                                                    bool doubleGlyphResolution)
+{
+    return distanceFieldForPath(referenceFont.pathForGlyph(glyph), glyph, doubleGlyphResolution);
+}
+
+// Must be called with m_mutex locked.
+QSGDistanceFieldGlyphStore::FontGlyphs &QSGDistanceFieldGlyphStore::fontGlyphs(const QByteArray &key)
+{
+    FontGlyphs &fg = m_fonts[key];
+    if (fg.loaded || !isDiskCacheEnabled())
+        return fg;
+
+    fg.loaded = true;
+
+    const QString fileName = glyphCacheFileName(key);
+    QFile f(fileName);
+    if (fileName.isEmpty() || !f.open(QIODevice::ReadOnly))
+        return fg;
+
+    QElapsedTimer timer;
+    const bool profile = QSG_LOG_TIME_GLYPH().isDebugEnabled();
+    if (profile)
+        timer.start();
+
+    QDataStream stream(&f);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic;
+    quint32 version;
+    quint32 qtVersion;
+    QByteArray fileKey;
+    quint32 count;
+    stream >> magic >> version >> qtVersion >> fileKey >> count;
+    if (stream.status() != QDataStream::Ok || magic != GlyphFileMagic
+            || version != GlyphFileVersion || qtVersion != QT_VERSION || fileKey != key
+            || count > quint32(MaxGlyphsPerFont)) {
+        return fg;
+    }
+
+    for (quint32 i = 0; i < count; ++i) {
+        quint32 glyph;
+        qint32 width;
+        qint32 height;
+        stream >> glyph >> width >> height;
+        if (stream.status() != QDataStream::Ok || width <= 0 || height <= 0
+                || width > MaxGlyphSize || height > MaxGlyphSize) {
+            qWarning("Invalid distance field glyph cache file '%s'", qPrintable(fileName));
+            fg.glyphs.clear();
+            return fg;
+        }
+
+        // QDistanceField has no way to attach a glyph index to existing
+        // data, so render an empty path and overwrite the result.
+        QDistanceField field(QSize(width, height), QPainterPath(), glyph);
+        const int size = width * height;
+        if (field.isNull() || stream.readRawData(reinterpret_cast<char *>(field.bits()), size) != size) {
+            qWarning("Invalid distance field glyph cache file '%s'", qPrintable(fileName));
+            fg.glyphs.clear();
+            return fg;
+        }
+        fg.glyphs.insert(glyph, field);
+    }
+
+    if (profile) {
+        qCDebug(QSG_LOG_TIME_GLYPH, "distancefield: %d glyphs loaded from '%s' in %dms",
+                int(count), qPrintable(fileName), int(timer.elapsed()));
+    }
+
+    return fg;
+}
+
+/*!
+    \internal
+
+    Returns the stored distance field for \a glyph of the font identified by
+    \a key, or a null distance field when there is none with the expected \a
+    size. Without the disk cache a preloaded glyph is handed over to the
+    caller and not kept in the store.
+ */
+QDistanceField QSGDistanceFieldGlyphStore::glyph(const QByteArray &key, glyph_t glyph, const QSize &size)
+{
+    QMutexLocker locker(&m_mutex);
+    FontGlyphs &fg = fontGlyphs(key);
+    const auto it = fg.glyphs.constFind(glyph);
+    if (it == fg.glyphs.cend())
+        return QDistanceField();
+
+    const QDistanceField field = it.value();
+    if (!isDiskCacheEnabled())
+        fg.glyphs.erase(it);
+
+    if (field.width() != size.width() || field.height() != size.height())
+        return QDistanceField();
+
+    return field;
+}
+
+/*!
+    \internal
+
+    Records a distance field generated by a glyph cache so that it gets
+    written to disk by save(). Does nothing when the disk cache is disabled.
+ */
+void QSGDistanceFieldGlyphStore::insert(const QByteArray &key, const QDistanceField &field)
+{
+    if (!isDiskCacheEnabled() || field.isNull())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    FontGlyphs &fg = fontGlyphs(key);
+    if (fg.glyphs.size() >= MaxGlyphsPerFont || fg.glyphs.contains(field.glyph()))
+        return;
+
+    fg.glyphs.insert(field.glyph(), field);
+    fg.dirty = true;
+}
+
+/*!
+    \internal
+
+    Writes the distance fields of the font identified by \a key to the disk
+    cache, if any were added since the last save.
+ */
+void QSGDistanceFieldGlyphStore::save(const QByteArray &key)
+{
+    if (!isDiskCacheEnabled())
+        return;
+
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_fonts.find(key);
+    if (it == m_fonts.end() || !it->dirty)
+        return;
+
+    const QString fileName = glyphCacheFileName(key);
+    if (fileName.isEmpty())
+        return;
+
+    QSaveFile f(fileName);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return;
+
+    QDataStream stream(&f);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << GlyphFileMagic << GlyphFileVersion << quint32(QT_VERSION) << key
+           << quint32(it->glyphs.size());
+    for (auto glyphIt = it->glyphs.cbegin(), end = it->glyphs.cend(); glyphIt != end; ++glyphIt) {
+        const QDistanceField &field = glyphIt.value();
+        stream << quint32(glyphIt.key()) << qint32(field.width()) << qint32(field.height());
+        stream.writeRawData(reinterpret_cast<const char *>(field.constBits()),
+                            field.width() * field.height());
+    }
+
+    if (stream.status() == QDataStream::Ok && f.commit()) {
+        it->dirty = false;
+        qCDebug(QSG_LOG_INFO, "Wrote %d distance field glyphs to '%s'",
+                int(it->glyphs.size()), qPrintable(fileName));
+    }
+}
+
+/*!
+    \internal
+
+    Generates the distance fields for \a glyphs of \a font on a thread of the
+    QSGWorkerPool so that the glyph caches can pick them up instead of
+    generating them on the render thread once the glyphs are shown. \a
+    renderTypeQuality is the value of Text.renderTypeQuality the glyphs will be
+    shown with.
+
+    The glyph paths are fetched on the calling thread, like the glyph caches
+    do on the render thread, because font engines are not thread safe. Only
+    the paths are handed to the worker.
+ */
+void QSGDistanceFieldGlyphStore::preload(const QRawFont &font, const QList<glyph_t> &glyphs,
+                                         int renderTypeQuality)
+{
+    if (!font.isValid() || glyphs.isEmpty())
+        return;
+
+    // Fonts with a pregenerated cache do not generate anything at run time.
+    if (!font.fontTable("qtdf").isEmpty())
+        return;
+
+    s_active.store(true, std::memory_order_relaxed);
+
+    // Same parameters as in the QSGDistanceFieldGlyphCache constructor.
+    const int glyphCount = QRawFontPrivate::get(font)->fontEngine->glyphCount();
+    const bool doubleGlyphResolution = qt_fontHasNarrowOutlines(font)
+            && glyphCount < QT_DISTANCEFIELD_HIGHGLYPHCOUNT();
+    const int baseFontSize = renderTypeQuality > 0
+            ? renderTypeQuality : QT_DISTANCEFIELD_BASEFONTSIZE(doubleGlyphResolution);
+    QRawFont referenceFont = font;
+    referenceFont.setPixelSize(baseFontSize * QT_DISTANCEFIELD_SCALE(doubleGlyphResolution));
+    const QByteArray key = fontKey(font, baseFontSize, doubleGlyphResolution);
+
+    QList<GlyphPath> paths;
+    {
+        // Skip the glyphs that are known already, without reading the disk
+        // cache on this thread. The worker checks again after loading it.
+        QMutexLocker locker(&m_mutex);
+        const auto it = m_fonts.constFind(key);
+        const FontGlyphs *fg = it != m_fonts.cend() && (it->loaded || !isDiskCacheEnabled())
+                ? &it.value() : nullptr;
+        QSet<glyph_t> seen;
+        for (glyph_t glyph : glyphs) {
+            if (int(glyph) < glyphCount && !(fg && fg->glyphs.contains(glyph))
+                    && !seen.contains(glyph)) {
+                seen.insert(glyph);
+                paths.append({ glyph, QPainterPath() });
+            }
+        }
+    }
+    if (paths.isEmpty())
+        return;
+
+    for (GlyphPath &glyphPath : paths)
+        glyphPath.path = referenceFont.pathForGlyph(glyphPath.glyph);
+
+#if QT_CONFIG(thread)
+    {
+        QMutexLocker locker(&m_mutex);
+        ++m_pendingPreloads;
+    }
+    QSGWorkerPool::threadPool()->start([this, key, paths, doubleGlyphResolution,
+                                        familyName = font.familyName()] {
+        generateGlyphs(key, paths, doubleGlyphResolution, familyName);
+        QMutexLocker locker(&m_mutex);
+        if (--m_pendingPreloads == 0)
+            m_preloadsDone.wakeAll();
+    });
+#else
+    generateGlyphs(key, paths, doubleGlyphResolution, font.familyName());
+#endif
+}
+
+/*!
+    \internal
+
+    Waits until the glyphs of all preload() calls so far are in the store.
+ */
+void QSGDistanceFieldGlyphStore::waitForPreloads()
+{
+    QMutexLocker locker(&m_mutex);
+    while (m_pendingPreloads > 0)
+        m_preloadsDone.wait(&m_mutex);
+}
+
+void QSGDistanceFieldGlyphStore::generateGlyphs(const QByteArray &key, const QList<GlyphPath> &paths,
+                                                bool doubleGlyphResolution,
+                                                const QString &familyName)
+{
+    QElapsedTimer timer;
+    const bool profile = QSG_LOG_TIME_GLYPH().isDebugEnabled();
+    if (profile)
+        timer.start();
+
+    QSet<glyph_t> knownGlyphs;
+    {
+        QMutexLocker locker(&m_mutex);
+        const FontGlyphs &fg = fontGlyphs(key);
+        for (const GlyphPath &glyphPath : paths) {
+            if (fg.glyphs.contains(glyphPath.glyph))
+                knownGlyphs.insert(glyphPath.glyph);
+        }
+    }
+
+    QList<QDistanceField> fields;
+    fields.reserve(paths.size() - knownGlyphs.size());
+    for (const GlyphPath &glyphPath : paths) {
+        if (m_cancelled.load(std::memory_order_relaxed))
+            return;
+        if (knownGlyphs.contains(glyphPath.glyph))
+            continue;
+        QDistanceField field = distanceFieldForPath(glyphPath.path, glyphPath.glyph,
+                                                    doubleGlyphResolution);
+        if (!field.isNull())
+            fields.append(field);
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        FontGlyphs &fg = fontGlyphs(key);
+        for (const QDistanceField &field : std::as_const(fields)) {
+            if (fg.glyphs.size() >= MaxGlyphsPerFont)
+                break;
+            fg.glyphs.insert(field.glyph(), field);
+            fg.dirty = isDiskCacheEnabled();
+        }
+    }
+
+    if (profile) {
+        qCDebug(QSG_LOG_TIME_GLYPH, "distancefield: %d glyphs of '%s' preloaded in %dms",
+                int(fields.size()), qPrintable(familyName), int(timer.elapsed()));
+    }
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,85 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSGDISTANCEFIELDGLYPHSTORE_P_H
+#define QSGDISTANCEFIELDGLYPHSTORE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtquickglobal_p.h>
+#include <QtGui/private/qdistancefield_p.h>
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qwaitcondition.h>
+#include <QtGui/qpainterpath.h>
+#include <QtGui/qrawfont.h>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+// Process wide store of generated distance fields, shared by the glyph caches
+// of all render contexts. It holds the glyphs generated ahead of time by
+// preload() and, when the disk cache is enabled, every generated glyph so
+// that they can be written out and reused by the next run of the application.
+// The store is only consulted once it is active, i.e. after the first
+// preload() or when the disk cache is enabled, so it costs nothing otherwise.
+class Q_QUICK_EXPORT QSGDistanceFieldGlyphStore
+{
+public:
+    ~QSGDistanceFieldGlyphStore();
+
+    static QSGDistanceFieldGlyphStore *instance();
+
+    static bool isActive();
+    static bool isDiskCacheEnabled();
+
+    static QByteArray fontKey(const QRawFont &font, int baseFontSize, bool doubleGlyphResolution);
+    static QDistanceField generate(const QRawFont &referenceFont, glyph_t glyph,
+                                   bool doubleGlyphResolution);
+
+    QDistanceField glyph(const QByteArray &key, glyph_t glyph, const QSize &size);
+    void insert(const QByteArray &key, const QDistanceField &field);
+    void save(const QByteArray &key);
+
+    void preload(const QRawFont &font, const QList<glyph_t> &glyphs, int renderTypeQuality);
+    void waitForPreloads();
+
+private:
+    struct FontGlyphs {
+        QHash<glyph_t, QDistanceField> glyphs;
+        bool loaded = false;
+        bool dirty = false;
+    };
+
+    struct GlyphPath {
+        glyph_t glyph;
+        QPainterPath path;
+    };
+
+    FontGlyphs &fontGlyphs(const QByteArray &key);
+    void generateGlyphs(const QByteArray &key, const QList<GlyphPath> &paths,
+                        bool doubleGlyphResolution, const QString &familyName);
+
+    QMutex m_mutex;
+    QHash<QByteArray, FontGlyphs> m_fonts;
+    QWaitCondition m_preloadsDone;
+    int m_pendingPreloads = 0;
+    std::atomic<bool> m_cancelled = false;
+
+    static std::atomic<bool> s_active;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGDISTANCEFIELDGLYPHSTORE_P_H
@@ -0,0 +1,130 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsgframetimings_p.h"
+
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+#include <cmath>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+    \class QSGFrameTimings
+    \internal
+
+    Keeps the durations of the phases of the most recent frames of a window in
+    a ring buffer. The render loop fills it when it is enabled. Each frame
+    record holds the gui thread work that led to the frame (animations, polish,
+    the wait for the sync and garbage collection) and the render thread work
+    for it (sync, preparing and recording the render pass and presenting).
+
+    Comparing the two halves tells whether a late frame was caused by the gui
+    thread or by the render thread. The class is thread safe. The settings are
+    only changed on the gui thread, so that is where the signals are emitted.
+ */
+
+qint64 QSGFrameTimings::Frame::guiThreadTime() const
+{
+    return phases[Animations] + phases[Polish] + phases[SyncWait] + phases[GarbageCollection];
+}
+
+qint64 QSGFrameTimings::Frame::renderThreadTime() const
+{
+    return phases[Sync] + phases[RenderPrepare] + phases[RenderRecord] + phases[Present];
+}
+
+void QSGFrameTimings::setEnabled(bool enabled)
+{
+    if (m_enabled.exchange(enabled, std::memory_order_relaxed) != enabled)
+        emit enabledChanged();
+}
+
+qsizetype QSGFrameTimings::capacity() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_capacity;
+}
+
+void QSGFrameTimings::setCapacity(qsizetype capacity)
+{
+    capacity = qMax(capacity, qsizetype(1));
+    {
+        QMutexLocker locker(&m_mutex);
+        if (capacity == m_capacity)
+            return;
+
+        // keep the most recent frames
+        QList<Frame> frames;
+        for (qsizetype i = 0; i < m_frames.size(); ++i)
+            frames.append(m_frames.at((m_next + i) % m_frames.size()));
+        if (frames.size() > capacity)
+            frames.remove(0, frames.size() - capacity);
+
+        m_frames = std::move(frames);
+        m_capacity = capacity;
+        m_next = m_frames.size() % m_capacity;
+    }
+    emit capacityChanged();
+}
+
+void QSGFrameTimings::addFrame(const Frame &frame)
+{
+    QMutexLocker locker(&m_mutex);
+    Frame f = frame;
+    f.frameNumber = m_frameCount++;
+    if (m_frames.size() < m_capacity)
+        m_frames.append(f);
+    else
+        m_frames[m_next] = f;
+    m_next = (m_next + 1) % m_capacity;
+}
+
+/*!
+    Returns the recorded frames, oldest first.
+ */
+QList<QSGFrameTimings::Frame> QSGFrameTimings::frames() const
+{
+    QMutexLocker locker(&m_mutex);
+    QList<Frame> result;
+    result.reserve(m_frames.size());
+    const qsizetype start = m_frames.size() < m_capacity ? 0 : m_next;
+    for (qsizetype i = 0; i < m_frames.size(); ++i)
+        result.append(m_frames.at((start + i) % m_frames.size()));
+    return result;
+}
+
+/*!
+    Returns the \a p th percentile, with \a p between 0 and 100, of the
+    duration of \a phase over the recorded frames, in nanoseconds. Uses the
+    nearest-rank method. Returns 0 when no frames are recorded.
+ */
+qint64 QSGFrameTimings::percentile(Phase phase, qreal p) const
+{
+    QVarLengthArray<qint64, DefaultCapacity> values;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (const Frame &frame : m_frames)
+            values.append(frame.phases[phase]);
+    }
+    if (values.isEmpty())
+        return 0;
+
+    const qsizetype rank = qBound(qsizetype(1),
+                                  qsizetype(std::ceil(qBound(0.0, p, 100.0) / 100.0 * values.size())),
+                                  values.size());
+    std::nth_element(values.begin(), values.begin() + rank - 1, values.end());
+    return values[rank - 1];
+}
+
+void QSGFrameTimings::clear()
+{
+    QMutexLocker locker(&m_mutex);
+    m_frames.clear();
+    m_next = 0;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qsgframetimings_p.cpp"
@@ -0,0 +1,86 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSGFRAMETIMINGS_P_H
+#define QSGFRAMETIMINGS_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtquickglobal_p.h>
+
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qobject.h>
+
+#include <array>
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+class Q_QUICK_EXPORT QSGFrameTimings : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Phase {
+        // gui thread
+        Animations,
+        Polish,
+        SyncWait,
+        GarbageCollection,
+        // render thread
+        Sync,
+        RenderPrepare,
+        RenderRecord,
+        Present,
+        PhaseCount
+    };
+
+    struct Frame
+    {
+        qint64 frameNumber = 0;
+        std::array<qint64, PhaseCount> phases = {}; // nanoseconds
+
+        qint64 guiThreadTime() const;
+        qint64 renderThreadTime() const;
+    };
+
+    static constexpr qsizetype DefaultCapacity = 240;
+
+    bool isEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+    void setEnabled(bool enabled);
+
+    qsizetype capacity() const;
+    void setCapacity(qsizetype capacity);
+
+    void addFrame(const Frame &frame);
+    QList<Frame> frames() const;
+    qint64 percentile(Phase phase, qreal p) const;
+    void clear();
+
+Q_SIGNALS:
+    // for the FrameTimings attached objects of all items in the window
+    void enabledChanged();
+    void capacityChanged();
+
+private:
+    mutable QMutex m_mutex;
+    QList<Frame> m_frames;
+    qsizetype m_capacity = DefaultCapacity;
+    qsizetype m_next = 0;
+    qint64 m_frameCount = 0;
+    std::atomic<bool> m_enabled = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGFRAMETIMINGS_P_H
@@ -21,6 +21,7 @@
 #include <QtCore/qset.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qcoreevent.h>
+#include <QtCore/qelapsedtimer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -74,6 +75,13 @@ public:
 
     virtual bool interleaveIncubation() const { return false; }
 
+    // Milliseconds since the GUI thread started the frame that the latest
+    // timeToIncubate() was emitted for, or -1 if there is no such frame.
+    qint64 incubationFrameElapsed() const
+    {
+        return m_incubationFrameTimer.isValid() ? m_incubationFrameTimer.elapsed() : -1;
+    }
+
     virtual int flags() const { return 0; }
 
     static void cleanup();
@@ -83,9 +91,14 @@ public:
 Q_SIGNALS:
     void timeToIncubate();
 
+protected:
+    void startIncubationFrame() { m_incubationFrameTimer.start(); }
+
 private:
     static QSGRenderLoop *s_instance;
 
+    QElapsedTimer m_incubationFrameTimer;
+
     QSet<QQuickWindow *> m_windows;
 };
 
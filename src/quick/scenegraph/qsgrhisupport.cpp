@@ -17,6 +17,7 @@
 #include <QOperatingSystemVersion>
 #include <QLockFile>
 #include <QSaveFile>
+#include <QDataStream>
 #include <QStandardPaths>
 #include <QDir>
 #include <QFileInfo>
@@ -992,7 +993,113 @@ static inline QString pipelineCacheLockFileName(const QString &name)
 }
 #endif
 
-void QSGRhiSupport::preparePipelineCache(QRhi *rhi, QQuickWindow *window)
+// Bump this whenever the format of the pipeline description files changes.
+static constexpr quint32 PipelineDescriptionMagic = 0x71736770; // "qsgp"
+static constexpr quint32 PipelineDescriptionVersion = 2;
+static constexpr qsizetype MaxPipelineDescriptions = 1024;
+
+static inline QString pipelineDescriptionFileName(const QString &pipelineCacheFileName)
+{
+    return pipelineCacheFileName + QLatin1String(".qsgpipelines");
+}
+
+static QSet<QByteArray> loadPipelineDescriptions(const QString &fileName, QRhi *rhi)
+{
+#if !QT_CONFIG(temporaryfile)
+    QLockFile lock(pipelineCacheLockFileName(fileName));
+    if (!lock.lock())
+        return {};
+#endif
+
+    QFile f(fileName);
+    if (!f.open(QIODevice::ReadOnly))
+        return {};
+
+    QDataStream stream(&f);
+    stream.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic;
+    quint32 version;
+    quint32 qtVersion;
+    QByteArray backendName;
+    stream >> magic >> version >> qtVersion >> backendName;
+    if (magic != PipelineDescriptionMagic || version != PipelineDescriptionVersion
+            || qtVersion != QT_VERSION || backendName != QByteArray(rhi->backendName())) {
+        return {};
+    }
+
+    QList<QByteArray> descriptions;
+    stream >> descriptions;
+    if (stream.status() != QDataStream::Ok)
+        return {};
+
+    qCDebug(QSG_LOG_INFO, "Loaded %d pipeline descriptions for QRhi %p from '%s'",
+            int(descriptions.size()), rhi, qPrintable(fileName));
+    return QSet<QByteArray>(descriptions.cbegin(), descriptions.cend());
+}
+
+static void savePipelineDescriptions(const QString &fileName, QRhi *rhi,
+                                     const QList<QByteArray> &descriptions)
+{
+#if QT_CONFIG(temporaryfile)
+    QSaveFile f(fileName);
+#else
+    QLockFile lock(pipelineCacheLockFileName(fileName));
+    if (!lock.lock())
+        return;
+    QFile f(fileName);
+#endif
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return;
+
+    QDataStream stream(&f);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << PipelineDescriptionMagic << PipelineDescriptionVersion << quint32(QT_VERSION)
+           << QByteArray(rhi->backendName()) << descriptions;
+
+    qCDebug(QSG_LOG_INFO, "Writing %d pipeline descriptions for QRhi %p to '%s'",
+            int(descriptions.size()), rhi, qPrintable(fileName));
+
+#if QT_CONFIG(temporaryfile)
+    if (stream.status() == QDataStream::Ok)
+        f.commit();
+#endif
+}
+
+/*!
+    \internal
+
+    Returns the descriptions of the graphics pipelines that were created for
+    \a rhi, in this run or in earlier ones. The descriptions are opaque to
+    QSGRhiSupport, they are produced and interpreted by the renderer.
+
+    The list is empty when no pipeline cache file is used for \a rhi.
+ */
+QList<QByteArray> QSGRhiSupport::pipelineDescriptions(QRhi *rhi) const
+{
+    QMutexLocker locker(&m_pipelineDescriptionMutex);
+    const auto it = m_pipelineDescriptions.constFind(rhi);
+    if (it == m_pipelineDescriptions.constEnd())
+        return {};
+    return (it->loaded + it->used).values();
+}
+
+/*!
+    \internal
+
+    Records that a graphics pipeline matching \a description was created for
+    \a rhi. The recorded descriptions are stored next to the pipeline cache
+    file when \a rhi is destroyed.
+ */
+void QSGRhiSupport::addPipelineDescription(QRhi *rhi, const QByteArray &description)
+{
+    QMutexLocker locker(&m_pipelineDescriptionMutex);
+    const auto it = m_pipelineDescriptions.find(rhi);
+    if (it != m_pipelineDescriptions.end())
+        it->used.insert(description);
+}
+
+void QSGRhiSupport::preparePipelineCache(QRhi *rhi, QQuickWindow *window, bool ownsRhi)
 {
     QQuickWindowPrivate *wd = QQuickWindowPrivate::get(window);
 
@@ -1006,6 +1113,21 @@ void QSGRhiSupport::preparePipelineCache(QRhi *rhi, QQuickWindow *window)
         }
     }
 
+    // Recording the pipelines that get created allows the renderer to create
+    // them up front in the next run, instead of when they are first needed.
+    // The recorded pipelines are saved, and forgotten, in destroyRhi(), which
+    // is never called for a QRhi that the application provided.
+    if (ownsRhi && (!pipelineCacheLoad.isEmpty() || !wd->graphicsConfig.pipelineCacheSaveFile().isEmpty()
+            || wd->graphicsConfig.isAutomaticPipelineCacheEnabled())) {
+        PipelineDescriptions descriptions;
+        if (!pipelineCacheLoad.isEmpty()) {
+            descriptions.loaded = loadPipelineDescriptions(
+                    pipelineDescriptionFileName(pipelineCacheLoad), rhi);
+        }
+        QMutexLocker locker(&m_pipelineDescriptionMutex);
+        m_pipelineDescriptions.insert(rhi, std::move(descriptions));
+    }
+
     if (pipelineCacheLoad.isEmpty())
         return;
 
@@ -1035,7 +1157,8 @@ void QSGRhiSupport::preparePipelineCache(QRhi *rhi, QQuickWindow *window)
     }
 }
 
-void QSGRhiSupport::finalizePipelineCache(QRhi *rhi, const QQuickGraphicsConfiguration &config)
+void QSGRhiSupport::finalizePipelineCache(QRhi *rhi, const QQuickGraphicsConfiguration &config,
+                                          const PipelineDescriptions &descriptions)
 {
     // output the rhi statistics about pipelines, as promised by the documentation
     qCDebug(QSG_LOG_INFO, "Total time spent on pipeline creation during the lifetime of the QRhi %p was %lld ms",
@@ -1052,6 +1175,21 @@ void QSGRhiSupport::finalizePipelineCache(QRhi *rhi, const QQuickGraphicsConfigu
     if (pipelineCacheSave.isEmpty())
         return;
 
+    if (!descriptions.used.isEmpty()) {
+        // Pipelines used in this run come first, then the ones from earlier
+        // runs, as long as the file does not grow too large.
+        QList<QByteArray> list = descriptions.used.values();
+        for (const QByteArray &description : descriptions.loaded) {
+            if (list.size() >= MaxPipelineDescriptions)
+                break;
+            if (!descriptions.used.contains(description))
+                list.append(description);
+        }
+        if (list.size() > MaxPipelineDescriptions)
+            list.resize(MaxPipelineDescriptions);
+        savePipelineDescriptions(pipelineDescriptionFileName(pipelineCacheSave), rhi, list);
+    }
+
     const QByteArray buf = rhi->pipelineCacheData();
 
     // If empty, do nothing. This is exactly what will happen if the rhi was
@@ -1116,7 +1254,7 @@ QSGRhiSupport::RhiCreateResult QSGRhiSupport::createRhi(QQuickWindow *window, QS
     if (customDevD->type == QQuickGraphicsDevicePrivate::Type::Rhi) {
         rhi = customDevD->u.rhi;
         if (rhi) {
-            preparePipelineCache(rhi, window);
+            preparePipelineCache(rhi, window, false);
             return { rhi, false };
         }
     }
@@ -1284,7 +1422,7 @@ QSGRhiSupport::RhiCreateResult QSGRhiSupport::createRhi(QQuickWindow *window, QS
 
     if (rhi) {
         qCDebug(QSG_LOG_INFO, "Created QRhi %p for window %p", rhi, window);
-        preparePipelineCache(rhi, window);
+        preparePipelineCache(rhi, window, true);
     } else {
         qWarning("Failed to create RHI (backend %d)", backend);
     }
@@ -1297,8 +1435,14 @@ void QSGRhiSupport::destroyRhi(QRhi *rhi, const QQuickGraphicsConfiguration &con
     if (!rhi)
         return;
 
+    PipelineDescriptions descriptions;
+    {
+        QMutexLocker locker(&m_pipelineDescriptionMutex);
+        descriptions = m_pipelineDescriptions.take(rhi);
+    }
+
     if (!rhi->isDeviceLost())
-        finalizePipelineCache(rhi, config);
+        finalizePipelineCache(rhi, config, descriptions);
 
     delete rhi;
 }
@@ -20,6 +20,10 @@
 
 #include <rhi/qrhi.h>
 
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+
 QT_BEGIN_NAMESPACE
 
 class QSGDefaultRenderContext;
@@ -92,18 +96,29 @@ public:
 
     bool attemptReinitWithSwRastUponFail() const;
 
+    QList<QByteArray> pipelineDescriptions(QRhi *rhi) const;
+    void addPipelineDescription(QRhi *rhi, const QByteArray &description);
+
 private:
     QSGRhiSupport();
     void applySettings();
     void adjustToPlatformQuirks();
-    void preparePipelineCache(QRhi *rhi, QQuickWindow *window);
-    void finalizePipelineCache(QRhi *rhi, const QQuickGraphicsConfiguration &config);
+    struct PipelineDescriptions {
+        QSet<QByteArray> loaded;
+        QSet<QByteArray> used;
+    };
+    void preparePipelineCache(QRhi *rhi, QQuickWindow *window, bool ownsRhi);
+    void finalizePipelineCache(QRhi *rhi, const QQuickGraphicsConfiguration &config,
+                               const PipelineDescriptions &descriptions);
     struct {
         bool valid = false;
         QSGRendererInterface::GraphicsApi api;
     } m_requested;
     bool m_settingsApplied = false;
     QRhi::Implementation m_rhiBackend = QRhi::Null;
+
+    mutable QMutex m_pipelineDescriptionMutex;
+    QHash<QRhi *, PipelineDescriptions> m_pipelineDescriptions;
 };
 
 QT_END_NAMESPACE
@@ -21,6 +21,11 @@
 #include <QtGui/qpa/qplatformwindow_p.h>
 
 #include <QtQuick/private/qsgrenderer_p.h>
+#include <QtQuick/private/qsgframetimings_p.h>
+
+#include <QtQml/qqmlengine.h>
+#include <private/qv4engine_p.h>
+#include <private/qv4mm_p.h>
 
 #include "qsgthreadedrenderloop_p.h"
 #include "qsgrhisupport_p.h"
@@ -148,6 +153,9 @@ public:
     bool syncInExpose;
     bool forceRenderPass;
     QRhiSwapChainProxyData scProxyData;
+    // only valid when QSGFrameTimings are enabled for the window
+    QSGFrameTimings::Frame frameTiming;
+    QElapsedTimer syncWaitTimer;
 };
 
 
@@ -313,6 +321,10 @@ public:
     bool guiNotifiedAboutRhiFailure = false;
     bool swRastFallbackDueToSwapchainFailure = false;
 
+    QSGFrameTimings::Frame frameTiming;
+    QElapsedTimer syncWaitTimer;
+    bool frameTimingPending = false;
+
     // Local event queue stuff...
     bool stopEventProcessing;
     QSGRenderThreadEventQueue eventQueue;
@@ -347,6 +359,11 @@ bool QSGRenderThread::event(QEvent *e)
         windowSize = se->size;
         dpr = se->dpr;
         scProxyData = se->scProxyData;
+        frameTimingPending = se->syncWaitTimer.isValid();
+        if (frameTimingPending) {
+            frameTiming = se->frameTiming;
+            syncWaitTimer = se->syncWaitTimer;
+        }
 
         pendingUpdate |= SyncRequest;
         if (se->syncInExpose) {
@@ -526,6 +543,12 @@ void QSGRenderThread::sync(bool inExpose)
 
     Q_ASSERT_X(wm->m_lockedForSync, "QSGRenderThread::sync()", "sync triggered on bad terms as gui is not already locked...");
 
+    QElapsedTimer syncTimer;
+    if (frameTimingPending) {
+        frameTiming.phases[QSGFrameTimings::SyncWait] = syncWaitTimer.nsecsElapsed();
+        syncTimer.start();
+    }
+
     bool canSync = true;
     if (rhi) {
         if (windowSize.width() > 0 && windowSize.height() > 0) {
@@ -566,6 +589,9 @@ void QSGRenderThread::sync(bool inExpose)
         qCDebug(QSG_LOG_RENDERLOOP, QSG_RT_PAD, "- window has bad size, sync aborted");
     }
 
+    if (frameTimingPending)
+        frameTiming.phases[QSGFrameTimings::Sync] = syncTimer.nsecsElapsed();
+
     // Two special cases: For grabs we do not care about blocking the gui
     // (main) thread. When this is from an expose, we will keep locked until
     // the frame is rendered (submitted), so in that case waking happens later
@@ -754,13 +780,26 @@ void QSGRenderThread::syncAndRender()
     // Zero size windows do not initialize a swapchain and
     // rendercontext. So no sync or render can be done then.
     const bool canRender = d->renderer && hasValidSwapChain;
+    const bool recordFrameTiming = canRender && d->frameTimings.isEnabled();
+    if (recordFrameTiming && !(syncRequested && frameTimingPending))
+        frameTiming = {}; // a render thread only frame, e.g. for animators
+    QElapsedTimer frameTimingTimer;
     double lastCompletedGpuTime = 0;
     if (canRender) {
         if (!syncRequested) // else this was already done in sync()
             rhi->makeThreadLocalNativeContextCurrent();
 
+        if (recordFrameTiming)
+            frameTimingTimer.start();
+
         d->renderSceneGraph();
 
+        if (recordFrameTiming) {
+            const qint64 recordTime = d->renderer->lastRecordTime();
+            frameTiming.phases[QSGFrameTimings::RenderPrepare] = frameTimingTimer.restart() - recordTime;
+            frameTiming.phases[QSGFrameTimings::RenderRecord] = recordTime;
+        }
+
         if (profileFrames)
             renderTime = threadTimer.nsecsElapsed();
         Q_TRACE(QSG_render_exit);
@@ -779,6 +818,10 @@ void QSGRenderThread::syncAndRender()
         } else {
             lastCompletedGpuTime = cd->swapchain->currentFrameCommandBuffer()->lastCompletedGpuTime();
         }
+        if (recordFrameTiming) {
+            frameTiming.phases[QSGFrameTimings::Present] = frameTimingTimer.nsecsElapsed();
+            d->frameTimings.addFrame(frameTiming);
+        }
         d->fireFrameSwapped();
     } else {
         Q_TRACE(QSG_render_exit);
@@ -812,6 +855,8 @@ void QSGRenderThread::syncAndRender()
         mutex.unlock();
     }
 
+    frameTimingPending = false;
+
     if (profileFrames) {
         // Beware that there is no guarantee the graphics stack always
         // blocks for a full vsync in beginFrame() or endFrame(). (because
@@ -1274,9 +1319,11 @@ void QSGThreadedRenderLoop::handleExposure(QQuickWindow *window)
         win.updateDuringSync = false;
         win.forceRenderPass = true; // also covered by polishAndSync(inExpose=true), but doesn't hurt
         win.badVSync = false;
+        win.recordedFrameTiming = false;
         win.timeBetweenPolishAndSyncs.start();
         win.psTimeAccumulator = 0.0f;
         win.psTimeSampleCount = 0;
+        win.animationTime = 0;
         m_windows << win;
         w = &m_windows.last();
     } else {
@@ -1539,6 +1586,21 @@ void QSGThreadedRenderLoop::releaseResources(Window *w, bool inDestructor)
 }
 
 
+static QV4::GCStateMachine *garbageCollector(QQuickWindow *window)
+{
+    QQmlEngine *engine = qmlEngine(window);
+    if (!engine) {
+        const auto children = window->contentItem()->childItems();
+        for (QQuickItem *child : children) {
+            if ((engine = qmlEngine(child)))
+                break;
+        }
+    }
+    if (!engine)
+        return nullptr;
+    return engine->handle()->memoryManager->gcStateMachine.get();
+}
+
 /* Calls polish on all items, then requests synchronization with the render thread
  * and blocks until that is complete. Returns false if it aborted; otherwise true.
  */
@@ -1561,12 +1623,18 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
         return;
     }
 
+    startIncubationFrame();
+
     Q_TRACE_SCOPE(QSG_polishAndSync);
     QElapsedTimer timer;
     qint64 polishTime = 0;
     qint64 waitTime = 0;
     qint64 syncTime = 0;
 
+    QQuickWindowPrivate *d = QQuickWindowPrivate::get(window);
+    const bool recordFrameTiming = d->frameTimings.isEnabled();
+    QSGFrameTimings::Frame frameTiming;
+
     const qint64 elapsedSinceLastMs = w->timeBetweenPolishAndSyncs.restart();
 
     if (w->actualWindowFormat.swapInterval() != 0 && sg->isVSyncDependent(m_animation_driver)) {
@@ -1623,21 +1691,38 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
 
     const bool profileFrames = QSG_LOG_TIME_RENDERLOOP().isDebugEnabled();
     if (profileFrames) {
-        timer.start();
         qCDebug(QSG_LOG_TIME_RENDERLOOP, "[window %p][gui thread] polishAndSync: start, elapsed since last call: %d ms",
                 window,
                 int(elapsedSinceLastMs));
     }
+    if (profileFrames || recordFrameTiming)
+        timer.start();
     Q_QUICK_SG_PROFILE_START(QQuickProfiler::SceneGraphPolishAndSync);
     Q_TRACE(QSG_polishItems_entry);
 
-    QQuickWindowPrivate *d = QQuickWindowPrivate::get(window);
+    if (recordFrameTiming) {
+        // Garbage collection runs incrementally on the gui thread in between
+        // frames. The collector is shared by all windows of the engine, so
+        // each slice is only attributed to the first recorded frame after it.
+        if (QV4::GCStateMachine *gc = garbageCollector(window)) {
+            if (w->recordedFrameTiming) {
+                frameTiming.phases[QSGFrameTimings::GarbageCollection] =
+                        gc->totalTime - gc->attributedTime;
+            }
+            gc->attributedTime = gc->totalTime;
+        }
+        frameTiming.phases[QSGFrameTimings::Animations] = w->animationTime;
+    }
+    w->recordedFrameTiming = recordFrameTiming;
+    w->animationTime = 0;
+
     m_inPolish = true;
     d->polishItems();
     m_inPolish = false;
 
-    if (profileFrames)
+    if (profileFrames || recordFrameTiming)
         polishTime = timer.nsecsElapsed();
+    frameTiming.phases[QSGFrameTimings::Polish] = polishTime;
     Q_TRACE(QSG_polishItems_exit);
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
                               QQuickProfiler::SceneGraphPolishAndSyncPolish);
@@ -1653,7 +1738,12 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     qCDebug(QSG_LOG_RENDERLOOP, "- lock for sync");
     w->thread->mutex.lock();
     m_lockedForSync = true;
-    w->thread->postEvent(new WMSyncEvent(window, inExpose, w->forceRenderPass, scProxyData));
+    WMSyncEvent *syncEvent = new WMSyncEvent(window, inExpose, w->forceRenderPass, scProxyData);
+    if (recordFrameTiming) {
+        syncEvent->frameTiming = frameTiming;
+        syncEvent->syncWaitTimer.start();
+    }
+    w->thread->postEvent(syncEvent);
     w->forceRenderPass = false;
 
     qCDebug(QSG_LOG_RENDERLOOP, "- wait for sync");
@@ -1669,7 +1759,7 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
     w->thread->mutex.unlock();
     qCDebug(QSG_LOG_RENDERLOOP, "- unlock after sync");
 
-    if (profileFrames)
+    if (profileFrames || recordFrameTiming)
         syncTime = timer.nsecsElapsed();
     Q_TRACE(QSG_sync_exit);
     Q_QUICK_SG_PROFILE_RECORD(QQuickProfiler::SceneGraphPolishAndSync,
@@ -1729,6 +1819,9 @@ void QSGThreadedRenderLoop::polishAndSync(Window *w, bool inExpose)
         postUpdateRequest(w);
     }
 
+    if (recordFrameTiming)
+        w->animationTime = timer.nsecsElapsed() - syncTime;
+
     if (profileFrames) {
         qCDebug(QSG_LOG_TIME_RENDERLOOP, "[window %p][gui thread] Frame prepared, polish=%d ms, lock=%d ms, blockedForSync=%d ms, animations=%d ms",
                 window,
@@ -1752,6 +1845,7 @@ bool QSGThreadedRenderLoop::event(QEvent *e)
         QTimerEvent *te = static_cast<QTimerEvent *>(e);
         if (te->timerId() == m_animation_timer) {
             qCDebug(QSG_LOG_RENDERLOOP, "- ticking non-render thread timer");
+            startIncubationFrame();
             m_animation_driver->advance();
             emit timeToIncubate();
             return true;
@@ -69,9 +69,11 @@ private:
         QElapsedTimer timeBetweenPolishAndSyncs;
         float psTimeAccumulator;
         int psTimeSampleCount;
+        qint64 animationTime; // for QSGFrameTimings, attributed to the next frame
         uint updateDuringSync : 1;
         uint forceRenderPass : 1;
         uint badVSync : 1;
+        uint recordedFrameTiming : 1;
     };
 
     friend class QSGRenderThread;
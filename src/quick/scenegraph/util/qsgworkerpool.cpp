@@ -0,0 +1,88 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#include "qsgworkerpool_p.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qsemaphore.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+
+#include <atomic>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+class WorkerPool : public QThreadPool
+{
+public:
+    WorkerPool()
+    {
+        setObjectName(QStringLiteral("QSGWorkerPool"));
+        // the thread handing out the work is busy as well
+        setMaxThreadCount(qMax(1, QThread::idealThreadCount() - 1));
+    }
+};
+}
+
+Q_GLOBAL_STATIC(WorkerPool, qsg_workerPool)
+Q_CONSTINIT static QBasicMutex qsg_workerPoolMutex;
+
+/*!
+    \class QSGWorkerPool
+    \internal
+
+    The worker threads the scene graph spreads the work of a frame over, for
+    example when generating distance field glyphs, filling vertex buffers or
+    rasterizing the tiles of the software renderer. The pool is shared by all
+    of them and by all windows, so that several render threads do not
+    oversubscribe the CPU.
+ */
+
+QThreadPool *QSGWorkerPool::threadPool()
+{
+    return qsg_workerPool();
+}
+
+/*!
+    Calls \a work with every index from 0 to \a count - 1, on at most \a
+    threadCount threads. The calling thread is one of them: it works along
+    instead of waiting for the workers, so it never waits for a worker that is
+    busy with another request. Returns once all of the work is done.
+
+    The pool grows when \a threadCount asks for more workers than it has, for
+    example because an environment variable overrides the thread count.
+ */
+void QSGWorkerPool::run(qsizetype count, int threadCount, qxp::function_ref<void(qsizetype)> work)
+{
+    const int workerCount = int(qMin(qsizetype(threadCount), count)) - 1;
+    if (workerCount <= 0) {
+        for (qsizetype i = 0; i < count; ++i)
+            work(i);
+        return;
+    }
+
+    QThreadPool *pool = qsg_workerPool();
+    {
+        QMutexLocker locker(&qsg_workerPoolMutex);
+        if (pool->maxThreadCount() < workerCount)
+            pool->setMaxThreadCount(workerCount);
+    }
+
+    std::atomic<qsizetype> next = 0;
+    auto takeWork = [&] {
+        for (qsizetype i = next++; i < count; i = next++)
+            work(i);
+    };
+
+    QSemaphore finished;
+    int startedWorkers = 0;
+    for (; startedWorkers < workerCount; ++startedWorkers) {
+        if (!pool->tryStart([&] { takeWork(); finished.release(); }))
+            break;
+    }
+    takeWork();
+    finished.acquire(startedWorkers);
+}
+
+QT_END_NAMESPACE
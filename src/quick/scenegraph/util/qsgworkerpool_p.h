@@ -0,0 +1,38 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
+
+#ifndef QSGWORKERPOOL_P_H
+#define QSGWORKERPOOL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <private/qtquickglobal_p.h>
+
+#include <QtCore/qxpfunctional.h>
+
+QT_REQUIRE_CONFIG(thread);
+
+QT_BEGIN_NAMESPACE
+
+class QThreadPool;
+
+class Q_QUICK_EXPORT QSGWorkerPool
+{
+public:
+    static QThreadPool *threadPool();
+
+    static void run(qsizetype count, int threadCount, qxp::function_ref<void(qsizetype)> work);
+};
+
+QT_END_NAMESPACE
+
+#endif // QSGWORKERPOOL_P_H
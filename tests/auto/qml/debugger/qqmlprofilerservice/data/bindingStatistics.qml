@@ -0,0 +1,13 @@
+import QtQml 2.0
+
+QtObject {
+    property int input: 1
+    property int sign: input > 0 ? 1 : -1
+    property var signs: [input > 0]
+
+    Component.onCompleted: {
+        input = 2;
+        input = -1;
+        Qt.quit();
+    }
+}
@@ -208,6 +208,7 @@ private slots:
     void javascript();
     void flushInterval();
     void translationBinding();
+    void bindingStatistics();
     void memory();
     void compile();
     void multiEngine();
@@ -704,6 +705,57 @@ void tst_QQmlProfilerService::translationBinding()
            m_rangeEnd);
 }
 
+void tst_QQmlProfilerService::bindingStatistics()
+{
+    QCOMPARE(connectTo(true, "bindingStatistics.qml"), ConnectSuccess);
+    checkProcessTerminated();
+
+    checkTraceReceived();
+    checkJsHeap();
+
+    // The bindings for "sign" and "signs" are evaluated three times, with one dependency each
+    // time. The second evaluation of "sign" produces the same value as the first one, the third
+    // one changes it. Arrays are never compared, so "signs" is never redundant.
+    QList<QVector<qint64>> signEnds;
+    QList<QVector<qint64>> signsEnds;
+    int signType = -1;
+    int signsType = -1;
+    for (const QQmlProfilerEvent &event : std::as_const(m_client->qmlMessages)) {
+        const QQmlProfilerEventType &type = m_client->types.at(event.typeIndex());
+        if (type.rangeType() != Binding || event.rangeStage() != RangeEnd)
+            continue;
+        if (type.location().line() == 5) {
+            signEnds.append(event.numbers<QVector<qint64>>());
+            signType = event.typeIndex();
+        } else if (type.location().line() == 6) {
+            signsEnds.append(event.numbers<QVector<qint64>>());
+            signsType = event.typeIndex();
+        }
+    }
+
+    QCOMPARE(signEnds.size(), 3);
+    QCOMPARE(signEnds[0], QVector<qint64>({ RangeEnd, 1 }));
+    QCOMPARE(signEnds[1], QVector<qint64>({ RangeEnd, 1, 1 }));
+    QCOMPARE(signEnds[2], QVector<qint64>({ RangeEnd, 1 }));
+
+    QCOMPARE(signsEnds.size(), 3);
+    for (const QVector<qint64> &numbers : std::as_const(signsEnds))
+        QCOMPARE(numbers, QVector<qint64>({ RangeEnd, 1 }));
+
+    // The client aggregates the same numbers per binding.
+    const QQmlProfilerBindingStatistics signStatistics
+            = m_client->client->bindingStatistics(signType);
+    QCOMPARE(signStatistics.evaluations, 3);
+    QCOMPARE(signStatistics.redundantEvaluations, 1);
+    QCOMPARE(signStatistics.dependencies, 3);
+
+    const QQmlProfilerBindingStatistics signsStatistics
+            = m_client->client->bindingStatistics(signsType);
+    QCOMPARE(signsStatistics.evaluations, 3);
+    QCOMPARE(signsStatistics.redundantEvaluations, 0);
+    QCOMPARE(signsStatistics.dependencies, 3);
+}
+
 void tst_QQmlProfilerService::memory()
 {
     QCOMPARE(connectTo(true, "memory.qml"), ConnectSuccess);
@@ -13,6 +13,7 @@
 #include <QLoggingCategory>
 #include <private/qqmlcomponent_p.h>
 #include <private/qqmljscompilerstats_p.h>
+#include <private/qqmljscompilerstatsreporter_p.h>
 #include <private/qqmlscriptdata_p.h>
 #include <private/qv4compileddata_p.h>
 #include <qtranslator.h>
@@ -60,6 +61,8 @@ private slots:
 
     void reproducibleCache_data();
     void reproducibleCache();
+    void batchMode();
+    void batchModeCpp();
 
     void parameterAdjustment();
     void inlineComponent();
@@ -71,6 +74,7 @@ private slots:
     void saveableUnitPointer();
 
     void aotstatsSerialization();
+    void aotstatsDiff();
     void aotstatsGeneration_data();
     void aotstatsGeneration();
 };
@@ -805,6 +809,144 @@ void tst_qmlcachegen::reproducibleCache()
     QCOMPARE(contents1, contents2);
 }
 
+void tst_qmlcachegen::batchMode()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("Cannot call qmlcachegen on cross-compiled target.");
+#endif
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    QDir dir(dataDirectory());
+    const QStringList entries = dir.entryList({ "*.qml", "*.js", "*.mjs" }, QDir::Files);
+    QVERIFY(!entries.isEmpty());
+
+    QFile batchFile(tempDir.filePath("batch.txt"));
+    QVERIFY(batchFile.open(QIODevice::WriteOnly | QIODevice::Text));
+    for (const QString &entry : entries)
+        batchFile.write((dir.filePath(entry) + ';' + tempDir.filePath(entry + 'c') + '\n').toLocal8Bit());
+    batchFile.close();
+
+    QProcess proc;
+    proc.setProcessChannelMode(QProcess::ForwardedChannels);
+    proc.setProgram(QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
+                    + QLatin1String("/qmlcachegen"));
+    proc.setArguments({ "--batch", batchFile.fileName(), "--jobs", "4" });
+    proc.start();
+    QVERIFY(proc.waitForFinished());
+    QCOMPARE(proc.exitStatus(), QProcess::NormalExit);
+
+    // Files that fail to compile in single file mode also fail in batch mode.
+    bool anyFailed = false;
+    for (const QString &entry : entries) {
+        const QString single = dir.filePath(entry);
+        if (!generateCache(single)) {
+            anyFailed = true;
+            QVERIFY(!QFile::exists(tempDir.filePath(entry + 'c')));
+            continue;
+        }
+
+        QFile expected(single + 'c');
+        QVERIFY(expected.open(QIODevice::ReadOnly));
+        QFile actual(tempDir.filePath(entry + 'c'));
+        QVERIFY2(actual.open(QIODevice::ReadOnly), qPrintable(entry));
+        QCOMPARE(actual.readAll(), expected.readAll());
+        expected.close();
+        expected.remove();
+    }
+    QCOMPARE(proc.exitCode(), anyFailed ? 1 : 0);
+}
+
+void tst_qmlcachegen::batchModeCpp()
+{
+#if defined(QTEST_CROSS_COMPILED)
+    QSKIP("Cannot call qmlcachegen on cross-compiled target.");
+#endif
+
+    // Two documents that use each other's types. Generating C++ for them in one process has to
+    // resolve both and produce the same code as one process per file.
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const auto writeFile = [&](const QString &name, const QByteArray &content) {
+        QFile file(tempDir.filePath(name));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+            return false;
+        return file.write(content) == content.size();
+    };
+
+    QVERIFY(writeFile(u"A.qml"_s, R"(import QtQml
+QtObject {
+    property B other
+    property int value: 1
+    function otherValue(): int { return other ? other.value : -1 }
+}
+)"));
+    QVERIFY(writeFile(u"B.qml"_s, R"(import QtQml
+QtObject {
+    property A other
+    property int value: 2
+    function otherValue(): int { return other ? other.value : -1 }
+}
+)"));
+    QVERIFY(writeFile(u"mutual.qrc"_s, R"(<RCC>
+    <qresource prefix="/Mutual">
+        <file>A.qml</file>
+        <file>B.qml</file>
+    </qresource>
+</RCC>
+)"));
+
+    const QString qmlcachegen = QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
+            + QLatin1String("/qmlcachegen");
+    const QString qrc = tempDir.filePath(u"mutual.qrc"_s);
+    const QStringList documents = { u"A"_s, u"B"_s };
+
+    QFile batchFile(tempDir.filePath(u"batch.txt"_s));
+    QVERIFY(batchFile.open(QIODevice::WriteOnly | QIODevice::Text));
+    for (const QString &document : documents) {
+        batchFile.write((tempDir.filePath(document + u".qml"_s) + u';'
+                         + tempDir.filePath(document + u"_batch.cpp"_s)
+                         + u";/Mutual/"_s + document + u".qml\n"_s).toLocal8Bit());
+    }
+    batchFile.close();
+
+    QProcess batch;
+    batch.setProcessChannelMode(QProcess::ForwardedChannels);
+    batch.setProgram(qmlcachegen);
+    batch.setArguments({ u"--resource"_s, qrc, u"--batch"_s, batchFile.fileName(),
+                         u"--jobs"_s, u"2"_s });
+    batch.start();
+    QVERIFY(batch.waitForFinished());
+    QCOMPARE(batch.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(batch.exitCode(), 0);
+
+    for (const QString &document : documents) {
+        QProcess single;
+        single.setProcessChannelMode(QProcess::ForwardedChannels);
+        single.setProgram(qmlcachegen);
+        single.setArguments({ u"--resource"_s, qrc,
+                              u"--resource-path"_s, u"/Mutual/"_s + document + u".qml"_s,
+                              u"-o"_s, tempDir.filePath(document + u"_single.cpp"_s),
+                              tempDir.filePath(document + u".qml"_s) });
+        single.start();
+        QVERIFY(single.waitForFinished());
+        QCOMPARE(single.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(single.exitCode(), 0);
+
+        QFile expected(tempDir.filePath(document + u"_single.cpp"_s));
+        QVERIFY(expected.open(QIODevice::ReadOnly));
+        QFile actual(tempDir.filePath(document + u"_batch.cpp"_s));
+        QVERIFY(actual.open(QIODevice::ReadOnly));
+        const QByteArray code = actual.readAll();
+        QCOMPARE(code, expected.readAll());
+
+        // otherValue() can only be compiled if the other document's type was resolved.
+        QVERIFY(code.contains("aotBuiltFunctions[] = {\n{ "));
+    }
+}
+
 void tst_qmlcachegen::parameterAdjustment()
 {
     QQmlEngine engine;
@@ -961,6 +1103,87 @@ void tst_qmlcachegen::aotstatsSerialization()
     QVERIFY(equal(parsedB["File3"][0], originalB["File3"][0]));
 }
 
+void tst_qmlcachegen::aotstatsDiff()
+{
+    const auto createEntry = [](int micros, const QString &name, int line, bool success) {
+        QQmlJS::AotStatsEntry entry;
+        entry.codegenDuration = std::chrono::microseconds(micros);
+        entry.functionName = name;
+        entry.errorMessage = success ? QString() : u"err"_s;
+        entry.line = line;
+        entry.column = 4;
+        entry.codegenSuccessful = success;
+        return entry;
+    };
+
+    QQmlJS::AotStats before;
+    before.addEntry("ModuleA", "File1", createEntry(500, "stable", 1, true));
+    before.addEntry("ModuleA", "File1", createEntry(500, "regressed", 5, true));
+    before.addEntry("ModuleA", "File1", createEntry(500, "fixed", 9, false));
+    before.addEntry("ModuleA", "File1", createEntry(1000, "slower", 12, true));
+    before.addEntry("ModuleA", "File1", createEntry(100, "noisy", 15, true));
+
+    // Lines shift because the file was edited. The entries must still match up.
+    QQmlJS::AotStats after;
+    after.addEntry("ModuleA", "File1", createEntry(600, "stable", 3, true));
+    after.addEntry("ModuleA", "File1", createEntry(500, "regressed", 7, false));
+    after.addEntry("ModuleA", "File1", createEntry(500, "fixed", 11, true));
+    after.addEntry("ModuleA", "File1", createEntry(3000, "slower", 14, true));
+    after.addEntry("ModuleA", "File1", createEntry(300, "noisy", 17, true));
+    after.addEntry("ModuleA", "File1", createEntry(500, "added", 20, false));
+
+    const QQmlJS::AotStatsDiff diff = QQmlJS::AotStats::diff(
+            before, after, 50, std::chrono::microseconds(1000));
+    QVERIFY(diff.hasRegressions());
+    QCOMPARE(diff.regressions.size(), 1);
+    QCOMPARE(diff.regressions[0].after.functionName, u"regressed"_s);
+    QCOMPARE(diff.fixes.size(), 1);
+    QCOMPARE(diff.fixes[0].after.functionName, u"fixed"_s);
+    QCOMPARE(diff.slowdowns.size(), 1);
+    QCOMPARE(diff.slowdowns[0].after.functionName, u"slower"_s);
+
+    QVERIFY(!QQmlJS::AotStats::diff(before, before, 50, std::chrono::microseconds(0))
+                     .hasRegressions());
+
+    // Getting slower to compile is not a loss of AOT coverage.
+    QQmlJS::AotStats slower;
+    slower.addEntry("ModuleA", "File1", createEntry(5000, "stable", 1, true));
+    const QQmlJS::AotStatsDiff slowdownOnly = QQmlJS::AotStats::diff(
+            before, slower, 50, std::chrono::microseconds(1000));
+    QVERIFY(!slowdownOnly.hasRegressions());
+    QVERIFY(slowdownOnly.hasSlowdowns());
+
+    QTemporaryDir dir;
+    QFile counts(dir.filePath("counts.json"));
+    QVERIFY(counts.open(QIODevice::WriteOnly));
+    counts.write(R"([
+        { "filepath": "qrc:/qt/qml/ModuleA/File1", "functionName": "regressed",
+          "line": 7, "column": 4, "calls": 42 },
+        { "filepath": "qrc:/qt/qml/ModuleA/File1", "functionName": "added",
+          "line": 20, "column": 8, "calls": 7 },
+        { "filepath": "qrc:/qt/qml/ModuleB/File1", "functionName": "regressed",
+          "line": 7, "column": 4, "calls": 1000 }
+    ])");
+    counts.close();
+
+    // Files of the same name in other modules must not be mixed up.
+    after.setFileUrl("File1", "qrc:/qt/qml/ModuleA/File1");
+    QVERIFY(after.applyRuntimeCounts(counts.fileName()));
+
+    const auto &entries = after.entries()["ModuleA"]["File1"];
+    QCOMPARE(entries[1].runtimeFallbackCalls, qint64(42));
+    QCOMPARE(entries[5].runtimeFallbackCalls, qint64(7)); // matched by name, column differs
+    QCOMPARE(entries[0].runtimeFallbackCalls, qint64(0));
+
+    const auto parsed = QQmlJS::AotStats::fromJsonDocument(after.toJsonDocument());
+    QCOMPARE(parsed.entries()["ModuleA"]["File1"][1].runtimeFallbackCalls, qint64(42));
+    QCOMPARE(parsed.fileUrl("File1"), u"qrc:/qt/qml/ModuleA/File1"_s);
+
+    const QString report = QQmlJS::AotStatsReporter(after).format();
+    QVERIFY(report.contains(u"interpreted calls: 42"_s));
+    QVERIFY(report.indexOf(u"42 calls: regressed"_s) < report.indexOf(u"7 calls: added"_s));
+}
+
 struct FunctionEntry
 {
     QString name;
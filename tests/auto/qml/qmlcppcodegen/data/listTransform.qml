@@ -0,0 +1,32 @@
+import QtQml
+
+QtObject {
+    property list<int> input: [1, 2, 3, 4]
+    property list<int> output: transform(input, 3)
+
+    function transform(values: list<int>, offset: int): list<int> {
+        let result = [];
+        for (let i = 0; i < values.length; ++i) {
+            result.push(values[i] * 2);
+            result.push(values[i] + offset);
+        }
+        return result;
+    }
+
+    function sumAfterPush(values: list<int>): int {
+        let seen = [];
+        let sum = 0;
+        for (let i = 0; i < values.length; ++i) {
+            seen.push(values[i]);
+            sum += values[i];
+        }
+        return sum * 10 + seen.length;
+    }
+
+    function aliased(): int {
+        let a = [1];
+        let b = a;
+        b.push(2);
+        return a.length * 10 + a[1];
+    }
+}
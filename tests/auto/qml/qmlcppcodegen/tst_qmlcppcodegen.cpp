@@ -13,6 +13,7 @@
 #include <data/weathermoduleurl.h>
 #include <data/withlength.h>
 
+#include <QtQml/private/qqmlcomponent_p.h>
 #include <QtQml/private/qqmlengine_p.h>
 #include <QtQml/private/qqmlpropertycachecreator_p.h>
 
@@ -163,6 +164,7 @@ private slots:
     void listOfInvisible();
     void listPropertyAsModel();
     void listToString();
+    void listTransform();
     void lotsOfRegisters();
     void math();
     void mathMinMax();
@@ -278,6 +280,17 @@ extern const QQmlPrivate::AOTCompiledFunction aotBuiltFunctions[];
 }
 }
 
+static QStringList aotCompiledFunctions(QQmlComponent *component)
+{
+    QStringList result;
+    const auto &unit = QQmlComponentPrivate::get(component)->compilationUnit;
+    for (const QV4::Function *function : std::as_const(unit->runtimeFunctions)) {
+        if (function && function->kind == QV4::Function::AotCompiled)
+            result.append(function->name()->toQString());
+    }
+    return result;
+}
+
 static void checkColorProperties(QQmlComponent *component)
 {
     QVERIFY2(component->isReady(), qPrintable(component->errorString()));
@@ -3177,6 +3190,33 @@ void tst_QmlCppCodegen::listToString()
     QScopedPointer<QObject> o(c.create());
 }
 
+void tst_QmlCppCodegen::listTransform()
+{
+    QQmlEngine engine;
+    QQmlComponent c(&engine, QUrl(u"qrc:/qt/qml/TestTypes/listTransform.qml"_s));
+    QVERIFY2(c.isReady(), qPrintable(c.errorString()));
+    QScopedPointer<QObject> o(c.create());
+    QVERIFY(!o.isNull());
+
+    const QStringList compiled = aotCompiledFunctions(&c);
+    QVERIFY(compiled.contains(u"transform"_s));
+    QVERIFY(compiled.contains(u"sumAfterPush"_s));
+    QVERIFY(compiled.contains(u"aliased"_s));
+
+    QCOMPARE(o->property("output").value<QList<int>>(), (QList<int> { 2, 4, 4, 5, 6, 6, 8, 7 }));
+
+    int sum = 0;
+    QVERIFY(QMetaObject::invokeMethod(
+            o.data(), "sumAfterPush", Q_RETURN_ARG(int, sum),
+            Q_ARG(QList<int>, (QList<int> { 1, 2, 3 }))));
+    QCOMPARE(sum, 63);
+
+    // Pushing to one array has to be visible through all registers holding it.
+    int aliased = 0;
+    QVERIFY(QMetaObject::invokeMethod(o.data(), "aliased", Q_RETURN_ARG(int, aliased)));
+    QCOMPARE(aliased, 22);
+}
+
 void tst_QmlCppCodegen::lotsOfRegisters()
 {
     QQmlEngine engine;
@@ -123,6 +123,7 @@ private Q_SLOTS:
 
 #if QT_CONFIG(process)
     void importRelScript();
+    void projectMode();
 #endif
 
     void replayImportWarnings();
@@ -2527,6 +2528,125 @@ void TestQmllint::importRelScript()
     QVERIFY(proc.readAllStandardOutput().isEmpty());
     QVERIFY(proc.readAllStandardError().isEmpty());
 }
+
+void TestQmllint::projectMode()
+{
+    QTemporaryDir project;
+    QTemporaryDir cache;
+    QVERIFY(project.isValid());
+    QVERIFY(cache.isValid());
+    QVERIFY(QDir(project.path()).mkdir(u"sub"_s));
+    for (const QString &file : { u"Clean.qml"_s, u"Dirty.qml"_s, u"sub/AlsoClean.qml"_s }) {
+        QVERIFY(QFile::copy(testFile(u"projectMode/"_s + file), project.filePath(file)));
+        QFile::setPermissions(project.filePath(file),
+                              QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser
+                                      | QFile::WriteUser);
+    }
+
+    QTemporaryDir imports;
+    QVERIFY(imports.isValid());
+
+    const auto lintProject = [&](bool shouldSucceed) {
+        QProcess process;
+        process.start(m_qmllintPath,
+                      warningsShouldFailArgs()
+                              << u"--jobs"_s << u"2"_s << u"--cache-dir"_s << cache.path()
+                              << u"-I"_s << imports.path()
+                              << u"--json"_s << u"-"_s << project.path());
+        if (!process.waitForFinished())
+            return QJsonArray();
+        if (process.exitStatus() != QProcess::NormalExit
+            || (process.exitCode() == 0) != shouldSucceed) {
+            qDebug() << process.readAllStandardError();
+            return QJsonArray();
+        }
+        return QJsonDocument::fromJson(process.readAllStandardOutput())
+                .object()[u"files"_s].toArray();
+    };
+
+    const auto cacheEntries = [&]() {
+        return QDir(cache.path()).entryList({ u"*.clean"_s }, QDir::Files).size();
+    };
+
+    const auto warningsFor = [](const QJsonArray &files, const QString &fileName) {
+        for (const QJsonValue &file : files) {
+            if (file[u"filename"_s].toString().endsWith(fileName))
+                return file[u"warnings"_s].toArray().size();
+        }
+        return qsizetype(-1);
+    };
+
+    const auto isCached = [](const QJsonArray &files, const QString &fileName) {
+        for (const QJsonValue &file : files) {
+            if (file[u"filename"_s].toString().endsWith(fileName))
+                return file[u"cached"_s].toBool();
+        }
+        return false;
+    };
+
+    // All files of the project are linted, in a stable order. Only the clean ones are remembered.
+    QJsonArray files = lintProject(false);
+    QCOMPARE(files.size(), 3);
+    QVERIFY(files[0][u"filename"_s].toString().endsWith(u"/Clean.qml"_s));
+    QVERIFY(files[1][u"filename"_s].toString().endsWith(u"/Dirty.qml"_s));
+    QVERIFY(files[2][u"filename"_s].toString().endsWith(u"/sub/AlsoClean.qml"_s));
+    QCOMPARE(warningsFor(files, u"/Clean.qml"_s), 0);
+    QVERIFY(warningsFor(files, u"/Dirty.qml"_s) > 0);
+    QCOMPARE(warningsFor(files, u"/sub/AlsoClean.qml"_s), 0);
+    QCOMPARE(cacheEntries(), 2);
+    QVERIFY(!isCached(files, u"/Clean.qml"_s));
+    QVERIFY(!isCached(files, u"/sub/AlsoClean.qml"_s));
+
+    // Nothing changed. The clean files are skipped, the dirty one still warns.
+    files = lintProject(false);
+    QCOMPARE(files.size(), 3);
+    QVERIFY(warningsFor(files, u"/Dirty.qml"_s) > 0);
+    QCOMPARE(cacheEntries(), 2);
+    QVERIFY(isCached(files, u"/Clean.qml"_s));
+    QVERIFY(isCached(files, u"/sub/AlsoClean.qml"_s));
+    QVERIFY(!isCached(files, u"/Dirty.qml"_s));
+
+    // Fixing Dirty.qml invalidates the entries of its neighbours, but not the one in sub/.
+    QFile dirty(project.filePath(u"Dirty.qml"_s));
+    QVERIFY(dirty.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    dirty.write("import QtQml\n\nQtObject {\n    property int c: 3\n}\n");
+    dirty.close();
+
+    files = lintProject(true);
+    QCOMPARE(files.size(), 3);
+    QCOMPARE(warningsFor(files, u"/Dirty.qml"_s), 0);
+    QCOMPARE(cacheEntries(), 4);
+    QVERIFY(!isCached(files, u"/Clean.qml"_s));
+    QVERIFY(isCached(files, u"/sub/AlsoClean.qml"_s));
+
+    // A file using a module from an import path is linted again when the module changes.
+    QVERIFY(QDir(imports.path()).mkdir(u"Local"_s));
+    const auto writeFile = [](const QString &path, const QByteArray &content) {
+        QFile file(path);
+        return file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+                && file.write(content) == content.size();
+    };
+    QVERIFY(writeFile(imports.filePath(u"Local/qmldir"_s),
+                      "module Local\nThing 1.0 Thing.qml\n"));
+    QVERIFY(writeFile(imports.filePath(u"Local/Thing.qml"_s),
+                      "import QtQml\nQtObject {\n    property int d: 4\n}\n"));
+    QVERIFY(writeFile(project.filePath(u"sub/UsesLocal.qml"_s),
+                      "import Local\nThing {\n    d: 5\n}\n"));
+
+    files = lintProject(true);
+    QCOMPARE(files.size(), 4);
+    QCOMPARE(warningsFor(files, u"/sub/UsesLocal.qml"_s), 0);
+    QVERIFY(!isCached(files, u"/sub/UsesLocal.qml"_s));
+
+    files = lintProject(true);
+    QVERIFY(isCached(files, u"/sub/UsesLocal.qml"_s));
+
+    QVERIFY(writeFile(imports.filePath(u"Local/Thing.qml"_s),
+                      "import QtQml\nQtObject {\n    property string d: \"d\"\n}\n"));
+    files = lintProject(false);
+    QVERIFY(!isCached(files, u"/sub/UsesLocal.qml"_s));
+    QVERIFY(warningsFor(files, u"/sub/UsesLocal.qml"_s) > 0);
+}
 #endif
 
 void TestQmllint::replayImportWarnings()
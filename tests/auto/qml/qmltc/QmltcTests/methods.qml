@@ -15,4 +15,9 @@ QtObject {
         console.log("typedMethod, a  = " + a + ", b = " + b);
         return a + b;
     }
+
+    // The generated C++ method must not declare locals that shadow its parameters.
+    function methodWithUnit(unit: int): int {
+        return unit * 2;
+    }
 }
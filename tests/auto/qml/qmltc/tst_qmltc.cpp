@@ -327,6 +327,8 @@ void tst_qmltc::methods()
     QCOMPARE(metaTypedMethod.parameterMetaType(1), QMetaType::fromType<int>());
     QCOMPARE(metaTypedMethod.returnMetaType(), QMetaType::fromType<QString>());
     QCOMPARE(metaTypedMethod.parameterNames(), QList<QByteArray>({ "a", "b" }));
+
+    QCOMPARE(created.methodWithUnit(21), 42);
 }
 
 void tst_qmltc::properties()
@@ -828,6 +830,18 @@ void tst_qmltc::extensionTypeBindings()
         QCOMPARE(withExtensionNamespace->getCount(), -77);
         QCOMPARE(withExtensionNamespace->property("count").toInt(), -77);
     }
+
+    // The types behind the extensions are shared between all instances, also of other engines.
+    {
+        QQmlEngine e1;
+        QQmlEngine e2;
+        QScopedPointer<PREPEND_NAMESPACE(extensionTypeBindings)> first(
+                new PREPEND_NAMESPACE(extensionTypeBindings)(&e1));
+        PREPEND_NAMESPACE(extensionTypeBindings) second(&e2);
+        verifyExtensionType(first.get());
+        first.reset();
+        verifyExtensionType(&second);
+    }
 }
 
 // QTBUG-103956
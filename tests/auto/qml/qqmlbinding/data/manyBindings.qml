@@ -0,0 +1,14 @@
+import QtQml
+
+QtObject {
+    property int input: 0
+    property int a: input + 1
+    property int b: a * 2
+    property string c: "value " + b
+    property real d: b / 4
+    property bool e: a > 10
+    property int changes: 0
+
+    onBChanged: ++changes
+    onCChanged: ++changes
+}
@@ -10,6 +10,8 @@
 
 #include <QtTest/qtest.h>
 
+#include <QtCore/qthread.h>
+
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
 
@@ -46,6 +48,7 @@ private slots:
     void whenEvaluatedEarlyEnough();
     void propertiesAttachedToBindingItself();
     void toggleEnableProperlyRemembersValues();
+    void manyBindings();
 
 private:
     QQmlEngine engine;
@@ -674,6 +677,49 @@ void tst_qqmlbinding::toggleEnableProperlyRemembersValues()
     }
 }
 
+void tst_qqmlbinding::manyBindings()
+{
+    // Bindings and signal handlers are taken from per-engine pools. Create and destroy many of
+    // them, interleaved, so that pool slots get recycled, on two threads with separate engines.
+    const QUrl url = testFileUrl("manyBindings.qml");
+    const auto createAndDestroy = [&url](QQmlEngine *engine) {
+        QQmlComponent c(engine, url);
+        std::vector<std::unique_ptr<QObject>> objects;
+        for (int round = 0; round < 3; ++round) {
+            for (int i = 0; i < 1000; ++i) {
+                std::unique_ptr<QObject> o(c.create());
+                if (!o)
+                    return false;
+                o->setProperty("input", i);
+                if (o->property("b").toInt() != 2 * (i + 1)
+                        || o->property("c").toString() != QStringLiteral("value %1").arg(2 * (i + 1))
+                        || o->property("changes").toInt() < 2) {
+                    return false;
+                }
+                objects.push_back(std::move(o));
+            }
+
+            // Destroy every other object, so that the freed slots are reused in the next round.
+            for (size_t i = 0; i < objects.size(); i += 2)
+                objects[i].reset();
+            objects.erase(std::remove(objects.begin(), objects.end(), nullptr), objects.end());
+        }
+        return true;
+    };
+
+    bool workerResult = false;
+    std::unique_ptr<QThread> worker(QThread::create([&]() {
+        QQmlEngine workerEngine;
+        workerResult = createAndDestroy(&workerEngine);
+    }));
+    worker->start();
+
+    QQmlEngine mainEngine;
+    QVERIFY(createAndDestroy(&mainEngine));
+    QVERIFY(worker->wait());
+    QVERIFY(workerResult);
+}
+
 QTEST_MAIN(tst_qqmlbinding)
 
 #include "tst_qqmlbinding.moc"
@@ -26,6 +26,8 @@
 #include <private/qqmlcomponentattached_p.h>
 #include <private/qv4objectiterator_p.h>
 #include <private/qqmlabstractbinding_p.h>
+#include <private/qqmlbinding_p.h>
+#include <private/qqmlproperty_p.h>
 #include <private/qqmlvaluetypeproxybinding_p.h>
 #include <QtCore/private/qproperty_p.h>
 #include <QtQuick/qquickwindow.h>
@@ -428,6 +430,7 @@ private slots:
     void methodCallOnDerivedSingleton();
 
     void proxyMetaObject();
+    void staticBindingDependencies();
 
 private:
 //    static void propertyVarWeakRefCallback(v8::Persistent<v8::Value> object, void* parameter);
@@ -10651,6 +10654,156 @@ void tst_qqmlecmascript::proxyMetaObject()
     QVERIFY(MetaCallInterceptor::didGetObjectDestroyedCallback);
 }
 
+void tst_qqmlecmascript::staticBindingDependencies()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(R"(
+        import QtQml
+        QtObject {
+            id: root
+            property int a: 1
+            property int b: 2
+            property bool useA: true
+            property QtObject child: QtObject {
+                id: inner
+                property int c: 3
+            }
+
+            property int sum: a + b + inner.c
+            property int twice: a + a
+            property int chosen: useA ? a : b
+        }
+    )", QUrl("staticBindingDependencies.qml"));
+    QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+    QScopedPointer<QObject> o(component.create());
+    QVERIFY(o);
+
+    auto function = [&](const char *name) {
+        const QQmlProperty property(o.data(), QLatin1String(name));
+        QQmlAbstractBinding *binding = QQmlPropertyPrivate::binding(property);
+        return binding ? static_cast<QQmlBinding *>(binding)->function() : nullptr;
+    };
+
+    QVERIFY(function("sum"));
+    QVERIFY(function("sum")->hasStaticDependencies());
+    QVERIFY(function("twice"));
+    QVERIFY(function("twice")->hasStaticDependencies());
+    QVERIFY(function("chosen"));
+    QVERIFY(!function("chosen")->hasStaticDependencies());
+
+    QCOMPARE(o->property("sum").toInt(), 6);
+    QCOMPARE(o->property("twice").toInt(), 2);
+    QCOMPARE(o->property("chosen").toInt(), 1);
+
+    // Changes keep propagating after the dependencies have been captured once.
+    for (int i = 2; i < 5; ++i) {
+        o->setProperty("a", i);
+        QCOMPARE(o->property("sum").toInt(), i + 5);
+        QCOMPARE(o->property("twice").toInt(), 2 * i);
+    }
+
+    QObject *child = o->property("child").value<QObject *>();
+    QVERIFY(child);
+    child->setProperty("c", 10);
+    QCOMPARE(o->property("sum").toInt(), 16);
+    o->setProperty("b", 5);
+    QCOMPARE(o->property("sum").toInt(), 19);
+
+    o->setProperty("useA", false);
+    QCOMPARE(o->property("chosen").toInt(), 5);
+    o->setProperty("b", 7);
+    QCOMPARE(o->property("chosen").toInt(), 7);
+
+    // Ids declared in implicit components are not visible to the enclosing component.
+    QQmlComponent implicit(&engine);
+    implicit.setData(R"(
+        import QtQml
+        QtObject {
+            id: root
+            property int a: 1
+            property Component delegate: QtObject {
+                id: inDelegate
+                property int c: root.a + 1
+            }
+            property int outer: a + inDelegate.c
+        }
+    )", QUrl("implicitComponentIds.qml"));
+    QVERIFY2(implicit.isReady(), qPrintable(implicit.errorString()));
+    o.reset(implicit.create());
+    QVERIFY(o);
+    QVERIFY(function("outer"));
+    QVERIFY(!function("outer")->hasStaticDependencies());
+
+    // Bindings depending on non-bindable properties keep warning on each evaluation.
+    QQmlComponent nonNotifyable(&engine);
+    nonNotifyable.setData(R"(
+        import Qt.test
+        MyQmlObject {
+            id: root
+            property bool test: root.value === root.intProperty
+        }
+    )", QUrl("staticNonNotifyable.qml"));
+    QQmlTestMessageHandler messageHandler;
+    o.reset(nonNotifyable.create());
+    QVERIFY2(o, qPrintable(nonNotifyable.errorString()));
+    QVERIFY(function("test"));
+    QVERIFY(function("test")->hasStaticDependencies());
+    QCOMPARE(messageHandler.messages().size(), 2);
+    messageHandler.clear();
+    o->setProperty("intProperty", 5);
+    QCOMPARE(messageHandler.messages().size(), 2);
+
+    // Converting objects to primitives may call their valueOf() methods, which can read different
+    // properties on each evaluation.
+    QQmlComponent valueOf(&engine);
+    valueOf.setData(R"(
+        import QtQml
+        QtObject {
+            id: root
+            property int a: 1
+            property int b: 2
+            property bool useB: false
+            property var number: ({ valueOf: () => root.useB ? root.b : root.a })
+            property QtObject child: QtObject {
+                id: inner
+                property var number: root.number
+            }
+
+            property int direct: number + 0
+            property int viaId: inner.number + 0
+            property string viaTemplate: `${number}`
+            property var plain: number
+        }
+    )", QUrl("staticValueOf.qml"));
+    QVERIFY2(valueOf.isReady(), qPrintable(valueOf.errorString()));
+    o.reset(valueOf.create());
+    QVERIFY(o);
+
+    QVERIFY(function("direct"));
+    QVERIFY(!function("direct")->hasStaticDependencies());
+    QVERIFY(function("viaId"));
+    QVERIFY(!function("viaId")->hasStaticDependencies());
+    QVERIFY(function("viaTemplate"));
+    QVERIFY(!function("viaTemplate")->hasStaticDependencies());
+    QVERIFY(function("plain"));
+    QVERIFY(function("plain")->hasStaticDependencies());
+
+    QCOMPARE(o->property("direct").toInt(), 1);
+    QCOMPARE(o->property("viaId").toInt(), 1);
+    QCOMPARE(o->property("viaTemplate").toString(), QStringLiteral("1"));
+
+    // "b" is only read once "useB" is set. The bindings still have to pick up changes of it.
+    o->setProperty("useB", true);
+    QCOMPARE(o->property("direct").toInt(), 2);
+    QCOMPARE(o->property("viaId").toInt(), 2);
+    QCOMPARE(o->property("viaTemplate").toString(), QStringLiteral("2"));
+    o->setProperty("b", 7);
+    QCOMPARE(o->property("direct").toInt(), 7);
+    QCOMPARE(o->property("viaId").toInt(), 7);
+    QCOMPARE(o->property("viaTemplate").toString(), QStringLiteral("7"));
+}
+
 QTEST_MAIN(tst_qqmlecmascript)
 
 #include "tst_qqmlecmascript.moc"
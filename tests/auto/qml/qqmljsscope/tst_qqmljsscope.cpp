@@ -10,6 +10,7 @@
 #include <QtCore/qurl.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qscopedpointer.h>
+#include <QtCore/qtemporarydir.h>
 #include <QtQml/qqmlengine.h>
 #include <QtQml/qqmlcomponent.h>
 #include <QtGui/qfont.h>
@@ -17,6 +18,7 @@
 #include <QtQml/private/qqmlirbuilder_p.h>
 #include <private/qqmljscompiler_p.h>
 #include <private/qqmljsscope_p.h>
+#include <private/qqmljsimportcache_p.h>
 #include <private/qqmljsimporter_p.h>
 #include <private/qqmljslogger_p.h>
 #include <private/qqmljsimportvisitor_p.h>
@@ -119,6 +121,7 @@ private Q_SLOTS:
     void methodAndSignalSourceLocation();
     void modulePrefixes();
     void javaScriptBuiltinFlag();
+    void importCache();
 
 public:
     tst_qqmljsscope()
@@ -1045,5 +1048,140 @@ void tst_qqmljsscope::javaScriptBuiltinFlag()
     QVERIFY(!typeResolver.varType()->isJavaScriptBuiltin()); // C++
 }
 
+void tst_qqmljsscope::importCache()
+{
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+
+    const QStringList importPaths = {
+        QLibraryInfo::path(QLibraryInfo::QmlImportsPath),
+        dataDirectory(),
+    };
+
+    QQmlJSImporter uncached { importPaths, nullptr };
+    uncached.setImportCacheDirectory(QString());
+    const auto expected = uncached.importModule(u"QtQml"_s).types();
+
+    QQmlJSImporter populating { importPaths, nullptr };
+    populating.setImportCacheDirectory(cacheDir.path());
+    QCOMPARE(populating.importModule(u"QtQml"_s).types().keys().size(), expected.keys().size());
+    QVERIFY(!QDir(cacheDir.path()).entryList({ u"*.qmltypescache"_s }, QDir::Files).isEmpty());
+
+    QQmlJSImporter cached { importPaths, nullptr };
+    cached.setImportCacheDirectory(cacheDir.path());
+    const auto actual = cached.importModule(u"QtQml"_s).types();
+
+    QCOMPARE(actual.keys().size(), expected.keys().size());
+    for (auto it = expected.constBegin(), end = expected.constEnd(); it != end; ++it) {
+        const QQmlJSScope::ConstPtr expectedScope = it->scope;
+        const QQmlJSScope::ConstPtr actualScope = actual.value(it.key()).scope;
+        QVERIFY2(actualScope, qPrintable(it.key()));
+        if (!expectedScope)
+            continue;
+
+        QCOMPARE(actualScope->internalName(), expectedScope->internalName());
+        QCOMPARE(actualScope->baseTypeName(), expectedScope->baseTypeName());
+        QCOMPARE(actualScope->accessSemantics(), expectedScope->accessSemantics());
+        QCOMPARE(actualScope->isCreatable(), expectedScope->isCreatable());
+        const auto expectedProperties = expectedScope->ownProperties();
+        const auto actualProperties = actualScope->ownProperties();
+        QCOMPARE(actualProperties.size(), expectedProperties.size());
+        for (const QQmlJSMetaProperty &property : expectedProperties) {
+            const QQmlJSMetaProperty cachedProperty = actualProperties.value(property.propertyName());
+            QCOMPARE(cachedProperty.typeName(), property.typeName());
+            QCOMPARE(cachedProperty.isWritable(), property.isWritable());
+            QCOMPARE(cachedProperty.isList(), property.isList());
+            QCOMPARE(cachedProperty.notify(), property.notify());
+            QCOMPARE(cachedProperty.revision(), property.revision());
+            QCOMPARE(cachedProperty.index(), property.index());
+        }
+
+        const auto expectedEnums = expectedScope->ownEnumerations();
+        const auto actualEnums = actualScope->ownEnumerations();
+        QCOMPARE(actualEnums.size(), expectedEnums.size());
+        for (const QQmlJSMetaEnum &metaEnum : expectedEnums) {
+            QCOMPARE(actualEnums.value(metaEnum.name()).keys(), metaEnum.keys());
+            QCOMPARE(actualEnums.value(metaEnum.name()).values(), metaEnum.values());
+        }
+
+        // Overloads have to come back in the same order.
+        const auto expectedMethods = expectedScope->ownMethods();
+        const auto actualMethods = actualScope->ownMethods();
+        QCOMPARE(actualMethods.size(), expectedMethods.size());
+        for (const QString &name : expectedMethods.uniqueKeys()) {
+            const QList<QQmlJSMetaMethod> expectedOverloads = expectedMethods.values(name);
+            const QList<QQmlJSMetaMethod> actualOverloads = actualMethods.values(name);
+            QCOMPARE(actualOverloads.size(), expectedOverloads.size());
+            for (qsizetype i = 0; i < expectedOverloads.size(); ++i) {
+                QCOMPARE(actualOverloads[i].methodType(), expectedOverloads[i].methodType());
+                QCOMPARE(actualOverloads[i].returnTypeName(), expectedOverloads[i].returnTypeName());
+                QCOMPARE(actualOverloads[i].parameterNames(), expectedOverloads[i].parameterNames());
+            }
+        }
+    }
+
+    // The same content found in a different module directory has to come from the cache, and must
+    // not carry anything over from the file the entry was created from. Plant a marker in the
+    // entry to tell a cache hit from re-parsing the file.
+    const QByteArray qmltypes = R"(import QtQuick.tooling 1.2
+Module {
+    Component {
+        file: "cachetest.h"
+        name: "CacheTestType"
+        accessSemantics: "reference"
+        prototype: "QObject"
+        exports: ["CacheTest/CacheTestType 1.0"]
+        exportMetaObjectRevisions: [256]
+        Property { name: "value"; type: "int" }
+    }
+}
+)";
+    QTemporaryDir moduleDir;
+    QVERIFY(moduleDir.isValid());
+    const auto writeModule = [&](const QString &importPath) {
+        QDir dir(importPath);
+        if (!dir.mkpath(u"CacheTest"_s))
+            return QString();
+        QFile qmldir(dir.filePath(u"CacheTest/qmldir"_s));
+        QFile types(dir.filePath(u"CacheTest/cachetest.qmltypes"_s));
+        if (!qmldir.open(QIODevice::WriteOnly) || !types.open(QIODevice::WriteOnly))
+            return QString();
+        qmldir.write("module CacheTest\ntypeinfo cachetest.qmltypes\n");
+        types.write(qmltypes);
+        return types.fileName();
+    };
+
+    const QString firstPath = moduleDir.filePath(u"first"_s);
+    const QString secondPath = moduleDir.filePath(u"second"_s);
+    const QString firstTypes = writeModule(firstPath);
+    const QString secondTypes = writeModule(secondPath);
+    QVERIFY(!firstTypes.isEmpty());
+    QVERIFY(!secondTypes.isEmpty());
+
+    QQmlJSImporter first { { QLibraryInfo::path(QLibraryInfo::QmlImportsPath), firstPath }, nullptr };
+    first.setImportCacheDirectory(cacheDir.path());
+    QVERIFY(first.importModule(u"CacheTest"_s).type(u"CacheTestType"_s).scope);
+
+    const QQmlJSImportCache cache(cacheDir.path());
+    const QByteArray hash = QQmlJSImportCache::contentHash(qmltypes);
+    QQmlJSImportCache::Entry entry;
+    QVERIFY(cache.load(hash, &entry));
+    QCOMPARE(entry.objects.size(), 1);
+    QQmlJSMetaProperty marker;
+    marker.setPropertyName(u"cacheMarker"_s);
+    marker.setTypeName(u"int"_s);
+    entry.objects[0].scope->addOwnProperty(marker);
+    QVERIFY(cache.store(hash, entry));
+
+    QQmlJSImporter second { { QLibraryInfo::path(QLibraryInfo::QmlImportsPath), secondPath }, nullptr };
+    second.setImportCacheDirectory(cacheDir.path());
+    const QQmlJSScope::ConstPtr fromCache
+            = second.importModule(u"CacheTest"_s).type(u"CacheTestType"_s).scope;
+    QVERIFY(fromCache);
+    QVERIFY(fromCache->hasOwnProperty(u"cacheMarker"_s));
+    QVERIFY(fromCache->hasOwnProperty(u"value"_s));
+    QCOMPARE(fromCache->filePath(), u"cachetest.h"_s);
+}
+
 QTEST_MAIN(tst_qqmljsscope)
 #include "tst_qqmljsscope.moc"
@@ -21,6 +21,7 @@ public:
 private slots:
     void properties();
     void propertiesDerived();
+    void propertyNames();
     void revisionedProperties();
     void methods();
     void methodsDerived();
@@ -185,6 +186,21 @@ const QQmlPropertyData *cacheProperty(const QQmlPropertyCache::ConstPtr &cache,
     return cache->property(QLatin1String(name), nullptr, nullptr);
 }
 
+class PrefixNames : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(int v READ v CONSTANT)
+    Q_PROPERTY(int value READ value CONSTANT)
+    Q_PROPERTY(int valueX READ valueX CONSTANT)
+    Q_PROPERTY(int valueXY READ valueXY CONSTANT)
+
+public:
+    int v() const { return 1; }
+    int value() const { return 2; }
+    int valueX() const { return 3; }
+    int valueXY() const { return 4; }
+};
+
 void tst_qqmlpropertycache::properties()
 {
     QQmlEngine engine;
@@ -207,6 +223,38 @@ void tst_qqmlpropertycache::properties()
     QCOMPARE(data->coreIndex(), metaObject->indexOfProperty("propertyD"));
 }
 
+void tst_qqmlpropertycache::propertyNames()
+{
+    // The property names are taken from the string data of the meta object, with their lengths.
+    // Names that are prefixes of each other need to be told apart.
+    const QMetaObject *metaObject = &PrefixNames::staticMetaObject;
+    QQmlPropertyCache::ConstPtr cache = QQmlPropertyCache::createStandalone(metaObject);
+    const QQmlPropertyData *data;
+
+    for (const char *name : { "v", "value", "valueX", "valueXY" }) {
+        QVERIFY((data = cacheProperty(cache, name)));
+        QCOMPARE(data->coreIndex(), metaObject->indexOfProperty(name));
+    }
+    QVERIFY(!cacheProperty(cache, "val"));
+    QVERIFY(!cacheProperty(cache, "valueXYZ"));
+
+    // Meta objects created at runtime have the same layout.
+    QMetaObjectBuilder builder;
+    builder.setClassName("DynamicNames");
+    builder.setSuperClass(&QObject::staticMetaObject);
+    builder.addProperty("dyn", "int");
+    builder.addProperty("dynamicProperty", "QString");
+    QScopedPointer<QMetaObject, QScopedPointerPodDeleter> dynamic(builder.toMetaObject());
+    QVERIFY(!dynamic.isNull());
+
+    cache = QQmlPropertyCache::createStandalone(dynamic.data());
+    for (const char *name : { "dyn", "dynamicProperty" }) {
+        QVERIFY((data = cacheProperty(cache, name)));
+        QCOMPARE(data->coreIndex(), dynamic->indexOfProperty(name));
+    }
+    QVERIFY(!cacheProperty(cache, "dynamic"));
+}
+
 void tst_qqmlpropertycache::propertiesDerived()
 {
     QQmlEngine engine;
@@ -17,6 +17,10 @@ void tst_qmlls_cli::initTestCase()
     // qmllanguageservertool.cpp)
     m_qmllsPath = qEnvironmentVariable("QMLLS", m_qmllsPath);
     m_server.setProgram(m_qmllsPath);
+
+    // don't touch the index cache of the user
+    QVERIFY(m_indexCacheDir.isValid());
+    qputenv("QMLLS_INDEX_CACHE", m_indexCacheDir.filePath(u"index"_s).toLocal8Bit());
 }
 
 void tst_qmlls_cli::cleanup()
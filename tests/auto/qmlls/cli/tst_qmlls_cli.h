@@ -11,6 +11,7 @@
 #include <QtCore/qprocess.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qlibraryinfo.h>
+#include <QtCore/qtemporarydir.h>
 
 #include <QtTest/qtest.h>
 
@@ -33,6 +34,7 @@ public:
     QProcess m_server;
     QString m_qmllsPath;
     std::unique_ptr<QLanguageServerProtocol> m_protocol;
+    QTemporaryDir m_indexCacheDir;
 };
 
 #endif // TST_QMLLS_CLI_H
@@ -157,6 +157,9 @@ void tst_qmlls_modules::initTestCase()
                 QStringLiteral("qmlls executable not found (looked for %0)").arg(m_qmllsPath);
         QSKIP(qPrintable(message)); // until we add a feature for this we avoid failing here
     }
+    // don't touch the index cache of the user
+    QVERIFY(m_indexCacheDir.isValid());
+    qputenv("QMLLS_INDEX_CACHE", m_indexCacheDir.filePath(u"index"_s).toLocal8Bit());
 }
 
 void tst_qmlls_modules::checkCompletions(const QByteArray &uri, int lineNr, int character,
@@ -13,6 +13,7 @@
 #include <QtCore/qprocess.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qstringlist.h>
+#include <QtCore/qtemporarydir.h>
 
 #include <QtTest/qtest.h>
 #include <QtQmlLS/private/qlspcustomtypes_p.h>
@@ -85,6 +86,7 @@ private:
     std::unique_ptr<QLanguageServerProtocol> m_protocol;
     QString m_qmllsPath;
     QList<QByteArray> m_uriToClose;
+    QTemporaryDir m_indexCacheDir;
 };
 
 #endif // TST_QMLLSMODULES_H
@@ -7,6 +7,7 @@
 #include <QtCore/qobject.h>
 #include <QtCore/qprocess.h>
 #include <QtCore/qlibraryinfo.h>
+#include <QtCore/qtemporarydir.h>
 
 #include <QtTest/qtest.h>
 
@@ -83,6 +84,7 @@ private:
     DiagnosticsHandler m_diagnosticsHandler;
     QString m_qmllsPath;
     QList<RegistrationParams> m_registrations;
+    QTemporaryDir m_indexCacheDir;
 };
 
 tst_Qmlls::tst_Qmlls()
@@ -126,6 +128,9 @@ void tst_Qmlls::initTestCase()
                 QStringLiteral("qmlls executable not found (looked for %0)").arg(m_qmllsPath);
         QSKIP(qPrintable(message)); // until we add a feature for this we avoid failing here
     }
+    // don't touch the index cache of the user
+    QVERIFY(m_indexCacheDir.isValid());
+    qputenv("QMLLS_INDEX_CACHE", m_indexCacheDir.filePath(u"index"_s).toLocal8Bit());
     m_server.start();
     InitializeParams clientInfo;
     clientInfo.rootUri = QUrl::fromLocalFile(dataDirectory() + "/default").toString().toUtf8();
@@ -5,10 +5,13 @@
 
 #include <QtQmlToolingSettings/private/qqmltoolingsettings_p.h>
 #include <QtQmlLS/private/qqmlcodemodel_p.h>
+#include <QtQmlLS/private/qqmllsindex_p.h>
 #include <QtQmlLS/private/qqmllsutils_p.h>
 #include <QtQmlDom/private/qqmldomitem_p.h>
 #include <QtQmlDom/private/qqmldomtop_p.h>
 
+#include <QtCore/qtemporarydir.h>
+
 tst_qmlls_qqmlcodemodel::tst_qmlls_qqmlcodemodel() : QQmlDataTest(QT_QQMLCODEMODEL_DATADIR) { }
 
 void tst_qmlls_qqmlcodemodel::buildPathsForFileUrl_data()
@@ -202,6 +205,32 @@ void tst_qmlls_qqmlcodemodel::openFiles()
     }
 }
 
+void tst_qmlls_qqmlcodemodel::unchangedDocIsNotReparsed()
+{
+    QmlLsp::QQmlCodeModel model;
+
+    const QByteArray fileAUrl = testFileUrl(u"FileA.qml"_s).toEncoded();
+    const QString code = readFile(u"FileA.qml"_s);
+
+    model.newOpenFile(fileAUrl, 0, code);
+    QTRY_VERIFY_WITH_TIMEOUT(model.snapshotByUrl(fileAUrl).validDocVersion, 3000);
+
+    const auto before = model.snapshotByUrl(fileAUrl);
+    const auto fileBefore = before.doc.fileObject().ownerAs<QmlFile>();
+    QVERIFY(fileBefore);
+
+    model.newDocForOpenFile(fileAUrl, 1, code);
+    const auto after = model.snapshotByUrl(fileAUrl);
+    QCOMPARE(after.docVersion.value_or(-1), 1);
+    QCOMPARE(after.validDocVersion.value_or(-1), 1);
+    QCOMPARE(after.doc.fileObject().ownerAs<QmlFile>(), fileBefore);
+
+    model.newDocForOpenFile(fileAUrl, 2, readFile(u"FileA2.qml"_s));
+    const auto changed = model.snapshotByUrl(fileAUrl);
+    QCOMPARE(changed.docVersion.value_or(-1), 2);
+    QVERIFY(changed.doc.fileObject().ownerAs<QmlFile>() != fileBefore);
+}
+
 void tst_qmlls_qqmlcodemodel::importPathViaSettings()
 {
     // prepare the qmlls.ini file
@@ -242,4 +271,102 @@ void tst_qmlls_qqmlcodemodel::importPathViaSettings()
     }
 }
 
+void tst_qmlls_qqmlcodemodel::indexWorkspace()
+{
+    QTemporaryDir workspace;
+    QVERIFY(workspace.isValid());
+
+    // enough files in enough directories to keep several index workers busy
+    QStringList files;
+    for (int i = 0; i < 4; ++i) {
+        const QString dir = workspace.filePath(u"dir%1"_s.arg(i));
+        QVERIFY(QDir().mkpath(dir));
+        for (int j = 0; j < 8; ++j) {
+            QFile file(dir + u"/Item%1.qml"_s.arg(j));
+            QVERIFY(file.open(QFile::WriteOnly | QFile::Text));
+            file.write("import QtQml\nQtObject { property int value: 42 }\n");
+            files << QFileInfo(file).canonicalFilePath();
+        }
+    }
+
+    QmlLsp::QQmlCodeModel model;
+    model.setIndexCacheFile(QString()); // don't touch the real cache
+    model.addDirectoriesToIndex({ workspace.path() }, nullptr);
+
+    for (const QString &file : std::as_const(files)) {
+        QTRY_VERIFY_WITH_TIMEOUT(model.validEnv().field(Fields::qmlFileWithPath).key(file),
+                                 10000);
+    }
+}
+
+void tst_qmlls_qqmlcodemodel::persistentIndex()
+{
+    QTemporaryDir cache;
+    QVERIFY(cache.isValid());
+    const QString cacheFile = cache.filePath(u"index"_s);
+
+    {
+        QmlLsp::QQmlLSIndex index;
+        index.setCacheFile(cacheFile);
+        index.update(u"/a/Foo.qml"_s, u"Item { property int bar; onBarChanged: baz() }"_s);
+        index.update(u"/a/Broken.qml"_s, u"Item { property string s: \"unterminated"_s);
+        QVERIFY(index.save());
+    }
+
+    QmlLsp::QQmlLSIndex index;
+    index.setCacheFile(cacheFile);
+    QVERIFY(index.load());
+
+    // entries from disk are only trusted once the content of the file was checked
+    QVERIFY(index.entry(u"/a/Foo.qml"_s));
+    QVERIFY(index.mightUse(u"/a/Foo.qml"_s, { u"unused"_s }));
+    index.update(u"/a/Foo.qml"_s, u"Item { property int bar; onBarChanged: baz() }"_s);
+    index.update(u"/a/Broken.qml"_s, u"Item { property string s: \"unterminated"_s);
+
+    QVERIFY(index.mightUse(u"/a/Foo.qml"_s, { u"bar"_s }));
+    QVERIFY(index.mightUse(u"/a/Foo.qml"_s, { u"unused"_s, u"onBarChanged"_s }));
+    QVERIFY(!index.mightUse(u"/a/Foo.qml"_s, { u"unused"_s }));
+    // files that could not be lexed and unknown files are always candidates
+    QVERIFY(index.mightUse(u"/a/Broken.qml"_s, { u"unused"_s }));
+    QVERIFY(index.mightUse(u"/a/Unknown.qml"_s, { u"unused"_s }));
+
+    // an outdated entry is recomputed
+    index.update(u"/a/Foo.qml"_s, u"Item { property int unused }"_s);
+    QVERIFY(index.mightUse(u"/a/Foo.qml"_s, { u"unused"_s }));
+    QVERIFY(!index.mightUse(u"/a/Foo.qml"_s, { u"bar"_s }));
+
+    index.removePath(u"/a"_s);
+    QVERIFY(!index.entry(u"/a/Foo.qml"_s));
+}
+
+void tst_qmlls_qqmlcodemodel::indexRegExpLiterals_data()
+{
+    QTest::addColumn<QString>("code");
+    QTest::addColumn<bool>("complete");
+
+    QTest::newRow("regExp") << u"Item { property bool b: /'/.test(s) || used }"_s << true;
+    QTest::newRow("regExpAfterKeyword")
+            << u"Item { function f() { return /\"/.test(used) } }"_s << true;
+    QTest::newRow("regExpAfterAssignment") << u"Item { property var r: /=\"/; property int used }"_s
+                                           << true;
+    QTest::newRow("division") << u"Item { property int w: width / 2 / used }"_s << true;
+    QTest::newRow("divisionAfterParenthesis")
+            << u"Item { property int w: (width + 1) / 2 + used }"_s << true;
+    // could be a regular expression hiding the rest of the line in a string
+    QTest::newRow("ambiguous")
+            << u"Item { function f() { if (a) /'/.test(s); used = \"'\" } }"_s << false;
+}
+
+void tst_qmlls_qqmlcodemodel::indexRegExpLiterals()
+{
+    QFETCH(QString, code);
+    QFETCH(bool, complete);
+
+    bool isComplete = false;
+    const QSet<QString> identifiers = QmlLsp::QQmlLSIndex::identifiersOf(code, &isComplete);
+    QCOMPARE(isComplete, complete);
+    if (complete)
+        QVERIFY(identifiers.contains(u"used"_s));
+}
+
 QTEST_MAIN(tst_qmlls_qqmlcodemodel)
@@ -32,7 +32,12 @@ private slots:
     void findFilePathsFromFileNames_data();
     void findFilePathsFromFileNames();
     void openFiles();
+    void unchangedDocIsNotReparsed();
     void importPathViaSettings();
+    void indexWorkspace();
+    void persistentIndex();
+    void indexRegExpLiterals_data();
+    void indexRegExpLiterals();
 };
 
 #endif // TST_QMLLS_QQMLCODEMODEL_H
@@ -0,0 +1,16 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+import QtQuick
+
+// only mentions boundProperty in a string
+Item {
+    BoundProperty {
+        id: bound
+    }
+
+    Binding {
+        target: bound
+        property: "boundProperty"
+        value: 42
+    }
+}
@@ -7,6 +7,7 @@
 
 #include <QtCore/private/qduplicatetracker_p.h>
 #include <QtQmlLS/private/qdochtmlparser_p.h>
+#include <QtQmlLS/private/qqmllsindex_p.h>
 
 // some helper constants for the tests
 const static int positionAfterOneIndent = 5;
@@ -1296,6 +1297,20 @@ void tst_qmlls_utils::findUsages_data()
         QTest::addRow("propertyInBindingsFromDecl") << 11 << 23 << bindings;
         QTest::addRow("generalizedGroupPropertyBindings") << 27 << 19 << bindings;
     }
+    {
+        const auto testFileName = testFile("findUsages/bindingInAnotherFile/BoundProperty.qml");
+        const auto testFileContent = readFileContent(testFileName);
+        const auto otherFileName =
+                testFile("findUsages/bindingInAnotherFile/BindingInAnotherFile.qml");
+        const auto otherFileContent = readFileContent(otherFileName);
+        QList<QQmlLSUtils::Location> expectedUsages;
+        expectedUsages << QQmlLSUtils::Location::from(testFileName, testFileContent, 6, 18,
+                                                      strlen("boundProperty"));
+        expectedUsages << QQmlLSUtils::Location::from(otherFileName, otherFileContent, 13, 19,
+                                                      strlen("\"boundProperty\""));
+        const auto bindingInAnotherFile = makeUsages(testFileName, expectedUsages);
+        QTest::addRow("propertyInBindingInAnotherFile") << 6 << 18 << bindingInAnotherFile;
+    }
     {
         const auto testFileName = testFile("findUsages/enums/Enums.qml");
         const auto testFileContent = readFileContent(testFileName);
@@ -1482,6 +1497,13 @@ void tst_qmlls_utils::findUsages()
     }
 
     QCOMPARE(usages, data.expectedUsages);
+
+    // the index of qmlls must not make find usages skip any file with usages
+    QmlLsp::QQmlLSIndex index;
+    const QQmlJS::Dom::DomItem qmlFiles = env.field(QQmlJS::Dom::Fields::qmlFileWithPath);
+    for (const QString &path : qmlFiles.keys())
+        index.update(path, readFileContent(path));
+    QCOMPARE(QQmlLSUtils::findUsagesOf(locations.front().domItem, &index), data.expectedUsages);
 }
 
 
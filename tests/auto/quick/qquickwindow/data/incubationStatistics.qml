@@ -0,0 +1,17 @@
+import QtQuick
+
+Window {
+    width: 200
+    height: 200
+
+    Loader {
+        objectName: "loader"
+        asynchronous: true
+        sourceComponent: Column {
+            Repeater {
+                model: 20
+                Rectangle { width: 10; height: 10 }
+            }
+        }
+    }
+}
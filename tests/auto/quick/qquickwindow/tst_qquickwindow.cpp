@@ -556,6 +556,7 @@ private slots:
 
     void screenReusesQQuickScreenInfoInstance();
     void screenInfoInstanceIsDestroyedAfterAScreenChange();
+    void incubationStatistics();
 
 private:
     QPointingDevice *touchDevice; // TODO make const after fixing QTBUG-107864
@@ -4228,6 +4229,34 @@ void tst_qquickwindow::screenInfoInstanceIsDestroyedAfterAScreenChange()
     QCOMPARE(window->findChild<QQuickScreenInfo*>(), nullptr);
 }
 
+void tst_qquickwindow::incubationStatistics()
+{
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.loadUrl(testFileUrl("incubationStatistics.qml"));
+    QScopedPointer<QObject> created(component.create());
+    QVERIFY(created);
+
+    QQuickWindow *window = qobject_cast<QQuickWindow *>(created.data());
+    QVERIFY(window);
+    QQuickWindowPrivate *wd = QQuickWindowPrivate::get(window);
+    QCOMPARE(wd->incubationStatistics().frames, 0);
+
+    engine.setIncubationController(window->incubationController());
+    window->show();
+    QVERIFY(QTest::qWaitForWindowExposed(window));
+
+    QQuickLoader *loader = window->findChild<QQuickLoader *>("loader");
+    QVERIFY(loader);
+    QTRY_COMPARE(loader->status(), QQuickLoader::Ready);
+
+    const QQuickWindowIncubationStatistics stats = wd->incubationStatistics();
+    QVERIFY(stats.frames > 0);
+    QVERIFY(stats.totalObjects > 0);
+    QVERIFY(stats.maxFrameObjects >= stats.lastFrameObjects);
+    QVERIFY(stats.lastFrameBudget >= 1);
+}
+
 QTEST_MAIN(tst_qquickwindow)
 
 #include "tst_qquickwindow.moc"
@@ -0,0 +1,147 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtTest/QtTest>
+
+#include <QtCore/qdir.h>
+#include <QtCore/qstandardpaths.h>
+#include <QtCore/qsysinfo.h>
+#include <QtGui/qguiapplication.h>
+#include <QtGui/qrawfont.h>
+#include <QtGui/private/qdistancefield_p.h>
+#include <QtGui/private/qrawfont_p.h>
+#include <QtQuick/private/qsgdistancefieldglyphstore_p.h>
+
+class tst_QSGDistanceFieldGlyphStore : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void preload();
+    void saveAndLoad();
+
+private:
+    QString m_cacheDir;
+};
+
+struct GlyphParameters
+{
+    QRawFont referenceFont;
+    QByteArray key;
+    bool doubleGlyphResolution;
+};
+
+// The same parameters as the QSGDistanceFieldGlyphCache for the font uses.
+static GlyphParameters glyphParameters(const QRawFont &font, int renderTypeQuality)
+{
+    const int glyphCount = QRawFontPrivate::get(font)->fontEngine->glyphCount();
+    GlyphParameters parameters;
+    parameters.doubleGlyphResolution = qt_fontHasNarrowOutlines(font)
+            && glyphCount < QT_DISTANCEFIELD_HIGHGLYPHCOUNT();
+    const int baseFontSize = renderTypeQuality > 0
+            ? renderTypeQuality : QT_DISTANCEFIELD_BASEFONTSIZE(parameters.doubleGlyphResolution);
+    parameters.referenceFont = font;
+    parameters.referenceFont.setPixelSize(baseFontSize
+                                          * QT_DISTANCEFIELD_SCALE(parameters.doubleGlyphResolution));
+    parameters.key = QSGDistanceFieldGlyphStore::fontKey(font, baseFontSize,
+                                                         parameters.doubleGlyphResolution);
+    return parameters;
+}
+
+static QByteArrayView fieldData(const QDistanceField &field)
+{
+    return QByteArrayView(field.constBits(), field.width() * field.height());
+}
+
+void tst_QSGDistanceFieldGlyphStore::initTestCase()
+{
+    // Both are only checked once per process, before the store is used first.
+    QStandardPaths::setTestModeEnabled(true);
+    qputenv("QSG_DISTANCEFIELD_DISK_CACHE", "1");
+    qunsetenv("QSG_RHI_DISABLE_DISK_CACHE");
+    QVERIFY(QSGDistanceFieldGlyphStore::isDiskCacheEnabled());
+
+    m_cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+            + QLatin1String("/qtdistancefieldcache-") + QSysInfo::buildAbi();
+    QDir(m_cacheDir).removeRecursively();
+}
+
+void tst_QSGDistanceFieldGlyphStore::cleanupTestCase()
+{
+    QDir(m_cacheDir).removeRecursively();
+}
+
+void tst_QSGDistanceFieldGlyphStore::preload()
+{
+    const QRawFont font = QRawFont::fromFont(QGuiApplication::font());
+    QVERIFY(font.isValid());
+    if (!font.fontTable("qtdf").isEmpty())
+        QSKIP("The font has pregenerated distance fields");
+
+    const QList<quint32> glyphs = font.glyphIndexesForString(QStringLiteral("Preload"));
+    QVERIFY(!glyphs.isEmpty());
+    const GlyphParameters parameters = glyphParameters(font, 0);
+
+    QSGDistanceFieldGlyphStore *store = QSGDistanceFieldGlyphStore::instance();
+    store->preload(font, glyphs, 0);
+    QVERIFY(QSGDistanceFieldGlyphStore::isActive());
+    store->waitForPreloads();
+
+    int checkedGlyphs = 0;
+    for (quint32 glyph : glyphs) {
+        const QDistanceField expected = QSGDistanceFieldGlyphStore::generate(
+                parameters.referenceFont, glyph, parameters.doubleGlyphResolution);
+        if (expected.isNull())
+            continue;
+
+        const QSize size(expected.width(), expected.height());
+        const QDistanceField field = store->glyph(parameters.key, glyph, size);
+        QVERIFY(!field.isNull());
+        QCOMPARE(field.glyph(), glyph);
+        QCOMPARE(fieldData(field), fieldData(expected));
+
+        // a glyph cache laying out the glyph differently generates its own
+        QVERIFY(store->glyph(parameters.key, glyph, size + QSize(1, 1)).isNull());
+        ++checkedGlyphs;
+    }
+    QVERIFY(checkedGlyphs > 0);
+}
+
+void tst_QSGDistanceFieldGlyphStore::saveAndLoad()
+{
+    const QRawFont font = QRawFont::fromFont(QGuiApplication::font());
+    QVERIFY(font.isValid());
+
+    // a quality no other test uses, so that the key is not in the cache yet
+    const GlyphParameters parameters = glyphParameters(font, 123);
+    const quint32 glyph = font.glyphIndexesForString(QStringLiteral("Q")).value(0);
+    const QDistanceField field = QSGDistanceFieldGlyphStore::generate(
+            parameters.referenceFont, glyph, parameters.doubleGlyphResolution);
+    QVERIFY(!field.isNull());
+    const QSize size(field.width(), field.height());
+
+    const QString fileName = m_cacheDir + QLatin1Char('/') + QString::fromLatin1(parameters.key)
+            + QLatin1String(".qsgdf");
+    QVERIFY(!QFileInfo::exists(fileName));
+    {
+        QSGDistanceFieldGlyphStore store;
+        store.insert(parameters.key, field);
+        store.save(parameters.key);
+    }
+    QVERIFY(QFileInfo::exists(fileName));
+
+    // a new store, like in the next run of the application, reads the file
+    QSGDistanceFieldGlyphStore store;
+    const QDistanceField loaded = store.glyph(parameters.key, glyph, size);
+    QVERIFY(!loaded.isNull());
+    QCOMPARE(loaded.glyph(), glyph);
+    QCOMPARE(fieldData(loaded), fieldData(field));
+    QVERIFY(store.glyph(parameters.key, glyph + 1, size).isNull());
+}
+
+QTEST_MAIN(tst_QSGDistanceFieldGlyphStore)
+
+#include "tst_qsgdistancefieldglyphstore.moc"
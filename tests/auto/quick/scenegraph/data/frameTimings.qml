@@ -0,0 +1,43 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtQuick
+
+Rectangle {
+    id: root
+    width: 200
+    height: 200
+    color: "steelblue"
+
+    FrameTimings.enabled: true
+    FrameTimings.capacity: 16
+
+    property int recordedFrames: 0
+    property bool phasesValid: true
+
+    Rectangle {
+        width: 100
+        height: 100
+        anchors.centerIn: parent
+        color: "red"
+        NumberAnimation on rotation { from: 0; to: 360; duration: 1000; loops: Animation.Infinite }
+    }
+
+    Timer {
+        interval: 50
+        running: true
+        repeat: true
+        onTriggered: {
+            const frames = root.FrameTimings.frames()
+            const phases = [ "animations", "polish", "syncWait", "garbageCollection", "sync",
+                             "renderPrepare", "renderRecord", "present" ]
+            for (const frame of frames) {
+                for (const phase of phases) {
+                    if (!(frame[phase] >= 0))
+                        root.phasesValid = false
+                }
+            }
+            root.recordedFrames = frames.length
+        }
+    }
+}
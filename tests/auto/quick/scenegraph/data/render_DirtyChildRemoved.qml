@@ -0,0 +1,56 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+import QtQuick
+
+/*
+    The renderer keeps a list of the changed children of each node, so that
+    it only visits those. Change some rectangles and, in the same frame,
+    move one of the changed ones to another parent, remove another one and
+    add a new one.
+
+    A changed node that is removed from its parent must also be removed from
+    the list of changed children of that parent, otherwise the renderer
+    visits a node that is not in the tree anymore, and the remaining changes
+    are lost.
+
+    #samples: 10
+                 PixelPos     R         G          B           Error-tolerance
+    #base:        25   25    1.0       0.0        0.0           0.05
+    #base:        25   75    0.0       1.0        0.0           0.05
+    #base:        25  125    0.0       0.0        1.0           0.05
+    #base:        25  175    1.0       1.0        1.0           0.05
+    #base:       125   25    1.0       1.0        1.0           0.05
+    #final:       25   25    1.0       1.0        1.0           0.05
+    #final:       25   75    1.0       0.0        0.0           0.05
+    #final:       25  125    1.0       1.0        1.0           0.05
+    #final:       25  175    0.0       1.0        0.0           0.05
+    #final:      125   25    0.0       0.0        1.0           0.05
+*/
+
+RenderTestBase {
+    id: root
+
+    Item {
+        id: left
+        width: 100; height: 200
+        Rectangle { id: a; x: 10; y: 10; width: 30; height: 30; color: "#ff0000" }
+        Rectangle { id: b; x: 10; y: 60; width: 30; height: 30; color: "#00ff00" }
+        Rectangle { id: c; x: 10; y: 110; width: 30; height: 30; color: "#0000ff" }
+    }
+
+    Item {
+        id: right
+        x: 100; width: 100; height: 200
+    }
+
+    onEnterFinalStage: {
+        a.color = "#0000ff";
+        a.parent = right;
+        b.color = "#ff0000";
+        c.color = "#00ff00";
+        c.parent = null;
+        Qt.createQmlObject('import QtQuick; Rectangle { x: 10; y: 160; width: 30; height: 30; color: "#00ff00" }', left);
+        finalStageComplete = true;
+    }
+}
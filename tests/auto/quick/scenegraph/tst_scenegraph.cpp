@@ -9,6 +9,8 @@
 #include <QOpenGLFunctions>
 #endif
 
+#include <QSignalSpy>
+
 #include <QtQuick>
 #include <QtQml>
 
@@ -16,10 +18,17 @@
 #include <private/qopenglcontext_p.h>
 #endif
 
+#include <private/qquickwindow_p.h>
+#include <private/qsgbatchrenderer_p.h>
 #include <private/qsgcontext_p.h>
 #include <private/qsgrenderloop_p.h>
 #include <private/qsgrhisupport_p.h>
 #include <private/qsgplaintexture_p.h>
+#include <private/qsgframetimings_p.h>
+#include <private/qquickframetimings_p.h>
+#if QT_CONFIG(thread)
+#include <private/qsgworkerpool_p.h>
+#endif
 
 #include <QtQuickTestUtils/private/qmlutils_p.h>
 #include <QtQuickTestUtils/private/visualtestutils_p.h>
@@ -89,14 +98,24 @@ private slots:
 
     void render_data();
     void render();
+    void renderWithConcurrentUpload_data();
+    void renderWithConcurrentUpload();
 #if QT_CONFIG(opengl)
     void hideWithOtherContext();
 #endif
     void createTextureFromImage_data();
     void createTextureFromImage();
     void withAdoptedRhi();
+    void pipelineDescriptions();
+    void transformedElementUpload();
     void resizeTextureFromImage();
     void textureNativeInterface();
+    void frameTimings();
+    void frameTimingsAttached();
+    void frameTimingsRecording();
+#if QT_CONFIG(thread)
+    void workerPool();
+#endif
 
 private:
     QQuickView *createView(const QString &file, QWindow *parent = nullptr, int x = -1, int y = -1, int w = -1, int h = -1);
@@ -366,7 +385,8 @@ void tst_SceneGraph::render_data()
           << "render_bug37422.qml"
           << "render_OpacityThroughBatchRoot.qml"
           << "render_Mipmap.qml"
-          << "render_AlphaOverlapRebuild.qml";
+          << "render_AlphaOverlapRebuild.qml"
+          << "render_DirtyChildRemoved.qml";
 
     QRegularExpression sampleCount("#samples: *(\\d+)");
     //                          X:int   Y:int   R:float       G:float       B:float       Error:float
@@ -459,6 +479,25 @@ void tst_SceneGraph::render()
     }
 }
 
+void tst_SceneGraph::renderWithConcurrentUpload_data()
+{
+    render_data();
+}
+
+void tst_SceneGraph::renderWithConcurrentUpload()
+{
+    // The renderer reads these when it is created, with the first frame of the view.
+    // Uploading concurrently even the smallest scenes makes the render tests cover it.
+    qputenv("QSG_RENDERER_UPLOAD_THREADS", "4");
+    qputenv("QSG_RENDERER_UPLOAD_PARALLEL_THRESHOLD", "0");
+    auto cleanup = qScopeGuard([] {
+        qunsetenv("QSG_RENDERER_UPLOAD_THREADS");
+        qunsetenv("QSG_RENDERER_UPLOAD_PARALLEL_THRESHOLD");
+    });
+
+    render();
+}
+
 #if QT_CONFIG(opengl)
 // Testcase for QTBUG-34898. We make another context current on another surface
 // in the GUI thread and hide the QQuickWindow while the other context is
@@ -734,6 +773,184 @@ void tst_SceneGraph::withAdoptedRhi()
     TestOffscreenScene::cleanup();
 }
 
+// Renders renderControl_rect.qml once with \a config and returns the pipeline
+// descriptions recorded for its QRhi: after initialization, and after the frame.
+static bool renderWithPipelineCache(const QUrl &url, const QQuickGraphicsConfiguration &config,
+                                    QList<QByteArray> *beforeFrame, QList<QByteArray> *afterFrame)
+{
+    QQuickRenderControl renderControl;
+    QQuickWindow window(&renderControl);
+    window.setGraphicsConfiguration(config);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine, url);
+    QScopedPointer<QQuickItem> rootItem(qobject_cast<QQuickItem *>(component.create()));
+    if (!rootItem)
+        return false;
+    window.contentItem()->setSize(rootItem->size());
+    window.setGeometry(0, 0, rootItem->width(), rootItem->height());
+    rootItem->setParentItem(window.contentItem());
+
+    if (!renderControl.initialize())
+        return false;
+
+    QRhi *rhi = static_cast<QRhi *>(window.rendererInterface()->getResource(&window, QSGRendererInterface::RhiResource));
+    if (!rhi)
+        return false;
+    *beforeFrame = QSGRhiSupport::instance()->pipelineDescriptions(rhi);
+
+    // destroyed before the QRhi
+    QScopedPointer<QRhiTexture> tex(rhi->newTexture(QRhiTexture::RGBA8, rootItem->size().toSize(), 1,
+                                                    QRhiTexture::RenderTarget));
+    if (!tex->create())
+        return false;
+    QScopedPointer<QRhiTextureRenderTarget> texRt(rhi->newTextureRenderTarget(QRhiColorAttachment(tex.data())));
+    QScopedPointer<QRhiRenderPassDescriptor> rp(texRt->newCompatibleRenderPassDescriptor());
+    texRt->setRenderPassDescriptor(rp.data());
+    if (!texRt->create())
+        return false;
+    window.setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(texRt.data()));
+
+    renderControl.polishItems();
+    renderControl.beginFrame();
+    renderControl.sync();
+    renderControl.render();
+    renderControl.endFrame();
+
+    *afterFrame = QSGRhiSupport::instance()->pipelineDescriptions(rhi);
+    window.setRenderTarget(QQuickRenderTarget());
+    return true;
+}
+
+void tst_SceneGraph::pipelineDescriptions()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping test due to not running with QRhi");
+
+    // The Null backend creates pipelines without a GPU
+    const QSGRendererInterface::GraphicsApi api = QQuickWindow::graphicsApi();
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Null);
+    auto restoreApi = qScopeGuard([api] { QQuickWindow::setGraphicsApi(api); });
+
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    const QString cacheFile = cacheDir.filePath(QLatin1String("pipelines"));
+    const QUrl url = testFileUrl(QLatin1String("renderControl_rect.qml"));
+
+    QList<QByteArray> beforeFrame;
+    QList<QByteArray> recorded;
+    {
+        QQuickGraphicsConfiguration config;
+        config.setAutomaticPipelineCache(false);
+        config.setPipelineCacheSaveFile(cacheFile);
+        QVERIFY(renderWithPipelineCache(url, config, &beforeFrame, &recorded));
+    }
+    QVERIFY(beforeFrame.isEmpty());
+    QVERIFY(!recorded.isEmpty());
+    // written when the QRhi is destroyed
+    QVERIFY(QFileInfo(cacheFile + QLatin1String(".qsgpipelines")).size() > 0);
+
+    QList<QByteArray> loaded;
+    QList<QByteArray> afterFrame;
+    {
+        QQuickGraphicsConfiguration config;
+        config.setAutomaticPipelineCache(false);
+        config.setPipelineCacheLoadFile(cacheFile);
+        QVERIFY(renderWithPipelineCache(url, config, &loaded, &afterFrame));
+    }
+    std::sort(recorded.begin(), recorded.end());
+    std::sort(loaded.begin(), loaded.end());
+    std::sort(afterFrame.begin(), afterFrame.end());
+    QCOMPARE(loaded, recorded);
+    // the same scene needs the same pipelines
+    QCOMPARE(afterFrame, recorded);
+}
+
+class OpaqueRect : public QQuickItem
+{
+public:
+    OpaqueRect() { setFlag(ItemHasContents); }
+
+    QSGNode *updatePaintNode(QSGNode *node, UpdatePaintNodeData *) override
+    {
+        if (!node)
+            node = new QSGSimpleRectNode(boundingRect(), Qt::red);
+        return node;
+    }
+};
+
+void tst_SceneGraph::transformedElementUpload()
+{
+    if (!isRunningOnRhi())
+        QSKIP("Skipping test due to not running with QRhi");
+
+    const QSGRendererInterface::GraphicsApi api = QQuickWindow::graphicsApi();
+    QQuickWindow::setGraphicsApi(QSGRendererInterface::Null);
+    auto restoreApi = qScopeGuard([api] { QQuickWindow::setGraphicsApi(api); });
+
+    QQuickRenderControl renderControl;
+    QQuickWindow window(&renderControl);
+    window.setGeometry(0, 0, 200, 200);
+    window.contentItem()->setSize(QSizeF(200, 200));
+
+    // opaque elements with the same material end up in one merged batch
+    const int rectCount = 100;
+    ScopedList<OpaqueRect *> rects;
+    for (int i = 0; i < rectCount; ++i) {
+        OpaqueRect *rect = new OpaqueRect;
+        rect->setSize(QSizeF(10, 10));
+        rect->setPosition(QPointF((i % 10) * 20, (i / 10) * 20));
+        rect->setParentItem(window.contentItem());
+        rects.append(rect);
+    }
+
+    QVERIFY(renderControl.initialize());
+    QRhi *rhi = static_cast<QRhi *>(window.rendererInterface()->getResource(&window, QSGRendererInterface::RhiResource));
+    QVERIFY(rhi);
+    QScopedPointer<QRhiTexture> tex(rhi->newTexture(QRhiTexture::RGBA8, QSize(200, 200), 1,
+                                                    QRhiTexture::RenderTarget));
+    QVERIFY(tex->create());
+    QScopedPointer<QRhiTextureRenderTarget> texRt(rhi->newTextureRenderTarget(QRhiColorAttachment(tex.data())));
+    QScopedPointer<QRhiRenderPassDescriptor> rp(texRt->newCompatibleRenderPassDescriptor());
+    texRt->setRenderPassDescriptor(rp.data());
+    QVERIFY(texRt->create());
+    window.setRenderTarget(QQuickRenderTarget::fromRhiRenderTarget(texRt.data()));
+    auto resetRenderTarget = qScopeGuard([&window] { window.setRenderTarget(QQuickRenderTarget()); });
+
+    const auto renderFrame = [&] {
+        renderControl.polishItems();
+        renderControl.beginFrame();
+        renderControl.sync();
+        renderControl.render();
+        renderControl.endFrame();
+    };
+
+    renderFrame();
+    auto *renderer = dynamic_cast<QSGBatchRenderer::Renderer *>(QQuickWindowPrivate::get(&window)->renderer);
+    if (!renderer)
+        QSKIP("Skipping test due to not using the batch renderer");
+    const quint64 fullUpload = renderer->uploadedVertexBytes();
+    QVERIFY(fullUpload > 0);
+
+    renderFrame();
+    QCOMPARE(renderer->uploadedVertexBytes(), fullUpload);
+
+    // The vertices of all elements are part of the full upload, so moving a single element
+    // uploads at most a hundredth of it. Once the static buffer changed too often, it is
+    // replaced by a dynamic one with a single full upload.
+    int fullUploads = 0;
+    for (int i = 0; i < 10; ++i) {
+        const quint64 before = renderer->uploadedVertexBytes();
+        rects.at(42)->setX(rects.at(42)->x() + 1);
+        renderFrame();
+        const quint64 uploaded = renderer->uploadedVertexBytes() - before;
+        QVERIFY(uploaded > 0);
+        if (uploaded > fullUpload / rectCount)
+            ++fullUploads;
+    }
+    QCOMPARE(fullUploads, 1);
+}
+
 static inline void commitTexture(QRhi *rhi, QSGTexture *texture)
 {
     QRhiResourceUpdateBatch *rub = rhi->nextResourceUpdateBatch();
@@ -856,6 +1073,161 @@ bool tst_SceneGraph::isRunningOnRhi()
     return retval;
 }
 
+void tst_SceneGraph::frameTimings()
+{
+    QSGFrameTimings timings;
+    QVERIFY(!timings.isEnabled());
+    QCOMPARE(timings.capacity(), QSGFrameTimings::DefaultCapacity);
+    QCOMPARE(timings.percentile(QSGFrameTimings::Sync, 50), qint64(0));
+
+    timings.setCapacity(4);
+    for (int i = 1; i <= 6; ++i) {
+        QSGFrameTimings::Frame frame;
+        frame.phases[QSGFrameTimings::Polish] = i;
+        frame.phases[QSGFrameTimings::Sync] = 10 * i;
+        timings.addFrame(frame);
+    }
+
+    // only the four most recent frames are kept, oldest first
+    QList<QSGFrameTimings::Frame> frames = timings.frames();
+    QCOMPARE(frames.size(), 4);
+    for (int i = 0; i < 4; ++i) {
+        QCOMPARE(frames[i].frameNumber, qint64(i + 2));
+        QCOMPARE(frames[i].phases[QSGFrameTimings::Polish], qint64(i + 3));
+    }
+    QCOMPARE(frames.last().guiThreadTime(), qint64(6));
+    QCOMPARE(frames.last().renderThreadTime(), qint64(60));
+
+    QCOMPARE(timings.percentile(QSGFrameTimings::Sync, 0), qint64(30));
+    QCOMPARE(timings.percentile(QSGFrameTimings::Sync, 50), qint64(40));
+    QCOMPARE(timings.percentile(QSGFrameTimings::Sync, 100), qint64(60));
+
+    // shrinking keeps the most recent frames
+    timings.setCapacity(2);
+    frames = timings.frames();
+    QCOMPARE(frames.size(), 2);
+    QCOMPARE(frames[0].phases[QSGFrameTimings::Polish], qint64(5));
+    QCOMPARE(frames[1].phases[QSGFrameTimings::Polish], qint64(6));
+
+    timings.clear();
+    QVERIFY(timings.frames().isEmpty());
+}
+
+static QQuickFrameTimings *frameTimingsOf(QQuickItem *item)
+{
+    return qobject_cast<QQuickFrameTimings *>(qmlAttachedPropertiesObject<QQuickFrameTimings>(item));
+}
+
+void tst_SceneGraph::frameTimingsAttached()
+{
+    QQuickWindow window;
+    QQuickItem first(window.contentItem());
+    QQuickItem second(window.contentItem());
+    QQuickItem later;
+
+    QQuickFrameTimings *firstTimings = frameTimingsOf(&first);
+    QQuickFrameTimings *secondTimings = frameTimingsOf(&second);
+    QQuickFrameTimings *laterTimings = frameTimingsOf(&later);
+    QVERIFY(firstTimings && secondTimings && laterTimings);
+    QVERIFY(!secondTimings->isEnabled());
+    QCOMPARE(secondTimings->capacity(), int(QSGFrameTimings::DefaultCapacity));
+
+    // the settings are shared by all items in the window
+    QSignalSpy enabledSpy(secondTimings, &QQuickFrameTimings::enabledChanged);
+    QSignalSpy capacitySpy(secondTimings, &QQuickFrameTimings::capacityChanged);
+    firstTimings->setEnabled(true);
+    QVERIFY(secondTimings->isEnabled());
+    QCOMPARE(enabledSpy.size(), 1);
+    QVERIFY(QQuickWindowPrivate::get(&window)->frameTimings.isEnabled());
+    firstTimings->setCapacity(16);
+    QCOMPARE(secondTimings->capacity(), 16);
+    QCOMPARE(capacitySpy.size(), 1);
+
+    // including items that are added to the window later
+    QSignalSpy laterEnabledSpy(laterTimings, &QQuickFrameTimings::enabledChanged);
+    QVERIFY(!laterTimings->isEnabled());
+    later.setParentItem(window.contentItem());
+    QVERIFY(laterTimings->isEnabled());
+    QCOMPARE(laterTimings->capacity(), 16);
+    QCOMPARE(laterEnabledSpy.size(), 1);
+
+    secondTimings->setEnabled(false);
+    QVERIFY(!firstTimings->isEnabled());
+    QVERIFY(!laterTimings->isEnabled());
+    QCOMPARE(enabledSpy.size(), 2);
+    QCOMPARE(laterEnabledSpy.size(), 2);
+
+    // nothing renders the window, so nothing is recorded
+    QVERIFY(firstTimings->frames().isEmpty());
+    QCOMPARE(firstTimings->percentile(QQuickFrameTimings::Sync, 50), qreal(0));
+}
+
+void tst_SceneGraph::frameTimingsRecording()
+{
+    if (!QSGRenderLoop::instance()->inherits("QSGThreadedRenderLoop"))
+        QSKIP("Frame timings are only recorded by the threaded render loop");
+
+    QQuickView view;
+    view.setSource(testFileUrl("frameTimings.qml"));
+    QQuickItem *root = view.rootObject();
+    QVERIFY(root);
+    QQuickFrameTimings *timings = frameTimingsOf(root);
+    QVERIFY(timings);
+    QVERIFY(timings->isEnabled());
+    QCOMPARE(timings->capacity(), 16);
+
+    view.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&view));
+
+    // the QML side checks every phase of every frame it sees
+    QTRY_VERIFY(root->property("recordedFrames").toInt() > 0);
+    QVERIFY(root->property("phasesValid").toBool());
+
+    const QVariantList frames = timings->frames();
+    QVERIFY(!frames.isEmpty());
+    QVERIFY(frames.size() <= 16);
+    const qreal median = timings->percentile(QQuickFrameTimings::RenderRecord, 50);
+    QVERIFY(median >= 0);
+    QVERIFY(timings->percentile(QQuickFrameTimings::RenderRecord, 100) >= median);
+}
+
+#if QT_CONFIG(thread)
+void tst_SceneGraph::workerPool()
+{
+    // every index is handed out exactly once
+    std::vector<std::atomic<int>> calls(1000);
+    QMutex mutex;
+    QSet<QThread *> threads;
+    QSGWorkerPool::run(qsizetype(calls.size()), 4, [&](qsizetype i) {
+        ++calls[i];
+        QMutexLocker locker(&mutex);
+        threads.insert(QThread::currentThread());
+    });
+    for (const std::atomic<int> &count : calls)
+        QCOMPARE(count.load(), 1);
+    QVERIFY(threads.size() <= 4);
+
+    // a single thread means the calling thread, in order
+    QList<qsizetype> indexes;
+    threads.clear();
+    QSGWorkerPool::run(5, 1, [&](qsizetype i) {
+        indexes.append(i);
+        threads.insert(QThread::currentThread());
+    });
+    QCOMPARE(indexes, QList<qsizetype>({ 0, 1, 2, 3, 4 }));
+    QCOMPARE(threads, QSet<QThread *>({ QThread::currentThread() }));
+
+    QSGWorkerPool::run(0, 4, [](qsizetype) { QFAIL("No work to do"); });
+
+    // the shared pool grows when more threads are asked for, e.g. by QSG_DISTANCEFIELD_THREADS
+    const int threadCount = QSGWorkerPool::threadPool()->maxThreadCount() + 4;
+    std::atomic<int> total = 0;
+    QSGWorkerPool::run(threadCount, threadCount, [&](qsizetype) { ++total; });
+    QCOMPARE(total.load(), threadCount);
+    QVERIFY(QSGWorkerPool::threadPool()->maxThreadCount() >= threadCount - 1);
+}
+#endif
+
 #include "tst_scenegraph.moc"
 
 QTEST_MAIN(tst_SceneGraph)
@@ -22,6 +22,10 @@ private slots:
     void initTestCase() override;
 
     void renderTarget();
+    void tiledRendering();
+    void roundedRectOcclusion();
+    void roundedGradientRect();
+    void roundedTranslucentGradientRect();
 };
 
 tst_SoftwareRenderer::tst_SoftwareRenderer()
@@ -89,6 +93,200 @@ void tst_SoftwareRenderer::renderTarget()
              qPrintable(errorMessage));
 }
 
+void tst_SoftwareRenderer::tiledRendering()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+
+    QQuickRenderControl rc;
+    QScopedPointer<QQuickWindow> window(new QQuickWindow(&rc));
+    window->resize(300, 300);
+    window->setColor(Qt::green);
+
+    // The rectangles cross the boundaries of the tiles that are painted in parallel
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(R"(
+        import QtQuick
+        Item {
+            Rectangle { x: 100; y: 100; width: 100; height: 100; color: "red" }
+            Rectangle { x: 150; y: 50; width: 100; height: 100; radius: 10; color: "#800000ff" }
+            Text { x: 10; y: 200; text: "Tiles" }
+        })", QUrl());
+    QScopedPointer<QQuickItem> item(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY2(item, qPrintable(component.errorString()));
+    item->setParentItem(window->contentItem());
+
+    QImage renderTarget(window->size(), QImage::Format_ARGB32_Premultiplied);
+    renderTarget.fill(Qt::transparent);
+    window->setRenderTarget(QQuickRenderTarget::fromPaintDevice(&renderTarget));
+
+    rc.polishItems();
+    rc.sync();
+    rc.render();
+
+    QCOMPARE(renderTarget.pixelColor(5, 5), QColor(Qt::green));
+    QCOMPARE(renderTarget.pixelColor(299, 299), QColor(Qt::green));
+    QCOMPARE(renderTarget.pixelColor(127, 127), QColor(Qt::red));
+    QCOMPARE(renderTarget.pixelColor(128, 128), QColor(Qt::red));
+    QCOMPARE(renderTarget.pixelColor(120, 190), QColor(Qt::red));
+
+    const QColor blended = renderTarget.pixelColor(175, 128);
+    QVERIFY2(qAbs(blended.red() - 127) <= 2 && blended.green() == 0
+                     && qAbs(blended.blue() - 128) <= 2,
+             qPrintable(blended.name()));
+    QCOMPARE(renderTarget.pixelColor(240, 60), renderTarget.pixelColor(240, 140));
+}
+
+void tst_SoftwareRenderer::roundedRectOcclusion()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+
+    QQuickRenderControl rc;
+    QScopedPointer<QQuickWindow> window(new QQuickWindow(&rc));
+    window->resize(100, 100);
+    window->setColor(Qt::green);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(R"(
+        import QtQuick
+        Item {
+            property alias backColor: back.color
+            Rectangle { id: back; width: 100; height: 100; color: "red" }
+            Rectangle { x: 20; y: 20; width: 60; height: 60; radius: 10; color: "white" }
+        })", QUrl());
+    QScopedPointer<QQuickItem> item(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY2(item, qPrintable(component.errorString()));
+    item->setParentItem(window->contentItem());
+
+    QImage renderTarget(window->size(), QImage::Format_ARGB32_Premultiplied);
+    renderTarget.fill(Qt::transparent);
+    window->setRenderTarget(QQuickRenderTarget::fromPaintDevice(&renderTarget));
+
+    rc.polishItems();
+    rc.sync();
+    rc.render();
+    QCOMPARE(renderTarget.pixelColor(50, 50), QColor(Qt::white));
+
+    // Whatever is behind the inside of the rounded rectangle is never visible,
+    // so changing it must not repaint that area
+    renderTarget.setPixelColor(50, 50, Qt::black);
+    item->setProperty("backColor", QColor(Qt::blue));
+
+    rc.polishItems();
+    rc.sync();
+    rc.render();
+    QCOMPARE(renderTarget.pixelColor(5, 5), QColor(Qt::blue));
+    QCOMPARE(renderTarget.pixelColor(20, 20), renderTarget.pixelColor(79, 79));
+    QVERIFY(renderTarget.pixelColor(20, 20) != QColor(Qt::white));
+    QCOMPARE(renderTarget.pixelColor(50, 50), QColor(Qt::black));
+}
+
+void tst_SoftwareRenderer::roundedGradientRect()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+
+    QQuickRenderControl rc;
+    QScopedPointer<QQuickWindow> window(new QQuickWindow(&rc));
+    window->resize(100, 100);
+    window->setColor(Qt::green);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(R"(
+        import QtQuick
+        Item {
+            Rectangle {
+                width: 100; height: 100; radius: 20
+                gradient: Gradient {
+                    GradientStop { position: 0; color: "red" }
+                    GradientStop { position: 1; color: "blue" }
+                }
+            }
+        })", QUrl());
+    QScopedPointer<QQuickItem> item(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY2(item, qPrintable(component.errorString()));
+    item->setParentItem(window->contentItem());
+
+    QImage renderTarget(window->size(), QImage::Format_ARGB32_Premultiplied);
+    renderTarget.fill(Qt::transparent);
+    window->setRenderTarget(QQuickRenderTarget::fromPaintDevice(&renderTarget));
+
+    rc.polishItems();
+    rc.sync();
+    rc.render();
+
+    // Outside of the rounded corners
+    QCOMPARE(renderTarget.pixelColor(0, 0), QColor(Qt::green));
+    QCOMPARE(renderTarget.pixelColor(99, 0), QColor(Qt::green));
+    QCOMPARE(renderTarget.pixelColor(0, 99), QColor(Qt::green));
+    QCOMPARE(renderTarget.pixelColor(99, 99), QColor(Qt::green));
+
+    // Inside of the corners, the gradient continues the one of the center
+    const QColor top = renderTarget.pixelColor(50, 10);
+    QCOMPARE(renderTarget.pixelColor(10, 10), top);
+    QCOMPARE(renderTarget.pixelColor(89, 10), top);
+    QVERIFY(top.red() > top.blue());
+    const QColor bottom = renderTarget.pixelColor(50, 89);
+    QCOMPARE(renderTarget.pixelColor(10, 89), bottom);
+    QVERIFY(bottom.blue() > bottom.red());
+}
+
+void tst_SoftwareRenderer::roundedTranslucentGradientRect()
+{
+    if (QQuickWindow::sceneGraphBackend() != "software")
+        QSKIP("Skipping complex rendering tests due to not running with software");
+
+    QQuickRenderControl rc;
+    QScopedPointer<QQuickWindow> window(new QQuickWindow(&rc));
+    window->resize(100, 100);
+    window->setColor(Qt::green);
+
+    QQmlEngine engine;
+    QQmlComponent component(&engine);
+    component.setData(R"(
+        import QtQuick
+        Item {
+            Rectangle {
+                x: 10; y: 10; width: 80; height: 80; radius: 20
+                gradient: Gradient {
+                    GradientStop { position: 0; color: "#80ff0000" }
+                    GradientStop { position: 1; color: "#80ff0000" }
+                }
+            }
+        })", QUrl());
+    QScopedPointer<QQuickItem> item(qobject_cast<QQuickItem *>(component.create()));
+    QVERIFY2(item, qPrintable(component.errorString()));
+    item->setParentItem(window->contentItem());
+
+    QImage renderTarget(window->size(), QImage::Format_ARGB32_Premultiplied);
+    renderTarget.fill(Qt::transparent);
+    window->setRenderTarget(QQuickRenderTarget::fromPaintDevice(&renderTarget));
+
+    rc.polishItems();
+    rc.sync();
+    rc.render();
+
+    QCOMPARE(renderTarget.pixelColor(5, 5), QColor(Qt::green));
+    QCOMPARE(renderTarget.pixelColor(11, 11), QColor(Qt::green));
+
+    // No pixel is blended twice where the corners meet the rest of the rectangle
+    const QColor center = renderTarget.pixelColor(50, 50);
+    QVERIFY(center != QColor(Qt::green));
+    for (int y : { 28, 29, 30, 31, 68, 69, 70, 71 }) {
+        QCOMPARE(renderTarget.pixelColor(12, y), center);
+        QCOMPARE(renderTarget.pixelColor(30, y), center);
+        QCOMPARE(renderTarget.pixelColor(87, y), center);
+    }
+    for (int x : { 28, 29, 30, 31, 68, 69, 70, 71 }) {
+        QCOMPARE(renderTarget.pixelColor(x, 12), center);
+        QCOMPARE(renderTarget.pixelColor(x, 87), center);
+    }
+}
+
 #include "tst_softwarerenderer.moc"
 
 QTEST_MAIN(tst_SoftwareRenderer)
@@ -47,22 +47,55 @@ int main(int argc, char **argv)
     QCommandLineParser parser;
     parser.addHelpOption();
     parser.setApplicationDescription("Internal development tool.");
-    parser.addPositionalArgument("mode", "Choose whether to aggregate or display aotstats files",
-                                 "[aggregate|format]");
+    parser.addPositionalArgument("mode", "Choose whether to aggregate, display or compare "
+                                         "aotstats files",
+                                 "[aggregate|format|diff]");
     parser.addPositionalArgument("input", "Aggregate mode: the aotstatslist file to aggregate. "
-                                          "Format mode: the aotstats file to display.");
+                                          "Format mode: the aotstats file to display. "
+                                          "Diff mode: the baseline aotstats file, followed by "
+                                          "the aotstats file to compare against it.");
     parser.addPositionalArgument("output", "Aggregate mode: the path where to store the "
                                            "aggregated aotstats. Format mode: the the path where "
-                                           "the formatted output will be saved.");
+                                           "the formatted output will be saved. Diff mode: the "
+                                           "path where the JSON report will be saved.");
+
+    QCommandLineOption runtimeCountsOption(
+            u"runtime-counts"_s,
+            u"Format mode: annotate failed compilations with the call counts recorded by "
+            "running the application with QML_AOT_FALLBACK_STATS=<file>."_s,
+            u"file"_s);
+    parser.addOption(runtimeCountsOption);
+
+    QCommandLineOption timeThresholdOption(
+            u"time-threshold"_s,
+            u"Diff mode: report successful compilations that got slower by more than the "
+            "given percentage. The default is 50."_s,
+            u"percent"_s, u"50"_s);
+    parser.addOption(timeThresholdOption);
+
+    QCommandLineOption minimumTimeDeltaOption(
+            u"min-time-delta"_s,
+            u"Diff mode: ignore slowdowns of less than the given number of microseconds. "
+            "The default is 1000."_s,
+            u"microseconds"_s, u"1000"_s);
+    parser.addOption(minimumTimeDeltaOption);
+
+    QCommandLineOption failOnSlowdownsOption(
+            u"fail-on-slowdowns"_s,
+            u"Diff mode: also fail if compilations got slower. Compile times are noisy, so by "
+            "default only functions that are no longer compiled to Cpp make the diff fail."_s);
+    parser.addOption(failOnSlowdownsOption);
+
     parser.process(app);
 
     const auto &positionalArgs = parser.positionalArguments();
-    if (positionalArgs.size() != 3) {
+    const auto &mode = positionalArgs.value(0);
+    const qsizetype expectedArgs = (mode == u"diff"_s) ? 4 : 3;
+    if (positionalArgs.size() != expectedArgs) {
         qDebug().noquote() << parser.helpText();
         return EXIT_FAILURE;
     }
 
-    const auto &mode = positionalArgs.first();
     if (mode == u"aggregate"_s) {
         const auto aggregated = QQmlJS::AotStats::aggregateAotstatsList(positionalArgs[1]);
         if (!aggregated.has_value())
@@ -71,12 +104,55 @@ int main(int argc, char **argv)
             return EXIT_FAILURE;
 
     } else if (mode == u"format"_s) {
-        const auto aotstats = QQmlJS::AotStats::parseAotstatsFile(positionalArgs[1]);
+        auto aotstats = QQmlJS::AotStats::parseAotstatsFile(positionalArgs[1]);
         if (!aotstats.has_value())
             return EXIT_FAILURE;
+        if (parser.isSet(runtimeCountsOption)
+            && !aotstats->applyRuntimeCounts(parser.value(runtimeCountsOption))) {
+            return EXIT_FAILURE;
+        }
         const QQmlJS::AotStatsReporter reporter(aotstats.value());
         if (!saveFormattedStats(reporter.format(), positionalArgs[2]))
             return EXIT_FAILURE;
+
+    } else if (mode == u"diff"_s) {
+        bool ok = false;
+        const double threshold = parser.value(timeThresholdOption).toDouble(&ok);
+        if (!ok || threshold < 0) {
+            qDebug() << "Invalid time threshold" << parser.value(timeThresholdOption);
+            return EXIT_FAILURE;
+        }
+        const qint64 minimumDelta = parser.value(minimumTimeDeltaOption).toLongLong(&ok);
+        if (!ok || minimumDelta < 0) {
+            qDebug() << "Invalid minimum time delta" << parser.value(minimumTimeDeltaOption);
+            return EXIT_FAILURE;
+        }
+
+        const auto before = QQmlJS::AotStats::parseAotstatsFile(positionalArgs[1]);
+        const auto after = QQmlJS::AotStats::parseAotstatsFile(positionalArgs[2]);
+        if (!before.has_value() || !after.has_value())
+            return EXIT_FAILURE;
+
+        const QQmlJS::AotStatsDiff diff = QQmlJS::AotStats::diff(
+                before.value(), after.value(), threshold,
+                std::chrono::microseconds(minimumDelta));
+        if (!saveFormattedStats(QString::fromUtf8(diff.toJsonDocument().toJson()),
+                                positionalArgs[3])) {
+            return EXIT_FAILURE;
+        }
+
+        // Fail the build step on regressions so that CI can catch them.
+        const bool failOnSlowdowns = parser.isSet(failOnSlowdownsOption);
+        if (diff.hasRegressions() || (failOnSlowdowns && diff.hasSlowdowns())) {
+            qDebug().noquote() << u"%1 bindings or functions are no longer compiled to Cpp, "
+                                  "%2 got slower to compile"_s.arg(diff.regressions.size())
+                                          .arg(diff.slowdowns.size());
+            return EXIT_FAILURE;
+        }
+
+    } else {
+        qDebug().noquote() << parser.helpText();
+        return EXIT_FAILURE;
     }
 
     return EXIT_SUCCESS;
@@ -13,6 +13,8 @@
 #include <QScopeGuard>
 #include <QLibraryInfo>
 #include <QLoggingCategory>
+#include <QThread>
+#include <QThreadPool>
 
 #include <private/qqmlirbuilder_p.h>
 #include <private/qqmljscompiler_p.h>
@@ -24,6 +26,8 @@
 #include <private/qresourcerelocater_p.h>
 
 #include <algorithm>
+#include <atomic>
+#include <memory>
 
 using namespace Qt::Literals::StringLiterals;
 
@@ -56,6 +60,204 @@ static bool argumentsFromCommandLineAndFile(QStringList& allArguments, const QSt
     return true;
 }
 
+namespace {
+struct CompileOptions
+{
+    QStringList importPaths;
+    QStringList qmldirFiles;
+    QQmlJSResourceFileMapper *fileMapper = nullptr;
+    QString moduleId; // only set if AOT statistics are to be recorded
+    bool useResourceMapper = false;
+    bool onlyBytecode = false;
+    bool verbose = false;
+    bool warningsAreErrors = false;
+    bool validateBasicBlocks = false;
+};
+
+struct BatchJob
+{
+    QString inputFile;
+    QString outputFileName;
+    QString resourcePath;
+};
+}
+
+// The importer is created on first use and kept around, so that a caller
+// compiling several files can reuse all the types imported so far.
+static int compileFile(
+        const QString &inputFile, const QString &outputFileName, QString inputResourcePath,
+        const CompileOptions &options, std::unique_ptr<QQmlJSImporter> &importer)
+{
+    const bool generateCpp = outputFileName.endsWith(".cpp"_L1);
+    QString inputFileUrl = inputFile;
+
+    QQmlJSSaveFunction saveFunction;
+
+    // If the user didn't specify the resource path corresponding to the file on disk being
+    // compiled, try to determine it from the resource file, if one was supplied.
+    if (inputResourcePath.isEmpty()) {
+        const QStringList resourcePaths = options.fileMapper->resourcePaths(
+                    QQmlJSResourceFileMapper::localFileFilter(inputFile));
+        if (generateCpp && resourcePaths.isEmpty()) {
+            fprintf(stderr, "No resource path for file: %s\n", qPrintable(inputFile));
+            return EXIT_FAILURE;
+        }
+
+        if (resourcePaths.size() == 1) {
+            inputResourcePath = resourcePaths.first();
+        } else if (generateCpp) {
+            fprintf(stderr, "Multiple resource paths for file %s. "
+                            "Use the --resource-path option to disambiguate:\n",
+                    qPrintable(inputFile));
+            for (const QString &resourcePath: resourcePaths)
+                fprintf(stderr, "\t%s\n", qPrintable(resourcePath));
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (generateCpp) {
+        inputFileUrl = "qrc://"_L1 + inputResourcePath;
+        saveFunction = [inputResourcePath, outputFileName](
+                               const QV4::CompiledData::SaveableUnitPointer &unit,
+                               const QQmlJSAotFunctionMap &aotFunctions,
+                               QString *errorString) {
+            return qSaveQmlJSUnitAsCpp(inputResourcePath, outputFileName, unit, aotFunctions, errorString);
+        };
+
+    } else {
+        saveFunction = [outputFileName](const QV4::CompiledData::SaveableUnitPointer &unit,
+                                        const QQmlJSAotFunctionMap &aotFunctions,
+                                        QString *errorString) {
+            Q_UNUSED(aotFunctions);
+            return unit.saveToDisk<char>(
+                    [&outputFileName, errorString](const char *data, quint32 size) {
+                        return QV4::CompiledData::SaveableUnitPointer::writeDataToFile(
+                                outputFileName, data, size, errorString);
+            });
+        };
+    }
+
+    if (inputFile.endsWith(".qml"_L1)) {
+        QQmlJSCompileError error;
+        if (!generateCpp || inputResourcePath.isEmpty() || options.onlyBytecode) {
+            if (!qCompileQmlFile(inputFile, saveFunction, nullptr, &error,
+                                 /* storeSourceLocation */ false)) {
+                error.augment("Error compiling qml file: "_L1).print();
+                return EXIT_FAILURE;
+            }
+        } else {
+            if (!importer) {
+                importer = std::make_unique<QQmlJSImporter>(
+                        options.importPaths,
+                        options.useResourceMapper ? options.fileMapper : nullptr);
+            }
+            QQmlJSLogger logger;
+
+            // Always trigger the qFatal() on "pragma Strict" violations.
+            logger.setCategoryLevel(qmlCompiler, QtWarningMsg);
+            logger.setCategoryIgnored(qmlCompiler, false);
+            logger.setCategoryFatal(qmlCompiler, true);
+
+            if (!options.verbose && !options.warningsAreErrors)
+                logger.setSilent(true);
+
+            QQmlJSAotCompiler cppCodeGen(
+                    importer.get(), u':' + inputResourcePath, options.qmldirFiles, &logger);
+
+            if (!options.moduleId.isEmpty()) {
+                QQmlJS::QQmlJSAotCompilerStats::setRecordAotStats(true);
+                QQmlJS::QQmlJSAotCompilerStats::setModuleId(options.moduleId);
+            }
+
+            if (options.validateBasicBlocks)
+                cppCodeGen.m_flags.setFlag(QQmlJSAotCompiler::ValidateBasicBlocks);
+
+            if (!qCompileQmlFile(inputFile, saveFunction, &cppCodeGen, &error,
+                                 /* storeSourceLocation */ true)) {
+                error.augment("Error compiling qml file: "_L1).print();
+                return EXIT_FAILURE;
+            }
+
+            QList<QQmlJS::DiagnosticMessage> warnings = importer->takeGlobalWarnings();
+
+            if (!warnings.isEmpty()) {
+                logger.log("Type warnings occurred while compiling file:"_L1,
+                           qmlImport, QQmlJS::SourceLocation());
+                logger.processMessages(warnings, qmlImport);
+                if (options.warningsAreErrors)
+                    return EXIT_FAILURE;
+            }
+
+            if (!options.moduleId.isEmpty())
+                QQmlJS::QQmlJSAotCompilerStats::instance()->saveToDisk(outputFileName + u".aotstats"_s);
+        }
+    } else if (inputFile.endsWith(".js"_L1) || inputFile.endsWith(".mjs"_L1)) {
+        QQmlJSCompileError error;
+        if (!qCompileJSFile(inputFile, inputFileUrl, saveFunction, &error)) {
+            error.augment("Error compiling js file: "_L1).print();
+            return EXIT_FAILURE;
+        }
+    } else {
+        fprintf(stderr, "Ignoring %s input file as it is not QML source code - maybe remove from QML_FILES?\n", qPrintable(inputFile));
+        if (options.warningsAreErrors)
+            return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+static bool readBatchFile(const QString &batchFile, QList<BatchJob> *jobs)
+{
+    QFile f(batchFile);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        fprintf(stderr, "Cannot open batch file %s\n", qPrintable(batchFile));
+        return false;
+    }
+
+    while (!f.atEnd()) {
+        const QString line = QString::fromLocal8Bit(f.readLine().trimmed());
+        if (line.isEmpty())
+            continue;
+        const QStringList fields = line.split(u';');
+        if (fields.size() < 2 || fields.size() > 3) {
+            fprintf(stderr, "Invalid line in batch file %s: %s\n"
+                            "Expected <input file>;<output file>[;<resource path>]\n",
+                    qPrintable(batchFile), qPrintable(line));
+            return false;
+        }
+        jobs->append({ fields[0], fields[1], fields.value(2) });
+    }
+    return true;
+}
+
+// Compiles all jobs on a thread pool. QQmlJSImporter is not thread safe, so each
+// worker has its own importer and reuses it for all the files it picks up.
+static int compileBatch(const QList<BatchJob> &jobs, const CompileOptions &options, int threads)
+{
+    std::atomic<qsizetype> nextJob = 0;
+    std::atomic<bool> failed = false;
+
+    const auto worker = [&]() {
+        std::unique_ptr<QQmlJSImporter> importer;
+        for (qsizetype i = nextJob++; i < jobs.size(); i = nextJob++) {
+            const BatchJob &job = jobs[i];
+            if (compileFile(job.inputFile, job.outputFileName, job.resourcePath, options,
+                            importer) != EXIT_SUCCESS) {
+                failed = true;
+            }
+        }
+    };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for (int i = 1; i < threads; ++i)
+        pool.start(worker);
+    worker();
+    pool.waitForDone();
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
 int main(int argc, char **argv)
 {
     // Produce reliably the same output for the same input by disabling QHash's random seeding.
@@ -106,6 +308,11 @@ int main(int argc, char **argv)
     QCommandLineOption moduleIdOption("module-id"_L1, QCoreApplication::translate("main", "Identifies the module of the qml file being compiled for aot stats"), QCoreApplication::translate("main", "id"));
     parser.addOption(moduleIdOption);
 
+    QCommandLineOption batchOption("batch"_L1, QCoreApplication::translate("main", "Compile all files listed in a batch file, one \"<input file>;<output file>[;<resource path>]\" per line, in a single process"), QCoreApplication::translate("main", "batch file"));
+    parser.addOption(batchOption);
+    QCommandLineOption jobsOption("jobs"_L1, QCoreApplication::translate("main", "Number of threads to use in batch mode. Defaults to the number of cores"), QCoreApplication::translate("main", "jobs"));
+    parser.addOption(jobsOption);
+
     QCommandLineOption outputFileOption("o"_L1, QCoreApplication::translate("main", "Output file name"), QCoreApplication::translate("main", "file name"));
     parser.addOption(outputFileOption);
 
@@ -161,8 +368,20 @@ int main(int argc, char **argv)
         return EXIT_FAILURE;
     }
 
+    const QString batchFile = parser.value(batchOption);
+    if (!batchFile.isEmpty()) {
+        if (parser.isSet(dumpAotStatsOption)) {
+            fprintf(stderr, "--dump-aot-stats cannot be combined with --batch\n");
+            return EXIT_FAILURE;
+        }
+        if (parser.isSet(outputFileOption) || !parser.positionalArguments().isEmpty()) {
+            fprintf(stderr, "--batch takes the input and output files from the batch file\n");
+            return EXIT_FAILURE;
+        }
+    }
+
     const QStringList sources = parser.positionalArguments();
-    if (sources.isEmpty()){
+    if (sources.isEmpty() && batchFile.isEmpty()) {
         parser.showHelp();
     } else if (sources.size() > 1 && (target != GenerateLoader && target != GenerateLoaderStandAlone)) {
         fprintf(stderr, "%s\n", qPrintable("Too many input files specified: '"_L1 + sources.join("' '"_L1) + u'\''));
@@ -198,133 +417,50 @@ int main(int argc, char **argv)
         }
         return EXIT_SUCCESS;
     }
-    QString inputFileUrl = inputFile;
-
-    QQmlJSSaveFunction saveFunction;
-    QQmlJSResourceFileMapper fileMapper(parser.values(resourceOption));
-    QString inputResourcePath = parser.value(resourcePathOption);
-
-    // If the user didn't specify the resource path corresponding to the file on disk being
-    // compiled, try to determine it from the resource file, if one was supplied.
-    if (inputResourcePath.isEmpty()) {
-        const QStringList resourcePaths = fileMapper.resourcePaths(
-                    QQmlJSResourceFileMapper::localFileFilter(inputFile));
-        if (target == GenerateCpp && resourcePaths.isEmpty()) {
-            fprintf(stderr, "No resource path for file: %s\n", qPrintable(inputFile));
-            return EXIT_FAILURE;
-        }
-
-        if (resourcePaths.size() == 1) {
-            inputResourcePath = resourcePaths.first();
-        } else if (target == GenerateCpp) {
-            fprintf(stderr, "Multiple resource paths for file %s. "
-                            "Use the --%s option to disambiguate:\n",
-                    qPrintable(inputFile),
-                    qPrintable(resourcePathOption.names().first()));
-            for (const QString &resourcePath: resourcePaths)
-                fprintf(stderr, "\t%s\n", qPrintable(resourcePath));
-            return EXIT_FAILURE;
-        }
-    }
-
-    if (target == GenerateCpp) {
-        inputFileUrl = "qrc://"_L1 + inputResourcePath;
-        saveFunction = [inputResourcePath, outputFileName](
-                               const QV4::CompiledData::SaveableUnitPointer &unit,
-                               const QQmlJSAotFunctionMap &aotFunctions,
-                               QString *errorString) {
-            return qSaveQmlJSUnitAsCpp(inputResourcePath, outputFileName, unit, aotFunctions, errorString);
-        };
-
-    } else {
-        saveFunction = [outputFileName](const QV4::CompiledData::SaveableUnitPointer &unit,
-                                        const QQmlJSAotFunctionMap &aotFunctions,
-                                        QString *errorString) {
-            Q_UNUSED(aotFunctions);
-            return unit.saveToDisk<char>(
-                    [&outputFileName, errorString](const char *data, quint32 size) {
-                        return QV4::CompiledData::SaveableUnitPointer::writeDataToFile(
-                                outputFileName, data, size, errorString);
-            });
-        };
-    }
-
-    if (inputFile.endsWith(".qml"_L1)) {
-        QQmlJSCompileError error;
-        if (target != GenerateCpp || inputResourcePath.isEmpty() || parser.isSet(onlyBytecode)) {
-            if (!qCompileQmlFile(inputFile, saveFunction, nullptr, &error,
-                                 /* storeSourceLocation */ false)) {
-                error.augment("Error compiling qml file: "_L1).print();
-                return EXIT_FAILURE;
-            }
-        } else {
-            QStringList importPaths;
 
-            if (parser.isSet(resourceOption)) {
-                importPaths.append("qt-project.org/imports"_L1);
-                importPaths.append("qt/qml"_L1);
-            };
+    CompileOptions options;
+    if (parser.isSet(resourceOption)) {
+        options.importPaths.append("qt-project.org/imports"_L1);
+        options.importPaths.append("qt/qml"_L1);
+    };
 
-            if (parser.isSet(importPathOption))
-                importPaths.append(parser.values(importPathOption));
+    if (parser.isSet(importPathOption))
+        options.importPaths.append(parser.values(importPathOption));
 
-            if (!parser.isSet(bareOption))
-                importPaths.append(QLibraryInfo::path(QLibraryInfo::QmlImportsPath));
-
-            QQmlJSImporter importer(
-                        importPaths, parser.isSet(resourceOption) ? &fileMapper : nullptr);
-            QQmlJSLogger logger;
-
-            // Always trigger the qFatal() on "pragma Strict" violations.
-            logger.setCategoryLevel(qmlCompiler, QtWarningMsg);
-            logger.setCategoryIgnored(qmlCompiler, false);
-            logger.setCategoryFatal(qmlCompiler, true);
-
-            if (!parser.isSet(verboseOption) && !parser.isSet(warningsAreErrorsOption))
-                logger.setSilent(true);
-
-            QQmlJSAotCompiler cppCodeGen(
-                    &importer, u':' + inputResourcePath,
-                    QQmlJSUtils::cleanPaths(parser.values(importsOption)), &logger);
-
-            if (parser.isSet(dumpAotStatsOption)) {
-                QQmlJS::QQmlJSAotCompilerStats::setRecordAotStats(true);
-                QQmlJS::QQmlJSAotCompilerStats::setModuleId(parser.value(moduleIdOption));
-            }
+    if (!parser.isSet(bareOption))
+        options.importPaths.append(QLibraryInfo::path(QLibraryInfo::QmlImportsPath));
 
-            if (parser.isSet(validateBasicBlocksOption))
-                cppCodeGen.m_flags.setFlag(QQmlJSAotCompiler::ValidateBasicBlocks);
+    QQmlJSResourceFileMapper fileMapper(parser.values(resourceOption));
+    options.fileMapper = &fileMapper;
+    options.useResourceMapper = parser.isSet(resourceOption);
+    options.qmldirFiles = QQmlJSUtils::cleanPaths(parser.values(importsOption));
+    if (parser.isSet(dumpAotStatsOption))
+        options.moduleId = parser.value(moduleIdOption);
+    options.onlyBytecode = parser.isSet(onlyBytecode);
+    options.verbose = parser.isSet(verboseOption);
+    options.warningsAreErrors = parser.isSet(warningsAreErrorsOption);
+    options.validateBasicBlocks = parser.isSet(validateBasicBlocksOption);
+
+    if (!batchFile.isEmpty()) {
+        QList<BatchJob> jobs;
+        if (!readBatchFile(batchFile, &jobs))
+            return EXIT_FAILURE;
 
-            if (!qCompileQmlFile(inputFile, saveFunction, &cppCodeGen, &error,
-                                 /* storeSourceLocation */ true)) {
-                error.augment("Error compiling qml file: "_L1).print();
+        int threads = QThread::idealThreadCount();
+        if (parser.isSet(jobsOption)) {
+            bool ok = false;
+            threads = parser.value(jobsOption).toInt(&ok);
+            if (!ok || threads < 1) {
+                fprintf(stderr, "Invalid number of jobs: %s\n",
+                        qPrintable(parser.value(jobsOption)));
                 return EXIT_FAILURE;
             }
-
-            QList<QQmlJS::DiagnosticMessage> warnings = importer.takeGlobalWarnings();
-
-            if (!warnings.isEmpty()) {
-                logger.log("Type warnings occurred while compiling file:"_L1,
-                           qmlImport, QQmlJS::SourceLocation());
-                logger.processMessages(warnings, qmlImport);
-                if (parser.isSet(warningsAreErrorsOption))
-                    return EXIT_FAILURE;
-            }
-
-            if (parser.isSet(dumpAotStatsOption))
-                QQmlJS::QQmlJSAotCompilerStats::instance()->saveToDisk(outputFileName + u".aotstats"_s);
         }
-    } else if (inputFile.endsWith(".js"_L1) || inputFile.endsWith(".mjs"_L1)) {
-        QQmlJSCompileError error;
-        if (!qCompileJSFile(inputFile, inputFileUrl, saveFunction, &error)) {
-            error.augment("Error compiling js file: "_L1).print();
-            return EXIT_FAILURE;
-        }
-    } else {
-        fprintf(stderr, "Ignoring %s input file as it is not QML source code - maybe remove from QML_FILES?\n", qPrintable(inputFile));
-        if (parser.isSet(warningsAreErrorsOption))
-            return EXIT_FAILURE;
+        threads = int(std::min<qsizetype>(threads, jobs.size()));
+        return compileBatch(jobs, options, std::max(1, threads));
     }
 
-    return EXIT_SUCCESS;
+    std::unique_ptr<QQmlJSImporter> importer;
+    return compileFile(inputFile, outputFileName, parser.value(resourcePathOption), options,
+                       importer);
 }
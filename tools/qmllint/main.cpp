@@ -10,6 +10,14 @@
 #include <QtQmlCompiler/private/qqmljsresourcefilemapper_p.h>
 #include <QtQmlCompiler/private/qqmljsutils_p.h>
 
+#include <QtQml/private/qqmldirparser_p.h>
+#include <QtQml/private/qqmljsast_p.h>
+#include <QtQml/private/qqmljsengine_p.h>
+#include <QtQml/private/qqmljslexer_p.h>
+#include <QtQml/private/qqmljsparser_p.h>
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
@@ -18,7 +26,9 @@
 #include <QtCore/qjsonobject.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsondocument.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qscopeguard.h>
+#include <QtCore/qthreadpool.h>
 
 #if QT_CONFIG(commandlineparser)
 #include <QtCore/qcommandlineparser.h>
@@ -26,6 +36,8 @@
 
 #include <QtCore/qlibraryinfo.h>
 
+#include <atomic>
+#include <optional>
 #include <cstdio>
 
 using namespace Qt::StringLiterals;
@@ -61,6 +73,357 @@ bool argumentsFromCommandLineAndFile(QStringList& allArguments, const QStringLis
     return true;
 }
 
+struct LintOptions
+{
+    QStringList pluginPaths;
+    QString cacheDirectory;
+    int maxWarnings = -1;
+    bool useAbsolutePath = false;
+    bool silent = false;
+    bool useJson = false;
+    bool lintModules = false;
+    bool isFixing = false;
+};
+
+struct LintJob
+{
+    QString filename;
+    QStringList qmlImportPaths;
+    QStringList qmldirFiles;
+    QStringList resourceFiles;
+    QList<QQmlJS::LoggerCategory> categories;
+    QSet<QString> disabledPlugins;
+    QByteArray cacheKey;
+};
+
+// Directories given on the command line are linted as a whole project: all QML
+// and JavaScript files below them, in a stable order.
+static QStringList expandDirectory(const QString &path)
+{
+    if (!QFileInfo(path).isDir())
+        return { path };
+
+    QStringList files;
+    QDirIterator it(path, { u"*.qml"_s, u"*.js"_s, u"*.mjs"_s }, QDir::Files,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext())
+        files.append(it.next());
+    files.sort();
+    return files;
+}
+
+static void addFileHash(QCryptographicHash &hash, const QString &path)
+{
+    hash.addData(path.toUtf8());
+    QFile file(path);
+    if (file.open(QIODevice::ReadOnly))
+        hash.addData(&file);
+}
+
+// A file's lint result depends on the other files in its directory, which form
+// its implicit import. Hash them all, once per directory.
+static QByteArray directoryHash(const QString &directory, QHash<QString, QByteArray> *hashes)
+{
+    auto it = hashes->constFind(directory);
+    if (it != hashes->constEnd())
+        return *it;
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    QStringList entries = QDir(directory).entryList(
+            { u"*.qml"_s, u"*.js"_s, u"*.mjs"_s, u"*.qmltypes"_s, u"qmldir"_s }, QDir::Files);
+    entries.sort();
+    for (const QString &entry : std::as_const(entries))
+        addFileHash(hash, directory + u'/' + entry);
+
+    return *hashes->insert(directory, hash.result());
+}
+
+struct LintCacheHashes
+{
+    QHash<QString, QByteArray> directories;
+    QHash<QString, QByteArray> modules;
+    QByteArray plugins;
+};
+
+// Linter plugins can be added or updated without touching any of the linted
+// files. Their names, sizes and modification times are enough to notice that.
+static QByteArray pluginsHash(const QStringList &pluginPaths)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString &path : pluginPaths) {
+        QFileInfoList entries = QDir(path).entryInfoList(QDir::Files, QDir::Name);
+        for (const QFileInfo &entry : std::as_const(entries)) {
+            hash.addData(entry.absoluteFilePath().toUtf8());
+            hash.addData(QByteArray::number(entry.size()));
+            hash.addData(QByteArray::number(entry.lastModified().toMSecsSinceEpoch()));
+        }
+    }
+    return hash.result();
+}
+
+// Hashes the qmldir, type information, components and scripts of a module and,
+// recursively, of the modules it imports or depends on. The module is looked up
+// in the import paths the same way the importer does. Returns an empty hash if
+// it cannot be found.
+static QByteArray moduleHash(const QString &uri, const QStringList &importPaths,
+                             QHash<QString, QByteArray> *hashes)
+{
+    const QString key = importPaths.join(u'\n') + u'\n' + uri;
+    auto it = hashes->constFind(key);
+    if (it != hashes->constEnd())
+        return *it;
+
+    // Modules may import each other. Break cycles with the name of the module.
+    hashes->insert(key, uri.toUtf8());
+
+    QString directory;
+    const QString relative = QString(uri).replace(u'.', u'/');
+    for (const QString &importPath : importPaths) {
+        if (QFileInfo::exists(importPath + u'/' + relative + u"/qmldir"_s)) {
+            directory = importPath + u'/' + relative;
+            break;
+        }
+    }
+
+    QFile qmldir(directory + u"/qmldir"_s);
+    if (directory.isEmpty() || !qmldir.open(QIODevice::ReadOnly))
+        return *hashes->insert(key, QByteArray());
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const QByteArray content = qmldir.readAll();
+    hash.addData(directory.toUtf8());
+    hash.addData(content);
+
+    QQmlDirParser parser;
+    parser.parse(QString::fromUtf8(content));
+    for (const QString &typeInfo : parser.typeInfos())
+        addFileHash(hash, directory + u'/' + typeInfo);
+    for (const auto &component : parser.components())
+        addFileHash(hash, directory + u'/' + component.fileName);
+    for (const auto &script : parser.scripts())
+        addFileHash(hash, directory + u'/' + script.fileName);
+
+    const QList<QQmlDirParser::Import> imports = parser.imports() + parser.dependencies();
+    for (const QQmlDirParser::Import &import : imports) {
+        const QByteArray imported = moduleHash(import.module, importPaths, hashes);
+        if (imported.isEmpty())
+            return *hashes->insert(key, QByteArray());
+        hash.addData(imported);
+    }
+
+    return *hashes->insert(key, hash.result());
+}
+
+// A file's lint result depends on everything its imports resolve to. Returns an
+// empty hash if that cannot be determined, in which case the file is not cached.
+static QByteArray importsHash(const LintJob &job, LintCacheHashes *hashes)
+{
+    QFile file(job.filename);
+    if (!file.open(QIODevice::ReadOnly))
+        return QByteArray();
+    const QString code = QString::fromUtf8(file.readAll());
+
+    // Don't bother resolving the imports of scripts.
+    if (!job.filename.endsWith(u".qml"_s))
+        return code.contains(u"import"_s) ? QByteArray() : QByteArray("none");
+
+    QQmlJS::Engine engine;
+    QQmlJS::Lexer lexer(&engine);
+    lexer.setCode(code, /*lineno = */ 1, /*qmlMode = */ true);
+    QQmlJS::Parser parser(&engine);
+    if (!parser.parse() || !parser.ast())
+        return QByteArray();
+
+    const QDir directory = QFileInfo(job.filename).absoluteDir();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (auto *item = parser.ast()->headers; item; item = item->next) {
+        const auto *import = QQmlJS::AST::cast<QQmlJS::AST::UiImport *>(item->headerItem);
+        if (!import)
+            continue;
+
+        if (!import->fileName.isEmpty()) {
+            const QString path = directory.absoluteFilePath(import->fileName.toString());
+            if (QFileInfo(path).isDir())
+                hash.addData(directoryHash(QDir::cleanPath(path), &hashes->directories));
+            else
+                addFileHash(hash, path);
+            continue;
+        }
+
+        const QByteArray imported = moduleHash(import->importUri->toString(), job.qmlImportPaths,
+                                               &hashes->modules);
+        if (imported.isEmpty())
+            return QByteArray();
+        hash.addData(imported);
+    }
+    return hash.result();
+}
+
+static QByteArray lintCacheKey(const LintJob &job, LintCacheHashes *hashes)
+{
+    const QFileInfo info(job.filename);
+    const QByteArray imports = importsHash(job, hashes);
+    if (imports.isEmpty())
+        return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QT_VERSION_STR);
+    hash.addData(info.absoluteFilePath().toUtf8());
+    hash.addData(directoryHash(info.absolutePath(), &hashes->directories));
+    hash.addData(imports);
+    hash.addData(hashes->plugins);
+    hash.addData(job.qmlImportPaths.join(u'\n').toUtf8());
+    for (const QString &file : job.qmldirFiles)
+        addFileHash(hash, file);
+    for (const QString &file : job.resourceFiles)
+        addFileHash(hash, file);
+    for (const QQmlJS::LoggerCategory &category : job.categories) {
+        hash.addData(category.name().toUtf8());
+        hash.addData(QByteArray::number(category.level()));
+        hash.addData(QByteArray::number(category.isIgnored()));
+    }
+    QStringList disabledPlugins = job.disabledPlugins.values();
+    disabledPlugins.sort();
+    hash.addData(disabledPlugins.join(u'\n').toUtf8());
+
+    return hash.result().toHex();
+}
+
+static QString lintCacheEntry(const LintOptions &options, const LintJob &job)
+{
+    if (options.cacheDirectory.isEmpty() || job.cacheKey.isEmpty())
+        return QString();
+    return options.cacheDirectory + u'/' + QString::fromLatin1(job.cacheKey) + u".clean"_s;
+}
+
+// Every change to a file or its imports leaves an entry behind. Entries are
+// touched whenever they are used, and the ones not used for a week removed.
+static void pruneLintCache(const QString &cacheDirectory)
+{
+    const QDateTime expired = QDateTime::currentDateTimeUtc().addDays(-7);
+    const QFileInfoList entries =
+            QDir(cacheDirectory).entryInfoList({ u"*.clean"_s }, QDir::Files);
+    for (const QFileInfo &entry : entries) {
+        if (entry.lastModified() < expired)
+            QFile::remove(entry.absoluteFilePath());
+    }
+}
+
+// Lints one file or module. Files that were found clean before, with the same
+// contents, neighbours and settings, are skipped. Returns false if the job
+// should make qmllint fail.
+static bool lintJob(QQmlJSLinter &linter, const LintJob &job, const LintOptions &options,
+                    QJsonArray *json, QQmlJSLinter::LintResult *lintResult)
+{
+    const QString cacheEntry = lintCacheEntry(options, job);
+    if (!cacheEntry.isEmpty() && QFile::exists(cacheEntry)) {
+        QFile entry(cacheEntry);
+        if (entry.open(QIODevice::ReadWrite))
+            entry.setFileTime(QDateTime::currentDateTimeUtc(), QFileDevice::FileModificationTime);
+
+        if (json) {
+            QJsonObject result;
+            result[u"filename"_s] = QFileInfo(job.filename).absoluteFilePath();
+            result[u"warnings"_s] = QJsonArray();
+            result[u"success"_s] = true;
+            result[u"cached"_s] = true;
+            json->append(result);
+        }
+        *lintResult = QQmlJSLinter::LintSuccess;
+        return true;
+    }
+
+    linter.setPluginsEnabled(true);
+    for (auto &plugin : linter.plugins())
+        plugin.setEnabled(!job.disabledPlugins.contains(plugin.name().toLower()));
+
+    if (options.lintModules) {
+        *lintResult = linter.lintModule(job.filename, options.silent, json, job.qmlImportPaths,
+                                        job.resourceFiles);
+    } else {
+        *lintResult = linter.lintFile(job.filename, nullptr, options.silent || options.isFixing,
+                                      json, job.qmlImportPaths, job.qmldirFiles,
+                                      job.resourceFiles, job.categories);
+    }
+
+    if (*lintResult != QQmlJSLinter::LintSuccess && *lintResult != QQmlJSLinter::HasWarnings)
+        return false;
+
+    const QQmlJSLogger *logger = linter.logger();
+    if (options.maxWarnings != -1 && options.maxWarnings < logger->warnings().size())
+        return false;
+
+    // Only remember files that produce no output at all. Skipping them is then
+    // indistinguishable from linting them again.
+    if (!cacheEntry.isEmpty() && *lintResult == QQmlJSLinter::LintSuccess
+        && logger->infos().isEmpty() && logger->warnings().isEmpty()
+        && logger->errors().isEmpty() && QDir().mkpath(options.cacheDirectory)) {
+        QFile file(cacheEntry);
+        if (file.open(QIODevice::WriteOnly))
+            file.close();
+    }
+
+    return true;
+}
+
+// Lints all jobs on a thread pool. QQmlJSImporter is not thread safe, so each
+// worker has its own linter and reuses its imports for all the files it picks
+// up. The plugin instances are shared, though, so their passes run on one
+// worker at a time. The output of each file is printed in one piece.
+static bool lintInParallel(const QList<LintJob> &jobs, const LintOptions &options, int threads,
+                           QJsonArray *jsonFiles)
+{
+    std::atomic<qsizetype> nextJob = 0;
+    std::atomic<bool> failed = false;
+    QList<QJsonArray> results(jobs.size());
+    QMutex outputMutex;
+    QMutex pluginMutex;
+
+    const auto worker = [&]() {
+        // Created for the first job the worker picks up, with that job's import paths.
+        std::optional<QQmlJSLinter> linter;
+        QString output;
+
+        for (qsizetype i = nextJob++; i < jobs.size(); i = nextJob++) {
+            if (!linter) {
+                linter.emplace(jobs[i].qmlImportPaths, options.pluginPaths,
+                               options.useAbsolutePath);
+                if (!options.cacheDirectory.isEmpty())
+                    linter->setImportCacheDirectory(options.cacheDirectory + u"/qmltypes"_s);
+                linter->setOutputBuffer(&output);
+                linter->setPluginMutex(&pluginMutex);
+            }
+
+            QQmlJSLinter::LintResult lintResult;
+            if (!lintJob(*linter, jobs[i], options, options.useJson ? &results[i] : nullptr,
+                         &lintResult)) {
+                failed = true;
+            }
+
+            if (!output.isEmpty()) {
+                const QByteArray encoded = output.toLocal8Bit();
+                QMutexLocker lock(&outputMutex);
+                fwrite(encoded.constData(), size_t(1), size_t(encoded.size()), stderr);
+                output.clear();
+            }
+        }
+    };
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(threads);
+    for (int i = 1; i < threads; ++i)
+        pool.start(worker);
+    worker();
+    pool.waitForDone();
+
+    for (const QJsonArray &result : std::as_const(results)) {
+        for (const QJsonValue &file : result)
+            jsonFiles->append(file);
+    }
+
+    return !failed;
+}
+
 int main(int argv, char *argc[])
 {
     QHashSeed::setDeterministicGlobalSeed();
@@ -199,6 +562,25 @@ All warnings can be set to three levels:
     parser.addOption(maxWarnings);
     settings.addOption("MaxWarnings", -1);
 
+    QCommandLineOption jobsOption(
+            QStringList() << "jobs",
+            QLatin1String("Lint the given files on \"count\" threads. Each thread reuses the "
+                          "imports it has already resolved for the next files. By default, files "
+                          "are linted one after another. Linter plugins run on one thread at a "
+                          "time. Fixing and linting modules always happen on a single thread."),
+            QLatin1String("count"));
+    parser.addOption(jobsOption);
+
+    QCommandLineOption cacheDirOption(
+            QStringList() << "cache-dir",
+            QLatin1String("Remember files that produce no messages in \"directory\" and skip "
+                          "them as long as neither they, the other files in their directory, the "
+                          "modules and scripts they import, the linter plugins, nor the settings "
+                          "change. Files whose imports cannot be resolved are always linted. "
+                          "Entries not used for a week are removed."),
+            QLatin1String("directory"));
+    parser.addOption(cacheDirOption);
+
     auto addCategory = [&](const QQmlJS::LoggerCategory &category) {
         categories.push_back(category);
         if (category.isDefault())
@@ -221,7 +603,8 @@ All warnings can be set to three levels:
     }
 
     parser.addPositionalArgument(QLatin1String("files"),
-                                 QLatin1String("list of qml or js files to verify"));
+                                 QLatin1String("list of qml or js files, or directories "
+                                               "containing them, to verify"));
 
     QStringList arguments;
     if (!argumentsFromCommandLineAndFile(arguments, app.arguments())) {
@@ -330,9 +713,46 @@ All warnings can be set to three levels:
         parser.showHelp(-1);
     }
 
+    LintOptions options;
+    options.pluginPaths = pluginPaths;
+    options.cacheDirectory = parser.value(cacheDirOption);
+    options.useAbsolutePath = useAbsolutePath;
+    options.silent = silent;
+    options.useJson = useJson;
+    options.lintModules = parser.isSet(moduleOption);
+    options.isFixing = parser.isSet(fixFile);
+    if (parser.isSet(maxWarnings))
+        options.maxWarnings = parser.value(maxWarnings).toInt();
+
+    int threads = 1;
+    if (parser.isSet(jobsOption)) {
+        bool ok = false;
+        threads = parser.value(jobsOption).toInt(&ok);
+        if (!ok || threads < 1) {
+            qWarning().nospace() << "Invalid number of jobs: " << parser.value(jobsOption);
+            return 1;
+        }
+    }
+
+    // Fixed files are rewritten right away. Don't risk skipping any of them.
+    const bool useLintCache =
+            !options.cacheDirectory.isEmpty() && !options.lintModules && !options.isFixing;
+    if (!options.cacheDirectory.isEmpty())
+        linter.setImportCacheDirectory(options.cacheDirectory + u"/qmltypes"_s);
+    if (useLintCache)
+        pruneLintCache(options.cacheDirectory);
+
+    QStringList filenames;
+    for (const QString &argument : positionalArguments)
+        filenames << (options.lintModules ? QStringList { argument } : expandDirectory(argument));
+
+    QList<LintJob> jobs;
+    LintCacheHashes cacheHashes;
+    if (useLintCache)
+        cacheHashes.plugins = pluginsHash(pluginPaths);
     QJsonArray jsonFiles;
 
-    for (const QString &filename : positionalArguments) {
+    for (const QString &filename : std::as_const(filenames)) {
         if (!parser.isSet(ignoreSettings))
             settings.search(filename);
         updateLogLevels();
@@ -407,97 +827,90 @@ All warnings can be set to three levels:
                 disabledPlugins << plugin.toLower();
         }
 
-        linter.setPluginsEnabled(!disabledPlugins.contains("all"));
-
-        if (!linter.pluginsEnabled())
+        if (disabledPlugins.contains("all"))
             continue;
 
-        auto &plugins = linter.plugins();
-
-        for (auto &plugin : plugins)
-            plugin.setEnabled(!disabledPlugins.contains(plugin.name().toLower()));
-
-        const bool isFixing = parser.isSet(fixFile);
-
-        QQmlJSLinter::LintResult lintResult;
-
-        if (parser.isSet(moduleOption)) {
-            lintResult = linter.lintModule(filename, silent, useJson ? &jsonFiles : nullptr,
-                                           qmlImportPaths, resourceFiles);
-        } else {
-            lintResult = linter.lintFile(filename, nullptr, silent || isFixing,
-                                         useJson ? &jsonFiles : nullptr, qmlImportPaths,
-                                         qmldirFiles, resourceFiles, categories);
-        }
-        success &= (lintResult == QQmlJSLinter::LintSuccess || lintResult == QQmlJSLinter::HasWarnings);
-        if (success && parser.isSet(maxWarnings))
-        {
-            int value = parser.value(maxWarnings).toInt();
-            if (value != -1 && value < linter.logger()->warnings().size())
-                success = false;
-        }
-
-        if (isFixing) {
-            if (lintResult != QQmlJSLinter::LintSuccess && lintResult != QQmlJSLinter::HasWarnings)
-                continue;
+        LintJob job { filename,   qmlImportPaths,  qmldirFiles, resourceFiles,
+                      categories, disabledPlugins, QByteArray() };
+        if (useLintCache)
+            job.cacheKey = lintCacheKey(job, &cacheHashes);
+        jobs.append(std::move(job));
+    }
 
-            QString fixedCode;
-            const QQmlJSLinter::FixResult result = linter.applyFixes(&fixedCode, silent);
+    threads = int(std::min<qsizetype>(threads, jobs.size()));
+    if (threads > 1 && !options.lintModules && !options.isFixing) {
+        success = lintInParallel(jobs, options, threads, &jsonFiles);
+    } else {
+        for (const LintJob &job : std::as_const(jobs)) {
+            const QString &filename = job.filename;
 
-            if (result != QQmlJSLinter::NothingToFix && result != QQmlJSLinter::FixSuccess) {
-                success = false;
-                continue;
-            }
+            QQmlJSLinter::LintResult lintResult;
+            success &= lintJob(linter, job, options, useJson ? &jsonFiles : nullptr, &lintResult);
 
-            if (parser.isSet(dryRun)) {
-                QTextStream(stdout) << fixedCode;
-            } else {
-                if (result == QQmlJSLinter::NothingToFix) {
-                    if (!silent)
-                        qWarning().nospace() << "Nothing to fix in " << filename;
+            if (options.isFixing) {
+                if (lintResult != QQmlJSLinter::LintSuccess
+                    && lintResult != QQmlJSLinter::HasWarnings) {
                     continue;
                 }
 
-                const QString backupFile = filename + u".bak"_s;
-                if (QFile::exists(backupFile) && !QFile::remove(backupFile)) {
-                    if (!silent) {
-                        qWarning().nospace() << "Failed to remove old backup file " << backupFile
-                                             << ", aborting";
-                    }
+                QString fixedCode;
+                const QQmlJSLinter::FixResult result = linter.applyFixes(&fixedCode, silent);
+
+                if (result != QQmlJSLinter::NothingToFix && result != QQmlJSLinter::FixSuccess) {
                     success = false;
                     continue;
                 }
-                if (!QFile::copy(filename, backupFile)) {
-                    if (!silent) {
-                        qWarning().nospace()
-                                << "Failed to create backup file " << backupFile << ", aborting";
+
+                if (parser.isSet(dryRun)) {
+                    QTextStream(stdout) << fixedCode;
+                } else {
+                    if (result == QQmlJSLinter::NothingToFix) {
+                        if (!silent)
+                            qWarning().nospace() << "Nothing to fix in " << filename;
+                        continue;
                     }
-                    success = false;
-                    continue;
-                }
 
-                QFile file(filename);
-                if (!file.open(QIODevice::WriteOnly)) {
-                    if (!silent) {
-                        qWarning().nospace() << "Failed to open " << filename
-                                             << " for writing:" << file.errorString();
+                    const QString backupFile = filename + u".bak"_s;
+                    if (QFile::exists(backupFile) && !QFile::remove(backupFile)) {
+                        if (!silent) {
+                            qWarning().nospace() << "Failed to remove old backup file "
+                                                 << backupFile << ", aborting";
+                        }
+                        success = false;
+                        continue;
+                    }
+                    if (!QFile::copy(filename, backupFile)) {
+                        if (!silent) {
+                            qWarning().nospace() << "Failed to create backup file " << backupFile
+                                                 << ", aborting";
+                        }
+                        success = false;
+                        continue;
+                    }
+
+                    QFile file(filename);
+                    if (!file.open(QIODevice::WriteOnly)) {
+                        if (!silent) {
+                            qWarning().nospace() << "Failed to open " << filename
+                                                 << " for writing:" << file.errorString();
+                        }
+                        success = false;
+                        continue;
                     }
-                    success = false;
-                    continue;
-                }
 
-                const QByteArray data = fixedCode.toUtf8();
-                if (file.write(data) != data.size()) {
+                    const QByteArray data = fixedCode.toUtf8();
+                    if (file.write(data) != data.size()) {
+                        if (!silent) {
+                            qWarning().nospace() << "Failed to write new contents to " << filename
+                                                 << ": " << file.errorString();
+                        }
+                        success = false;
+                        continue;
+                    }
                     if (!silent) {
-                        qWarning().nospace() << "Failed to write new contents to " << filename
-                                             << ": " << file.errorString();
+                        qDebug().nospace() << "Applied fixes to " << filename
+                                           << ". Backup created at " << backupFile;
                     }
-                    success = false;
-                    continue;
-                }
-                if (!silent) {
-                    qDebug().nospace() << "Applied fixes to " << filename << ". Backup created at "
-                                       << backupFile;
                 }
             }
         }
@@ -289,6 +289,11 @@ int main(int argv, char *argc[])
         qmlServer.codeModel()->disableCMakeCalls();
     }
 
+    // Allows tests to keep the index of the workspace away from the cache of the user. An empty
+    // value disables the persistence of the index.
+    if (qEnvironmentVariableIsSet("QMLLS_INDEX_CACHE"))
+        qmlServer.codeModel()->setIndexCacheFile(qEnvironmentVariable("QMLLS_INDEX_CACHE"));
+
     if (parser.isSet(buildDirOption)) {
         const QStringList dirs =
                 QQmlToolingUtils::getAndWarnForInvalidDirsFromOption(parser, buildDirOption);
@@ -423,6 +423,14 @@ void DataIterator::handleRangeEvent(
         Q_ASSERT(starts[i].timestamp() <= event.timestamp());
 
         ends[i] = event.timestamp();
+
+        // Bindings report their statistics at the end of the range. Attach them to the start,
+        // as that is what we write to the trace file.
+        if (type.rangeType() == Binding) {
+            starts[i].setNumber<qint8>(1, event.number<qint8>(1));
+            starts[i].setNumber<qint8>(2, event.number<qint8>(2));
+        }
+
         if (--level == 0)
             endLevel0();
         break;
@@ -602,6 +610,9 @@ bool QmlProfilerData::save(const QString &filename)
             stream.writeAttribute("timing5", event, 4, false);
         } else if (type.message() == MemoryAllocation) {
             stream.writeAttribute("amount", event, 0);
+        } else if (type.rangeType() == Binding) {
+            stream.writeAttribute("dependencies", event, 1, false);
+            stream.writeAttribute("redundant", event, 2, false);
         }
         stream.writeEndElement();
     };
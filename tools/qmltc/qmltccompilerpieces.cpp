@@ -206,8 +206,21 @@ void QmltcCodeGenerator::generate_callExecuteRuntimeFunction(
     *block << u"QMetaType _t[] = { " + types.join(u", "_s) + u" };";
     const qsizetype runtimeIndex = static_cast<qsizetype>(index);
     Q_ASSERT(runtimeIndex >= 0);
-    *block << u"e->executeRuntimeFunction(" + url + u", " + QString::number(runtimeIndex) + u", "
-                    + accessor + u", " + QString::number(parameters.size()) + u", _a, _t);";
+    const QString callArguments = QString::number(runtimeIndex) + u", " + accessor + u", "
+            + QString::number(parameters.size()) + u", _a, _t);";
+    if (accessor == u"this"_s) {
+        // Every generated type remembers its document context, which already holds the
+        // compilation unit. Use it and save the URL lookup on every call. Only fall back
+        // to the URL if the function is called before the object is initialized.
+        // The local is prefixed like _a and _t, so that it can't shadow a parameter.
+        *block << u"const QV4::ExecutableCompilationUnit *_unit = q_qmltc_thisContext"_s;
+        *block << u"        ? q_qmltc_thisContext->typeCompilationUnit().data()"_s;
+        *block << u"        : e->compilationUnitFromUrl(" + url + u");";
+        *block << u"if (_unit)"_s;
+        *block << u"    e->executeRuntimeFunction(_unit, " + callArguments;
+    } else {
+        *block << u"e->executeRuntimeFunction(" + url + u", " + callArguments;
+    }
     if (returnType != u"void"_s)
         *block << u"return " + returnValueName + u";";
 }